@@ -24,6 +24,11 @@ android {
 
     buildTypes {
         release {
+            externalNativeBuild {
+                cmake {
+                    arguments("-DAPP_PROTECTION_LOG_LEVEL=WARN")
+                }
+            }
             isMinifyEnabled = false
             proguardFiles(
                 getDefaultProguardFile("proguard-android-optimize.txt"),
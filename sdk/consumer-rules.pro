@@ -0,0 +1,23 @@
+# Rules applied to apps that consume AppProtectionSDK.
+#
+# JNI_OnLoad resolves these classes and methods by name and fails the
+# library load if any of them is missing, which turns all native
+# protection off. Nothing on the Kotlin side calls the methods, so they
+# have to be kept explicitly.
+
+-keep class com.appprotection.sdk.internal.TamperingBatchBridge {
+    void onNativeTamperingBatch(java.lang.String[], java.lang.String[], int[]);
+}
+
+-keep interface com.appprotection.sdk.internal.RegionProtectionCallback {
+    void onRegionProtected(java.lang.String, boolean);
+}
+
+-keep class * implements com.appprotection.sdk.internal.RegionProtectionCallback {
+    void onRegionProtected(java.lang.String, boolean);
+}
+
+# Native methods are bound by their Java_<class>_<method> symbol names.
+-keepclasseswithmembernames,includedescriptorclasses class * {
+    native <methods>;
+}
@@ -20,6 +20,11 @@ int SHA256_Init(SHA256_CTX *c);
 int SHA256_Update(SHA256_CTX *c, const void *data, size_t len);
 int SHA256_Final(unsigned char *md, SHA256_CTX *c);
 
+/* Not part of OpenSSL: equivalent to calling SHA256_Update(c[i], data[i],
+ * len[i]) for each i < n, but interleaves the independent messages in SIMD
+ * lanes when no hardware SHA-256 backend is available. */
+int SHA256_MultiUpdate(SHA256_CTX *const *c, const void *const *data, const size_t *len, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
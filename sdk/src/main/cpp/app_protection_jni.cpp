@@ -15,293 +15,581 @@
  */
 
 #include "app_protection_jni.h"
-#include <android/log.h>
+#include "log.h"
+#include "environment_check.h"
+#include "trace_ring.h"
+#include <pthread.h>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <thread>
 
 #define TAG "AppProtectionJNI"
 
-struct TamperingCallbackInfo {
-    jobject callbackObj;
-    jmethodID methodId;
+// Tampering callbacks fire on scan threads while Kotlin may be replacing
+// them, so the map is only touched under g_callbackMutex.
+std::map<jlong, jobject> g_callbackMap;
+std::mutex g_callbackMutex;
+
+JavaVM* g_jvm = nullptr;
+
+// Classes and methods used on every tick, resolved once in JNI_OnLoad.
+// FindClass on a native thread only sees system classes, so the SDK's own
+// classes have to be looked up here, where the app class loader is in scope.
+struct JniCache {
+    jclass string_class;
+    // Held so the method ids below stay valid.
+    jclass bridge_class;
+    jclass protect_class;
+    jmethodID on_tampering_batch;
+    jmethodID on_region_protected;
 };
 
-std::map<jlong, TamperingCallbackInfo> g_callbackMap;
+static JniCache g_jni;
 
-JavaVM* g_jvm = nullptr;
+// Native threads attached by jniAttachCurrentThread() stay attached until
+// they exit; the key's destructor detaches them then.
+static pthread_key_t g_envKey;
+
+static void jniDetachOnExit(void* env) {
+    g_jvm->DetachCurrentThread();
+}
+
+static jclass findGlobalClass(JNIEnv* env, const char* name) {
+    jclass local = env->FindClass(name);
+    if (local == NULL) {
+        env->ExceptionClear();
+        LOGE("Failed to find class %s", name);
+        return NULL;
+    }
+    jclass global = static_cast<jclass>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    return global;
+}
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
     g_jvm = vm;
+    JNIEnv* env;
+    if (vm->GetEnv((void**)&env, JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    g_jni.string_class = findGlobalClass(env, "java/lang/String");
+    g_jni.bridge_class = findGlobalClass(env, "com/appprotection/sdk/internal/TamperingBatchBridge");
+    g_jni.protect_class = findGlobalClass(env, "com/appprotection/sdk/internal/RegionProtectionCallback");
+    if (!g_jni.string_class || !g_jni.bridge_class || !g_jni.protect_class) {
+        return JNI_ERR;
+    }
+    g_jni.on_tampering_batch = env->GetMethodID(g_jni.bridge_class, "onNativeTamperingBatch",
+                                                "([Ljava/lang/String;[Ljava/lang/String;[I)V");
+    g_jni.on_region_protected = env->GetMethodID(g_jni.protect_class, "onRegionProtected",
+                                                 "(Ljava/lang/String;Z)V");
+    if (!g_jni.on_tampering_batch || !g_jni.on_region_protected) {
+        LOGE("Failed to resolve callback methods");
+        return JNI_ERR;
+    }
+
+    if (pthread_key_create(&g_envKey, jniDetachOnExit) != 0) {
+        LOGE("Failed to create JNI thread key");
+        return JNI_ERR;
+    }
     return JNI_VERSION_1_6;
 }
 
-void jniTamperingCallback(const std::string& region, const std::string& details, jlong handle) {
+// Returns the calling thread's JNIEnv, attaching it on first use. Threads
+// the JVM created are left as they are.
+static JNIEnv* jniAttachCurrentThread(const char* name) {
     JNIEnv* env;
     jint result = g_jvm->GetEnv((void**)&env, JNI_VERSION_1_6);
-    if (result == JNI_EDETACHED) {
-        if (g_jvm->AttachCurrentThread(&env, NULL) != 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to attach thread for tampering callback");
-            return;
-        }
-    } else if (result != JNI_OK) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get JNI environment for tampering callback");
+    if (result == JNI_OK) {
+        return env;
+    }
+    if (result != JNI_EDETACHED) {
+        LOGE("Failed to get JNI environment");
+        return NULL;
+    }
+
+    JavaVMAttachArgs args = {JNI_VERSION_1_6, name, NULL};
+    if (g_jvm->AttachCurrentThread(&env, &args) != 0) {
+        LOGE("Failed to attach thread %s", name);
+        return NULL;
+    }
+    pthread_setspecific(g_envKey, env);
+    return env;
+}
+
+// Runs on the monitor's tamper event dispatcher, which is attached once
+// when it starts.
+void jniTamperingBatch(const std::vector<TamperEvent>& events, jlong handle) {
+    JNIEnv* env = jniAttachCurrentThread("TamperDispatch");
+    if (!env) {
         return;
     }
 
-    auto it = g_callbackMap.find(handle);
-    if (it == g_callbackMap.end() || it->second.callbackObj == NULL) {
-        __android_log_print(ANDROID_LOG_WARN, TAG, "No tampering callback registered for handle: %lld", handle);
-        if (result == JNI_EDETACHED) {
-            g_jvm->DetachCurrentThread();
+    // A local reference keeps the callback alive if it is replaced, and its
+    // global reference deleted, while the call below is still running.
+    jobject callbackObj = NULL;
+    {
+        std::lock_guard<std::mutex> lock(g_callbackMutex);
+        auto it = g_callbackMap.find(handle);
+        if (it != g_callbackMap.end()) {
+            callbackObj = env->NewLocalRef(it->second);
         }
+    }
+    if (callbackObj == NULL) {
+        LOGW("No tampering callback registered for handle: %lld", handle);
         return;
     }
 
-    TamperingCallbackInfo& callbackInfo = it->second;
-
-    jstring jRegion = env->NewStringUTF(region.c_str());
-    jstring jDetails = env->NewStringUTF(details.c_str());
+    jsize count = static_cast<jsize>(events.size());
+    jobjectArray jRegions = env->NewObjectArray(count, g_jni.string_class, NULL);
+    jobjectArray jDetails = env->NewObjectArray(count, g_jni.string_class, NULL);
+    jintArray jCounts = env->NewIntArray(count);
+    std::vector<jint> counts(events.size());
+    for (jsize i = 0; i < count; i++) {
+        jstring jRegion = env->NewStringUTF(events[i].region.c_str());
+        jstring jDetail = env->NewStringUTF(events[i].details.c_str());
+        env->SetObjectArrayElement(jRegions, i, jRegion);
+        env->SetObjectArrayElement(jDetails, i, jDetail);
+        env->DeleteLocalRef(jRegion);
+        env->DeleteLocalRef(jDetail);
+        counts[i] = static_cast<jint>(events[i].count);
+    }
+    env->SetIntArrayRegion(jCounts, 0, count, counts.data());
 
-    env->CallVoidMethod(callbackInfo.callbackObj, callbackInfo.methodId, jRegion, jDetails);
+    env->CallVoidMethod(callbackObj, g_jni.on_tampering_batch, jRegions, jDetails, jCounts);
 
-    env->DeleteLocalRef(jRegion);
+    env->DeleteLocalRef(jRegions);
     env->DeleteLocalRef(jDetails);
+    env->DeleteLocalRef(jCounts);
+    env->DeleteLocalRef(callbackObj);
 
     if (env->ExceptionCheck()) {
         env->ExceptionDescribe();
         env->ExceptionClear();
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Exception occurred during tampering callback");
+        LOGE("Exception occurred during tampering callback");
     }
+}
 
-    if (result == JNI_EDETACHED) {
-        g_jvm->DetachCurrentThread();
+static void jniAttachDispatcher() {
+    jniAttachCurrentThread("TamperDispatch");
+}
+
+static void jniProtectCompletion(jobject callback, const std::string& region, bool success) {
+    JNIEnv* env = jniAttachCurrentThread("BaselineWorker");
+    if (!env) {
+        // Cannot release the reference without an env; the callback leaks.
+        return;
+    }
+
+    jstring jRegion = env->NewStringUTF(region.c_str());
+    env->CallVoidMethod(callback, g_jni.on_region_protected, jRegion, success ? JNI_TRUE : JNI_FALSE);
+    env->DeleteLocalRef(jRegion);
+
+    if (env->ExceptionCheck()) {
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+        LOGE("Exception occurred during protection callback");
     }
+
+    env->DeleteGlobalRef(callback);
 }
 
 static MemoryMonitor* getMemoryMonitor(jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Getting monitor for handle: %lld", handle);
+    LOGV("Getting monitor for handle: %lld", handle);
     return reinterpret_cast<MemoryMonitor*>(handle);
 }
 
+static jobjectArray toStringArray(JNIEnv* env, const std::vector<std::string>& strings) {
+    jobjectArray array = env->NewObjectArray(static_cast<jsize>(strings.size()), g_jni.string_class, NULL);
+    if (array == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < strings.size(); i++) {
+        jstring jString = env->NewStringUTF(strings[i].c_str());
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), jString);
+        env->DeleteLocalRef(jString);
+    }
+    return array;
+}
+
+static std::vector<uint8_t> toByteVector(JNIEnv* env, jbyteArray array) {
+    std::vector<uint8_t> bytes;
+    if (array) {
+        bytes.resize(env->GetArrayLength(array));
+        env->GetByteArrayRegion(array, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<jbyte*>(bytes.data()));
+    }
+    return bytes;
+}
+
+// Deleting the monitor flushes its pending tamper events, which still need
+// the callback, so its reference is released afterwards.
+static void destroyMonitor(MemoryMonitor* monitor, jlong handle, JNIEnv* env) {
+    delete monitor;
+    std::lock_guard<std::mutex> lock(g_callbackMutex);
+    auto it = g_callbackMap.find(handle);
+    if (it != g_callbackMap.end()) {
+        if (env) {
+            env->DeleteGlobalRef(it->second);
+        }
+        g_callbackMap.erase(it);
+    }
+}
+
 JNIEXPORT jlong JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCreate(JNIEnv* env, jobject thiz) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Creating new MemoryMonitor");
+    LOGI("Creating new MemoryMonitor");
     MemoryMonitor* monitor = new MemoryMonitor();
     jlong handle = reinterpret_cast<jlong>(monitor);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Created monitor with handle: %lld", handle);
+    LOGI("Created monitor with handle: %lld", handle);
     return handle;
 }
 
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeDestroy(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Destroying monitor with handle: %lld", handle);
+    LOGI("Destroying monitor with handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
-    if (monitor) {
-        delete monitor;
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Monitor destroyed successfully");
+    if (monitor && monitor->isOwnThread()) {
+        // Destroyed from inside one of its callbacks: the thread running it
+        // returns into the monitor afterwards, so the delete is handed to a
+        // thread of its own that waits for this one to finish.
+        std::thread([monitor, handle]() {
+            destroyMonitor(monitor, handle, jniAttachCurrentThread("MonitorTeardown"));
+        }).detach();
+        LOGI("Monitor destruction deferred to a teardown thread");
+    } else if (monitor) {
+        destroyMonitor(monitor, handle, env);
+        LOGI("Monitor destroyed successfully");
     } else {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to destroy monitor - handle is null");
+        LOGE("Failed to destroy monitor - handle is null");
     }
 }
 
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartMonitoring(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Starting monitoring for handle: %lld", handle);
+    LOGD("Starting monitoring for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to start monitoring - monitor is null");
+        LOGE("Failed to start monitoring - monitor is null");
         return JNI_FALSE;
     }
     bool result = monitor->startMonitoring();
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Monitoring start result: %d", result);
+    LOGD("Monitoring start result: %d", result);
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopMonitoring(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Stopping monitoring for handle: %lld", handle);
+    LOGD("Stopping monitoring for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (monitor) {
         monitor->stopMonitoring();
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Monitoring stopped successfully");
+        LOGD("Monitoring stopped successfully");
     } else {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to stop monitoring - monitor is null");
+        LOGE("Failed to stop monitoring - monitor is null");
     }
 }
 
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeIsMonitoring(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Checking monitoring status for handle: %lld", handle);
+    LOGD("Checking monitoring status for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to check monitoring status - monitor is null");
+        LOGE("Failed to check monitoring status - monitor is null");
         return JNI_FALSE;
     }
     bool result = monitor->isMonitoring();
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Monitoring status: %d", result);
+    LOGD("Monitoring status: %d", result);
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jobject JNICALL
+JNIEXPORT jobjectArray JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetCriticalRegions(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Getting critical regions for handle: %lld", handle);
+    LOGD("Getting critical regions for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get critical regions - monitor is null");
-        jclass arrayListClass = env->FindClass("java/util/ArrayList");
-        jmethodID constructor = env->GetMethodID(arrayListClass, "<init>", "()V");
-        return env->NewObject(arrayListClass, constructor);
+        LOGE("Failed to get critical regions - monitor is null");
+        return toStringArray(env, std::vector<std::string>());
     }
 
-    jclass arrayListClass = env->FindClass("java/util/ArrayList");
-    jmethodID constructor = env->GetMethodID(arrayListClass, "<init>", "()V");
-    jobject arrayList = env->NewObject(arrayListClass, constructor);
-    jmethodID addMethod = env->GetMethodID(arrayListClass, "add", "(Ljava/lang/Object;)Z");
-
     std::vector<std::string> regions = monitor->getCriticalRegions();
-    
-    for (const auto& region : regions) {
-        jstring jRegion = env->NewStringUTF(region.c_str());
-        env->CallBooleanMethod(arrayList, addMethod, jRegion);
-        env->DeleteLocalRef(jRegion);
-    }
-
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Returning %zu critical regions", regions.size());
-    return arrayList;
+    LOGD("Returning %zu critical regions", regions.size());
+    return toStringArray(env, regions);
 }
 
-JNIEXPORT jobject JNICALL
+JNIEXPORT jobjectArray JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetProtectedRegions(JNIEnv* env, jobject thiz, jlong handle) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Getting protected regions for handle: %lld", handle);
+    LOGD("Getting protected regions for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get protected regions - monitor is null");
-        jclass arrayListClass = env->FindClass("java/util/ArrayList");
-        jmethodID constructor = env->GetMethodID(arrayListClass, "<init>", "()V");
-        return env->NewObject(arrayListClass, constructor);
+        LOGE("Failed to get protected regions - monitor is null");
+        return toStringArray(env, std::vector<std::string>());
     }
 
-    jclass arrayListClass = env->FindClass("java/util/ArrayList");
-    jmethodID constructor = env->GetMethodID(arrayListClass, "<init>", "()V");
-    jobject arrayList = env->NewObject(arrayListClass, constructor);
-    jmethodID addMethod = env->GetMethodID(arrayListClass, "add", "(Ljava/lang/Object;)Z");
-
     std::vector<std::string> regions = monitor->getProtectedRegions();
-    
-    for (const auto& region : regions) {
-        jstring jRegion = env->NewStringUTF(region.c_str());
-        env->CallBooleanMethod(arrayList, addMethod, jRegion);
-        env->DeleteLocalRef(jRegion);
-    }
-
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Returning %zu protected regions", regions.size());
-    return arrayList;
+    LOGD("Returning %zu protected regions", regions.size());
+    return toStringArray(env, regions);
 }
 
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Scanning memory region for handle: %lld", handle);
+    LOGD("Scanning memory region for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to scan memory region - monitor is null");
+        LOGE("Failed to scan memory region - monitor is null");
         return JNI_FALSE;
     }
 
     const char* regionStr = env->GetStringUTFChars(region, nullptr);
     bool result = monitor->scanMemoryRegion(regionStr);
     env->ReleaseStringUTFChars(region, regionStr);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory region scan result: %d", result);
+    LOGD("Memory region scan result: %d", result);
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetRegionId(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to get region id - monitor is null");
+        return kInvalidRegionId;
+    }
+
+    const char* regionStr = env->GetStringUTFChars(region, nullptr);
+    RegionId id = monitor->getRegionId(regionStr);
+    env->ReleaseStringUTFChars(region, regionStr);
+    return id;
+}
+
 JNIEXPORT jboolean JNICALL
-Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCompareMemoryRegions(JNIEnv* env, jobject thiz, jlong handle, jstring region1, jstring region2) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Comparing memory regions for handle: %lld", handle);
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanMemoryRegionById(JNIEnv* env, jobject thiz, jlong handle, jint id) {
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to compare memory regions - monitor is null");
+        LOGE("Failed to scan memory region - monitor is null");
         return JNI_FALSE;
     }
 
+    return monitor->scanMemoryRegion(static_cast<RegionId>(id)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanRegions(JNIEnv* env, jobject thiz, jlong handle, jintArray ids) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to scan memory regions - monitor is null");
+        return nullptr;
+    }
+
+    jsize count = env->GetArrayLength(ids);
+    std::vector<jint> rawIds(count);
+    env->GetIntArrayRegion(ids, 0, count, rawIds.data());
+
+    std::vector<RegionScanResult> results;
+    monitor->scanMemoryRegions(std::vector<RegionId>(rawIds.begin(), rawIds.end()), results);
+
+    // Three longs per region: status, elapsed nanoseconds, changed chunks.
+    std::vector<jlong> packed;
+    packed.reserve(results.size() * 3);
+    for (const auto& result : results) {
+        packed.push_back(result.status);
+        packed.push_back(result.elapsed_ns);
+        packed.push_back(static_cast<jlong>(result.changed_chunks));
+    }
+
+    jlongArray result = env->NewLongArray(static_cast<jsize>(packed.size()));
+    if (result) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(packed.size()), packed.data());
+    }
+    return result;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCompareMemoryRegions(JNIEnv* env, jobject thiz, jlong handle, jstring region1, jstring region2, jboolean deep) {
+    LOGD("Comparing memory regions for handle: %lld", handle);
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to compare memory regions - monitor is null");
+        return static_cast<jlong>(kRegionsNotComparable);
+    }
+
     const char* region1Str = env->GetStringUTFChars(region1, nullptr);
     const char* region2Str = env->GetStringUTFChars(region2, nullptr);
-    bool result = monitor->compareMemoryRegions(region1Str, region2Str);
+    int64_t difference = kRegionsNotComparable;
+    bool result = monitor->compareMemoryRegions(region1Str, region2Str, deep == JNI_TRUE, &difference);
     env->ReleaseStringUTFChars(region1, region1Str);
     env->ReleaseStringUTFChars(region2, region2Str);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory regions comparison result: %d", result);
-    return result ? JNI_TRUE : JNI_FALSE;
+    LOGD("Memory regions comparison result: %d", result);
+    return static_cast<jlong>(difference);
 }
 
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeAddCriticalRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Adding critical region for handle: %lld", handle);
+    LOGD("Adding critical region for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to add critical region - monitor is null");
+        LOGE("Failed to add critical region - monitor is null");
         return;
     }
 
     const char* regionStr = env->GetStringUTFChars(region, nullptr);
     monitor->addCriticalRegion(regionStr);
     env->ReleaseStringUTFChars(region, regionStr);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Critical region added successfully");
+    LOGD("Critical region added successfully");
 }
 
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeRemoveCriticalRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Removing critical region for handle: %lld", handle);
+    LOGD("Removing critical region for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to remove critical region - monitor is null");
+        LOGE("Failed to remove critical region - monitor is null");
         return;
     }
 
     const char* regionStr = env->GetStringUTFChars(region, nullptr);
     monitor->removeCriticalRegion(regionStr);
     env->ReleaseStringUTFChars(region, regionStr);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Critical region removed successfully");
+    LOGD("Critical region removed successfully");
 }
 
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Protecting memory region for handle: %lld", handle);
+    LOGD("Protecting memory region for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to protect memory region - monitor is null");
+        LOGE("Failed to protect memory region - monitor is null");
         return JNI_FALSE;
     }
 
     const char* regionStr = env->GetStringUTFChars(region, nullptr);
     bool result = monitor->protectMemoryRegion(regionStr);
     env->ReleaseStringUTFChars(region, regionStr);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory region protection result: %d", result);
+    LOGD("Memory region protection result: %d", result);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectMemoryRegionAsync(JNIEnv* env, jobject thiz, jlong handle, jstring region, jobject callback) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to queue memory region protection - monitor is null");
+        return JNI_FALSE;
+    }
+
+    // The worker thread outlives this call, so it needs a global reference;
+    // the completion releases it once the callback has run.
+    jobject callbackRef = env->NewGlobalRef(callback);
+    const char* regionStr = env->GetStringUTFChars(region, nullptr);
+    bool result = monitor->protectMemoryRegionAsync(regionStr,
+        [callbackRef](const std::string& name, bool success) {
+            jniProtectCompletion(callbackRef, name, success);
+        });
+    env->ReleaseStringUTFChars(region, regionStr);
+
+    if (!result) {
+        env->DeleteGlobalRef(callbackRef);
+    }
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeIsRegionPending(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to query pending region - monitor is null");
+        return JNI_FALSE;
+    }
+
+    const char* regionStr = env->GetStringUTFChars(region, nullptr);
+    bool result = monitor->isRegionPending(regionStr);
+    env->ReleaseStringUTFChars(region, regionStr);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jintArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectRegions(JNIEnv* env, jobject thiz, jlong handle, jobjectArray regions, jboolean critical) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to protect memory regions - monitor is null");
+        return nullptr;
+    }
+
+    jsize count = env->GetArrayLength(regions);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (jsize i = 0; i < count; i++) {
+        jstring region = static_cast<jstring>(env->GetObjectArrayElement(regions, i));
+        const char* regionStr = env->GetStringUTFChars(region, nullptr);
+        names.push_back(regionStr);
+        env->ReleaseStringUTFChars(region, regionStr);
+        env->DeleteLocalRef(region);
+    }
+
+    std::vector<RegionId> ids;
+    monitor->protectMemoryRegions(names, critical == JNI_TRUE, ids);
+
+    jintArray result = env->NewIntArray(count);
+    if (result) {
+        std::vector<jint> packed(ids.begin(), ids.end());
+        env->SetIntArrayRegion(result, 0, count, packed.data());
+    }
+    return result;
+}
+
+JNIEXPORT jintArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectFromManifest(JNIEnv* env, jobject thiz, jlong handle, jobjectArray regions) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to protect regions from the golden manifest - monitor is null");
+        return nullptr;
+    }
+
+    jsize count = env->GetArrayLength(regions);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (jsize i = 0; i < count; i++) {
+        jstring region = static_cast<jstring>(env->GetObjectArrayElement(regions, i));
+        const char* regionStr = env->GetStringUTFChars(region, nullptr);
+        names.push_back(regionStr);
+        env->ReleaseStringUTFChars(region, regionStr);
+        env->DeleteLocalRef(region);
+    }
+
+    std::vector<RegionId> ids;
+    monitor->protectFromManifest(names, ids);
+
+    jintArray result = env->NewIntArray(count);
+    if (result) {
+        std::vector<jint> packed(ids.begin(), ids.end());
+        env->SetIntArrayRegion(result, 0, count, packed.data());
+    }
+    return result;
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeUnprotectMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Unprotecting memory region for handle: %lld", handle);
+    LOGD("Unprotecting memory region for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to unprotect memory region - monitor is null");
+        LOGE("Failed to unprotect memory region - monitor is null");
         return JNI_FALSE;
     }
 
     const char* regionStr = env->GetStringUTFChars(region, nullptr);
     bool result = monitor->unprotectMemoryRegion(regionStr);
     env->ReleaseStringUTFChars(region, regionStr);
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory region unprotection result: %d", result);
+    LOGD("Memory region unprotection result: %d", result);
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSimulateMemoryTampering(
         JNIEnv *env, jobject thiz, jlong handle, jstring region) {
-    __android_log_print(ANDROID_LOG_INFO, "MemoryMonitorJNI", "Simulating memory tampering with handle: %lld", (long long)handle);
+    LOGD("Simulating memory tampering with handle: %lld", (long long)handle);
     
     MemoryMonitor* monitor = reinterpret_cast<MemoryMonitor*>(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, "MemoryMonitorJNI", "Invalid memory monitor handle");
+        LOGE("Invalid memory monitor handle");
         return JNI_FALSE;
     }
     
@@ -311,59 +599,391 @@ Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSimulateMemoryTampering(
     
     bool result = monitor->simulateMemoryTampering(regionStr);
     
-    __android_log_print(ANDROID_LOG_INFO, "MemoryMonitorJNI", "Memory tampering simulation result: %s", 
+    LOGD("Memory tampering simulation result: %s", 
                         result ? "success" : "failed");
     
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanAllProtectedRegions(JNIEnv* env, jobject thiz, jlong handle) {
+    LOGD("Scanning all protected regions for handle: %lld", handle);
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to scan protected regions - monitor is null");
+        return JNI_FALSE;
+    }
+
+    bool result = monitor->scanAllProtectedRegions();
+    LOGD("Protected regions scan result: %d", result);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartScanScheduler(JNIEnv* env, jobject thiz, jlong handle, jlong intervalMs, jboolean criticalOnly) {
+    LOGD("Starting scan scheduler for handle: %lld", handle);
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to start scan scheduler - monitor is null");
+        return JNI_FALSE;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.critical_regions_only = criticalOnly == JNI_TRUE;
+    bool result = monitor->startScanScheduler(static_cast<long>(intervalMs), policy);
+    LOGD("Scan scheduler start result: %d", result);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT void JNICALL
-Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetTamperingCallback(
-        JNIEnv* env, jobject thiz, jlong handle, jobject callback) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Setting tampering callback for handle: %lld", handle);
-    
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopScanScheduler(JNIEnv* env, jobject thiz, jlong handle) {
+    LOGD("Stopping scan scheduler for handle: %lld", handle);
     MemoryMonitor* monitor = getMemoryMonitor(handle);
     if (!monitor) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to set tampering callback - monitor is null");
+        LOGE("Failed to stop scan scheduler - monitor is null");
         return;
     }
-    
-    auto it = g_callbackMap.find(handle);
-    if (it != g_callbackMap.end() && it->second.callbackObj != NULL) {
-        env->DeleteGlobalRef(it->second.callbackObj);
-        g_callbackMap.erase(it);
+
+    monitor->stopScanScheduler();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartFileWatching(JNIEnv* env, jobject thiz, jlong handle) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to start file watching - monitor is null");
+        return JNI_FALSE;
     }
-    
-    if (callback == NULL) {
-        monitor->setTamperingCallback(nullptr);
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Tampering callback cleared for handle: %lld", handle);
+
+    return monitor->startFileWatching() ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopFileWatching(JNIEnv* env, jobject thiz, jlong handle) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to stop file watching - monitor is null");
+        return;
+    }
+
+    monitor->stopFileWatching();
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetChunkedHashing(JNIEnv* env, jobject thiz, jlong handle, jint chunkSize, jlong minRegionSize, jboolean stopAtFirstMismatch) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure chunked hashing - monitor is null");
+        return;
+    }
+
+    ChunkingConfig config;
+    config.chunk_size = chunkSize > 0 ? static_cast<size_t>(chunkSize) : 0;
+    config.min_region_size = minRegionSize > 0 ? static_cast<size_t>(minRegionSize) : 0;
+    config.stop_at_first_mismatch = stopAtFirstMismatch == JNI_TRUE;
+    monitor->setChunkingConfig(config);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetFileStreaming(JNIEnv* env, jobject thiz, jlong handle, jlong minFileSize, jlong blockSize) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure file streaming - monitor is null");
+        return;
+    }
+
+    StreamingConfig config;
+    config.min_file_size = minFileSize > 0 ? static_cast<size_t>(minFileSize) : 0;
+    if (blockSize > 0) {
+        config.block_size = static_cast<size_t>(blockSize);
+    }
+    monitor->setStreamingConfig(config);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetIncrementalScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint fullScanInterval) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure incremental scanning - monitor is null");
+        return;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.incremental_full_scan_interval = fullScanInterval > 0 ? static_cast<uint32_t>(fullScanInterval) : 0;
+    monitor->setScanPolicy(policy);
+    monitor->setIncrementalScanning(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetParallelScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure parallel scanning - monitor is null");
+        return;
+    }
+
+    monitor->setParallelScanning(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetStatFastPath(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint deepScanInterval, jboolean jitter) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure stat fast path - monitor is null");
+        return;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.skip_unchanged_files = enabled == JNI_TRUE;
+    policy.deep_scan_interval = deepScanInterval > 0 ? static_cast<uint32_t>(deepScanInterval) : 0;
+    policy.jitter_deep_scans = jitter == JNI_TRUE;
+    monitor->setScanPolicy(policy);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetFastHashing(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint fullHashInterval) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure fast hashing - monitor is null");
+        return;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.fast_hash_memory = enabled == JNI_TRUE;
+    policy.full_hash_interval = fullHashInterval > 0 ? static_cast<uint32_t>(fullHashInterval) : 0;
+    monitor->setScanPolicy(policy);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetAdaptiveScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jlong baseIntervalMs, jlong maxIntervalMs, jint timeSlices, jlong maxTickBytes) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure adaptive scanning - monitor is null");
         return;
     }
+
+    AdaptiveScanConfig config;
+    config.base_interval_ms = baseIntervalMs > 0 ? static_cast<uint32_t>(baseIntervalMs) : 1;
+    config.max_interval_ms = maxIntervalMs > 0 ? static_cast<uint32_t>(maxIntervalMs) : 0;
+    config.time_slices = timeSlices > 0 ? static_cast<uint32_t>(timeSlices) : 1;
+    config.max_tick_bytes = maxTickBytes > 0 ? static_cast<uint64_t>(maxTickBytes) : 0;
+    monitor->setAdaptiveScanning(enabled == JNI_TRUE, config);
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetDeviceState(JNIEnv* env, jobject thiz, jlong handle, jboolean foreground, jboolean batterySaver, jint thermalStatus) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to set device state - monitor is null");
+        return;
+    }
+
+    DeviceState state;
+    state.foreground = foreground == JNI_TRUE;
+    state.battery_saver = batterySaver == JNI_TRUE;
+    state.thermal_status = static_cast<int>(thermalStatus);
+    monitor->setDeviceState(state);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetWriteTrapping(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint rehashInterval) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure write trapping - monitor is null");
+        return JNI_FALSE;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.trapped_rehash_interval = rehashInterval > 0 ? static_cast<uint32_t>(rehashInterval) : 0;
+    monitor->setScanPolicy(policy);
+    return monitor->setWriteTrapping(enabled == JNI_TRUE) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetSharedVerification(JNIEnv* env, jobject thiz, jlong handle, jint maxAgeMs) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to configure shared verification - monitor is null");
+        return;
+    }
+
+    ScanPolicy policy = monitor->getScanPolicy();
+    policy.shared_result_max_age_ms = maxAgeMs > 0 ? static_cast<uint32_t>(maxAgeMs) : 0;
+    monitor->setScanPolicy(policy);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCreateRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group, jobjectArray members) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to create region group - monitor is null");
+        return JNI_FALSE;
+    }
+
+    jsize count = env->GetArrayLength(members);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (jsize i = 0; i < count; i++) {
+        jstring member = static_cast<jstring>(env->GetObjectArrayElement(members, i));
+        const char* memberStr = env->GetStringUTFChars(member, nullptr);
+        names.push_back(memberStr);
+        env->ReleaseStringUTFChars(member, memberStr);
+        env->DeleteLocalRef(member);
+    }
+
+    const char* groupStr = env->GetStringUTFChars(group, nullptr);
+    bool result = monitor->createRegionGroup(groupStr, names);
+    env->ReleaseStringUTFChars(group, groupStr);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeRemoveRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to remove region group - monitor is null");
+        return;
+    }
+
+    const char* groupStr = env->GetStringUTFChars(group, nullptr);
+    monitor->removeRegionGroup(groupStr);
+    env->ReleaseStringUTFChars(group, groupStr);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to scan region group - monitor is null");
+        return JNI_FALSE;
+    }
+
+    const char* groupStr = env->GetStringUTFChars(group, nullptr);
+    bool result = monitor->scanRegionGroup(groupStr);
+    env->ReleaseStringUTFChars(group, groupStr);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_EnvironmentCheck_nativeCheckEnvironment(JNIEnv* env, jobject thiz) {
+    return static_cast<jint>(checkEnvironment());
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetTracing(JNIEnv* env, jobject thiz, jboolean enabled) {
+    TraceRing::instance().setEnabled(enabled == JNI_TRUE);
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetTrace(JNIEnv* env, jobject thiz) {
+    std::vector<TraceEvent> events;
+    TraceRing::instance().snapshot(events);
+
+    // Five longs per event: timestamp, duration, region id, op, result.
+    std::vector<jlong> packed;
+    packed.reserve(events.size() * 5);
+    for (const auto& event : events) {
+        packed.push_back(static_cast<jlong>(event.timestamp_ns));
+        packed.push_back(static_cast<jlong>(event.duration_ns));
+        packed.push_back(event.region);
+        packed.push_back(event.op);
+        packed.push_back(event.result);
+    }
+
+    jlongArray result = env->NewLongArray(static_cast<jsize>(packed.size()));
+    if (result) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(packed.size()), packed.data());
+    }
+    return result;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSaveBaseline(JNIEnv* env, jobject thiz, jlong handle, jstring path, jbyteArray key) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to save baseline - monitor is null");
+        return JNI_FALSE;
+    }
+
+    const char* pathStr = env->GetStringUTFChars(path, nullptr);
+    bool result = monitor->saveBaseline(pathStr, toByteVector(env, key));
+    env->ReleaseStringUTFChars(path, pathStr);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeLoadBaseline(JNIEnv* env, jobject thiz, jlong handle, jstring path, jbyteArray key) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to load baseline - monitor is null");
+        return -1;
+    }
+
+    const char* pathStr = env->GetStringUTFChars(path, nullptr);
+    size_t restored = 0;
+    bool result = monitor->loadBaseline(pathStr, toByteVector(env, key), &restored);
+    env->ReleaseStringUTFChars(path, pathStr);
+    return result ? static_cast<jint>(restored) : -1;
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetScanMetrics(JNIEnv* env, jobject thiz, jlong handle) {
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to get scan metrics - monitor is null");
+        return nullptr;
+    }
+
+    std::vector<int64_t> packed;
+    monitor->getScanMetrics(packed);
+
+    jlongArray result = env->NewLongArray(static_cast<jsize>(packed.size()));
+    if (result) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(packed.size()),
+                                reinterpret_cast<const jlong*>(packed.data()));
+    }
+    return result;
+}
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetTamperingCallback(
+        JNIEnv* env, jobject thiz, jlong handle, jobject callback) {
+    LOGD("Setting tampering callback for handle: %lld", handle);
     
-    jclass callbackClass = env->GetObjectClass(callback);
-    if (callbackClass == NULL) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get callback class");
+    MemoryMonitor* monitor = getMemoryMonitor(handle);
+    if (!monitor) {
+        LOGE("Failed to set tampering callback - monitor is null");
         return;
     }
     
-    jmethodID methodId = env->GetMethodID(callbackClass, "onTamperingDetected", "(Ljava/lang/String;Ljava/lang/String;)V");
-    if (methodId == NULL) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get onTamperingDetected method");
-        env->DeleteLocalRef(callbackClass);
+    {
+        std::lock_guard<std::mutex> lock(g_callbackMutex);
+        auto it = g_callbackMap.find(handle);
+        if (it != g_callbackMap.end()) {
+            env->DeleteGlobalRef(it->second);
+            g_callbackMap.erase(it);
+        }
+    }
+    
+    if (callback == NULL) {
+        monitor->setTamperingBatchCallback(nullptr);
+        LOGI("Tampering callback cleared for handle: %lld", handle);
         return;
     }
     
     jobject globalCallback = env->NewGlobalRef(callback);
+    {
+        std::lock_guard<std::mutex> lock(g_callbackMutex);
+        g_callbackMap[handle] = globalCallback;
+    }
     
-    TamperingCallbackInfo callbackInfo;
-    callbackInfo.callbackObj = globalCallback;
-    callbackInfo.methodId = methodId;
-    g_callbackMap[handle] = callbackInfo;
-    
-    monitor->setTamperingCallback([handle](const std::string& region, const std::string& details) {
-        jniTamperingCallback(region, details, handle);
-    });
+    // Only naming matters here: the dispatcher would attach on its first
+    // batch anyway, and the thread key detaches it when it exits.
+    DispatcherHooks hooks;
+    hooks.on_start = jniAttachDispatcher;
+    monitor->setTamperingBatchCallback([handle](const std::vector<TamperEvent>& events) {
+        jniTamperingBatch(events, handle);
+    }, hooks);
     
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Tampering callback set successfully for handle: %lld", handle);
-    env->DeleteLocalRef(callbackClass);
+    LOGI("Tampering callback set successfully for handle: %lld", handle);
 } 
\ No newline at end of file
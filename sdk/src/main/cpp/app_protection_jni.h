@@ -39,17 +39,26 @@ Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopMonitoring(JNIEnv* e
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeIsMonitoring(JNIEnv* env, jobject thiz, jlong handle);
 
-JNIEXPORT jobject JNICALL
+JNIEXPORT jobjectArray JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetCriticalRegions(JNIEnv* env, jobject thiz, jlong handle);
 
-JNIEXPORT jobject JNICALL
+JNIEXPORT jobjectArray JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetProtectedRegions(JNIEnv* env, jobject thiz, jlong handle);
 
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region);
 
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetRegionId(JNIEnv* env, jobject thiz, jlong handle, jstring region);
+
 JNIEXPORT jboolean JNICALL
-Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCompareMemoryRegions(JNIEnv* env, jobject thiz, jlong handle, jstring region1, jstring region2);
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanMemoryRegionById(JNIEnv* env, jobject thiz, jlong handle, jint id);
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanRegions(JNIEnv* env, jobject thiz, jlong handle, jintArray ids);
+
+JNIEXPORT jlong JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCompareMemoryRegions(JNIEnv* env, jobject thiz, jlong handle, jstring region1, jstring region2, jboolean deep);
 
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeAddCriticalRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region);
@@ -60,6 +69,18 @@ Java_com_appprotection_sdk_internal_MemoryMonitor_nativeRemoveCriticalRegion(JNI
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region);
 
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectMemoryRegionAsync(JNIEnv* env, jobject thiz, jlong handle, jstring region, jobject callback);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeIsRegionPending(JNIEnv* env, jobject thiz, jlong handle, jstring region);
+
+JNIEXPORT jintArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectRegions(JNIEnv* env, jobject thiz, jlong handle, jobjectArray regions, jboolean critical);
+
+JNIEXPORT jintArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeProtectFromManifest(JNIEnv* env, jobject thiz, jlong handle, jobjectArray regions);
+
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeUnprotectMemoryRegion(JNIEnv* env, jobject thiz, jlong handle, jstring region);
 
@@ -69,6 +90,75 @@ Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSimulateMemoryTampering(
 JNIEXPORT jboolean JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanAllProtectedRegions(JNIEnv* env, jobject thiz, jlong handle);
 
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartScanScheduler(JNIEnv* env, jobject thiz, jlong handle, jlong intervalMs, jboolean criticalOnly);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopScanScheduler(JNIEnv* env, jobject thiz, jlong handle);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartFileWatching(JNIEnv* env, jobject thiz, jlong handle);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStopFileWatching(JNIEnv* env, jobject thiz, jlong handle);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetChunkedHashing(JNIEnv* env, jobject thiz, jlong handle, jint chunkSize, jlong minRegionSize, jboolean stopAtFirstMismatch);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetFileStreaming(JNIEnv* env, jobject thiz, jlong handle, jlong minFileSize, jlong blockSize);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetIncrementalScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint fullScanInterval);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetParallelScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetStatFastPath(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint deepScanInterval, jboolean jitter);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetFastHashing(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint fullHashInterval);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetAdaptiveScanning(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jlong baseIntervalMs, jlong maxIntervalMs, jint timeSlices, jlong maxTickBytes);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetDeviceState(JNIEnv* env, jobject thiz, jlong handle, jboolean foreground, jboolean batterySaver, jint thermalStatus);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetWriteTrapping(JNIEnv* env, jobject thiz, jlong handle, jboolean enabled, jint rehashInterval);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetSharedVerification(JNIEnv* env, jobject thiz, jlong handle, jint maxAgeMs);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCreateRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group, jobjectArray members);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeRemoveRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanRegionGroup(JNIEnv* env, jobject thiz, jlong handle, jstring group);
+
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_EnvironmentCheck_nativeCheckEnvironment(JNIEnv* env, jobject thiz);
+
+JNIEXPORT void JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetTracing(JNIEnv* env, jobject thiz, jboolean enabled);
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetTrace(JNIEnv* env, jobject thiz);
+
+JNIEXPORT jboolean JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSaveBaseline(JNIEnv* env, jobject thiz, jlong handle, jstring path, jbyteArray key);
+
+JNIEXPORT jint JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeLoadBaseline(JNIEnv* env, jobject thiz, jlong handle, jstring path, jbyteArray key);
+
+JNIEXPORT jlongArray JNICALL
+Java_com_appprotection_sdk_internal_MemoryMonitor_nativeGetScanMetrics(JNIEnv* env, jobject thiz, jlong handle);
+
 JNIEXPORT void JNICALL
 Java_com_appprotection_sdk_internal_MemoryMonitor_nativeSetTamperingCallback(JNIEnv* env, jobject thiz, jlong handle, jobject callback);
 
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "baseline_store.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "log.h"
+
+#define TAG "BaselineStore"
+
+static const size_t kHmacBlockSize = 64;
+
+void hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t length,
+                uint8_t* mac) {
+    uint8_t block[kHmacBlockSize] = {};
+    if (keyLength > kHmacBlockSize) {
+        SHA256_CTX ctx;
+        SHA256_Init(&ctx);
+        SHA256_Update(&ctx, key, keyLength);
+        SHA256_Final(block, &ctx);
+    } else if (keyLength > 0) {
+        memcpy(block, key, keyLength);
+    }
+
+    uint8_t pad[kHmacBlockSize];
+    uint8_t inner[SHA256_DIGEST_LENGTH];
+    SHA256_CTX ctx;
+
+    for (size_t i = 0; i < kHmacBlockSize; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, pad, sizeof(pad));
+    SHA256_Update(&ctx, data, length);
+    SHA256_Final(inner, &ctx);
+
+    for (size_t i = 0; i < kHmacBlockSize; i++) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, pad, sizeof(pad));
+    SHA256_Update(&ctx, inner, sizeof(inner));
+    SHA256_Final(mac, &ctx);
+}
+
+static bool macEquals(const uint8_t* a, const uint8_t* b) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < SHA256_DIGEST_LENGTH; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+static size_t align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+static bool writeAll(int fd, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool writeBaselineFile(const std::string& path, const std::vector<BaselineEntry>& entries,
+                       const std::vector<uint8_t>& key) {
+    std::vector<BaselineRecord> records(entries.size());
+    std::vector<uint8_t> data;
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const BaselineEntry& entry = entries[i];
+        BaselineRecord& record = records[i];
+        memset(&record, 0, sizeof(record));
+
+        record.dev = static_cast<uint64_t>(entry.stamp.dev);
+        record.ino = static_cast<uint64_t>(entry.stamp.ino);
+        record.size = static_cast<int64_t>(entry.stamp.size);
+        record.content_size = entry.size;
+        record.mtime_sec = entry.stamp.mtime.tv_sec;
+        record.mtime_nsec = entry.stamp.mtime.tv_nsec;
+        record.ctime_sec = entry.stamp.ctime.tv_sec;
+        record.ctime_nsec = entry.stamp.ctime.tv_nsec;
+        record.chunk_size = static_cast<uint32_t>(entry.chunk_size);
+        record.chunk_count = static_cast<uint32_t>(entry.chunk_hashes.size() / SHA256_DIGEST_LENGTH);
+        record.flags = entry.streamed ? kBaselineStreamed : 0;
+
+        record.path_offset = data.size();
+        record.path_length = static_cast<uint32_t>(entry.path.size());
+        data.insert(data.end(), entry.path.begin(), entry.path.end());
+        data.resize(align8(data.size()), 0);
+
+        record.digest_offset = data.size();
+        data.insert(data.end(), entry.hash, entry.hash + SHA256_DIGEST_LENGTH);
+        data.insert(data.end(), entry.chunk_hashes.begin(), entry.chunk_hashes.end());
+    }
+
+    BaselineHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kBaselineMagic;
+    header.version = kBaselineVersion;
+    header.header_size = sizeof(BaselineHeader);
+    header.record_size = sizeof(BaselineRecord);
+    header.region_count = static_cast<uint32_t>(records.size());
+    header.records_offset = sizeof(BaselineHeader);
+    header.data_offset = header.records_offset + records.size() * sizeof(BaselineRecord);
+    header.data_size = data.size();
+
+    std::vector<uint8_t> file(sizeof(header));
+    memcpy(file.data(), &header, sizeof(header));
+    const uint8_t* recordBytes = reinterpret_cast<const uint8_t*>(records.data());
+    file.insert(file.end(), recordBytes, recordBytes + records.size() * sizeof(BaselineRecord));
+    file.insert(file.end(), data.begin(), data.end());
+
+    uint8_t mac[SHA256_DIGEST_LENGTH];
+    hmacSha256(key.data(), key.size(), file.data(), file.size(), mac);
+    file.insert(file.end(), mac, mac + sizeof(mac));
+
+    std::string tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        LOGE("Failed to create baseline file %s: %s", tmpPath.c_str(), strerror(errno));
+        return false;
+    }
+
+    bool written = writeAll(fd, file.data(), file.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!written || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOGE("Failed to write baseline file %s: %s", path.c_str(), strerror(errno));
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    LOGI("Saved %zu region baselines to %s (%zu bytes)", entries.size(), path.c_str(), file.size());
+    return true;
+}
+
+bool readBaselineFile(const std::string& path, const std::vector<uint8_t>& key,
+                      std::vector<BaselineEntry>& entries) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        LOGD("No baseline file at %s: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    MappedFile file;
+    bool mapped = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+                  static_cast<size_t>(st.st_size) >= sizeof(BaselineHeader) + SHA256_DIGEST_LENGTH &&
+                  file.map(fd, static_cast<size_t>(st.st_size));
+    close(fd);
+    if (!mapped) {
+        LOGW("Baseline file %s is unreadable or too short", path.c_str());
+        return false;
+    }
+
+    const uint8_t* base = file.data();
+    size_t sealedSize = file.size() - SHA256_DIGEST_LENGTH;
+    uint8_t mac[SHA256_DIGEST_LENGTH];
+    hmacSha256(key.data(), key.size(), base, sealedSize, mac);
+    if (!macEquals(mac, base + sealedSize)) {
+        LOGW("Baseline file %s failed authentication", path.c_str());
+        return false;
+    }
+
+    BaselineHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (header.magic != kBaselineMagic || header.version != kBaselineVersion ||
+        header.header_size != sizeof(BaselineHeader) || header.record_size != sizeof(BaselineRecord)) {
+        LOGW("Baseline file %s has an unsupported format (version %u)", path.c_str(), header.version);
+        return false;
+    }
+
+    // Offsets come from the file, so every bound is checked without sums
+    // that could wrap around.
+    uint64_t recordsSize = static_cast<uint64_t>(header.region_count) * sizeof(BaselineRecord);
+    if (header.records_offset < sizeof(BaselineHeader) || header.data_offset > sealedSize ||
+        header.records_offset > header.data_offset || recordsSize > header.data_offset - header.records_offset ||
+        header.data_size > sealedSize - header.data_offset) {
+        LOGW("Baseline file %s has inconsistent section bounds", path.c_str());
+        return false;
+    }
+
+    const uint8_t* data = base + header.data_offset;
+    std::vector<BaselineEntry> decoded(header.region_count);
+    for (uint32_t i = 0; i < header.region_count; i++) {
+        BaselineRecord record;
+        memcpy(&record, base + header.records_offset + i * sizeof(BaselineRecord), sizeof(record));
+
+        uint64_t digestBytes = (1 + static_cast<uint64_t>(record.chunk_count)) * SHA256_DIGEST_LENGTH;
+        if (record.path_offset > header.data_size || record.path_length > header.data_size - record.path_offset ||
+            record.digest_offset > header.data_size || digestBytes > header.data_size - record.digest_offset) {
+            LOGW("Baseline file %s has an out-of-bounds record %u", path.c_str(), i);
+            return false;
+        }
+
+        BaselineEntry& entry = decoded[i];
+        entry.path.assign(reinterpret_cast<const char*>(data + record.path_offset), record.path_length);
+        entry.stamp.dev = static_cast<dev_t>(record.dev);
+        entry.stamp.ino = static_cast<ino_t>(record.ino);
+        entry.stamp.size = static_cast<off_t>(record.size);
+        entry.stamp.mtime.tv_sec = static_cast<time_t>(record.mtime_sec);
+        entry.stamp.mtime.tv_nsec = static_cast<long>(record.mtime_nsec);
+        entry.stamp.ctime.tv_sec = static_cast<time_t>(record.ctime_sec);
+        entry.stamp.ctime.tv_nsec = static_cast<long>(record.ctime_nsec);
+        entry.size = static_cast<size_t>(record.content_size);
+        entry.chunk_size = record.chunk_size;
+        entry.streamed = (record.flags & kBaselineStreamed) != 0;
+
+        const uint8_t* digests = data + record.digest_offset;
+        memcpy(entry.hash, digests, SHA256_DIGEST_LENGTH);
+        entry.chunk_hashes.assign(digests + SHA256_DIGEST_LENGTH, digests + digestBytes);
+    }
+
+    entries.swap(decoded);
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_BASELINE_STORE_H
+#define APP_PROTECTION_BASELINE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <openssl/sha.h>
+#include "mapped_file.h"
+
+/**
+ * On-disk snapshot of file region baselines, so a warm start can restore
+ * them after an fstat instead of rehashing every file.
+ *
+ * Layout, all integers little-endian and every section 8-byte aligned so the
+ * file can be used straight from a mapping:
+ *
+ *   BaselineHeader
+ *   BaselineRecord[region_count]
+ *   data: paths, then per region its digest followed by its chunk digests
+ *   HMAC-SHA256 over everything above, keyed by the caller
+ *
+ * The key must not be derivable from anything readable on the device (the
+ * SDK keeps it wrapped by the Android Keystore), so a snapshot copied from
+ * elsewhere or edited on disk fails to load and cannot be re-sealed.
+ */
+
+static const uint32_t kBaselineMagic = 0x4c425041; // "APBL"
+static const uint16_t kBaselineVersion = 1;
+
+struct BaselineHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t record_size;
+    uint32_t region_count;
+    uint64_t records_offset;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint64_t reserved;
+};
+
+static const uint32_t kBaselineStreamed = 1u << 0;
+
+struct BaselineRecord {
+    uint64_t dev;
+    uint64_t ino;
+    // st_size, and the bytes actually hashed, which differ for streamed files.
+    int64_t size;
+    uint64_t content_size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    int64_t ctime_sec;
+    int64_t ctime_nsec;
+    // Offsets are relative to the start of the data section.
+    uint64_t path_offset;
+    uint32_t path_length;
+    uint32_t chunk_size;
+    uint64_t digest_offset;
+    uint32_t chunk_count;
+    uint32_t flags;
+};
+
+static_assert(sizeof(BaselineHeader) == 48, "BaselineHeader layout is part of the file format");
+static_assert(sizeof(BaselineRecord) == 96, "BaselineRecord layout is part of the file format");
+
+// Decoded form of one record.
+struct BaselineEntry {
+    std::string path;
+    FileStamp stamp;
+    size_t size = 0;
+    size_t chunk_size = 0;
+    bool streamed = false;
+    uint8_t hash[SHA256_DIGEST_LENGTH] = {};
+    std::vector<uint8_t> chunk_hashes;
+};
+
+void hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t length,
+                uint8_t* mac);
+
+// Writes the snapshot to a temporary file and renames it over `path`, so a
+// crash never leaves a truncated snapshot behind.
+bool writeBaselineFile(const std::string& path, const std::vector<BaselineEntry>& entries,
+                       const std::vector<uint8_t>& key);
+
+// Maps the snapshot, checks its header, bounds and HMAC, and decodes it.
+// Returns false without touching `entries` if any check fails.
+bool readBaselineFile(const std::string& path, const std::vector<uint8_t>& key,
+                      std::vector<BaselineEntry>& entries);
+
+#endif
@@ -0,0 +1,369 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Microbenchmarks for the native integrity engine. Builds on the host and
+// for devices (configure with -DAPP_PROTECTION_BUILD_BENCHMARKS=ON, push the
+// binary with adb and run it from /data/local/tmp).
+//
+//   app_protection_benchmark [--filter=<substring>] [--min-time-ms=<ms>]
+//                            [--max-size=<bytes>] [--tmpdir=<dir>] [--csv]
+//
+// Each case repeats its body, doubling the iteration count until a batch runs
+// for at least --min-time-ms, and reports the time per iteration of the last
+// batch. Configure with -DAPP_PROTECTION_LOG_LEVEL=WARN or higher so region
+// setup does not flood the output.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <openssl/sha.h>
+#include "fast_hash.h"
+#include "memory_monitor.h"
+#include "sha256_internal.h"
+#include "trace_ring.h"
+
+#ifdef APP_PROTECTION_BENCH_JNI
+#include "app_protection_jni.h"
+#endif
+
+namespace {
+
+struct Options {
+    std::string filter;
+    uint64_t min_time_ns = 200000000ULL;
+    size_t max_size = 64u << 20;
+    std::string tmpdir;
+    bool csv = false;
+};
+
+Options g_options;
+
+std::string formatSize(size_t bytes) {
+    char buffer[32];
+    if (bytes >= (1u << 20) && bytes % (1u << 20) == 0) {
+        snprintf(buffer, sizeof(buffer), "%zuM", bytes >> 20);
+    } else if (bytes >= 1024 && bytes % 1024 == 0) {
+        snprintf(buffer, sizeof(buffer), "%zuK", bytes >> 10);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%zu", bytes);
+    }
+    return buffer;
+}
+
+// Runs `body` until a batch takes at least the minimum time. `bytes` is the
+// amount of data one iteration processes, or 0 if throughput is meaningless.
+void runCase(const std::string& name, size_t bytes, const std::function<void()>& body) {
+    if (!g_options.filter.empty() && name.find(g_options.filter) == std::string::npos) {
+        return;
+    }
+
+    // One untimed call to fault in pages and warm the caches.
+    body();
+
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0;
+    for (;;) {
+        uint64_t start = TraceRing::nowNs();
+        for (uint64_t i = 0; i < iterations; i++) {
+            body();
+        }
+        elapsed = TraceRing::nowNs() - start;
+        if (elapsed >= g_options.min_time_ns || iterations >= (1ULL << 30)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double nsPerOp = static_cast<double>(elapsed) / static_cast<double>(iterations);
+    double mbPerSec = bytes ? (static_cast<double>(bytes) * 1e3) / nsPerOp : 0.0;
+    if (g_options.csv) {
+        printf("%s,%llu,%.1f,%.1f\n", name.c_str(), static_cast<unsigned long long>(iterations),
+               nsPerOp, mbPerSec);
+    } else if (bytes) {
+        printf("%-40s %12llu %14.1f ns %10.1f MB/s\n", name.c_str(),
+               static_cast<unsigned long long>(iterations), nsPerOp, mbPerSec);
+    } else {
+        printf("%-40s %12llu %14.1f ns\n", name.c_str(),
+               static_cast<unsigned long long>(iterations), nsPerOp);
+    }
+    fflush(stdout);
+}
+
+std::string defaultTmpdir() {
+    const char* env = getenv("TMPDIR");
+    if (env && *env) {
+        return env;
+    }
+#ifdef __ANDROID__
+    return "/data/local/tmp";
+#else
+    return "/tmp";
+#endif
+}
+
+// Creates a file of `size` pseudo-random bytes; the caller unlinks it.
+std::string createTestFile(size_t size) {
+    std::string path = g_options.tmpdir + "/app_protection_bench_XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+
+    int fd = mkstemp(name.data());
+    if (fd == -1) {
+        fprintf(stderr, "Failed to create a test file in %s: %s\n", g_options.tmpdir.c_str(), strerror(errno));
+        return std::string();
+    }
+
+    std::vector<uint8_t> block(1 << 16);
+    uint32_t seed = 0x9e3779b9u;
+    for (size_t written = 0; written < size;) {
+        for (auto& byte : block) {
+            seed = seed * 1664525u + 1013904223u;
+            byte = static_cast<uint8_t>(seed >> 24);
+        }
+        size_t length = std::min(block.size(), size - written);
+        if (write(fd, block.data(), length) != static_cast<ssize_t>(length)) {
+            fprintf(stderr, "Failed to write test file: %s\n", strerror(errno));
+            close(fd);
+            unlink(name.data());
+            return std::string();
+        }
+        written += length;
+    }
+    close(fd);
+    return std::string(name.data());
+}
+
+void benchSha256() {
+    std::vector<uint8_t> buffer(g_options.max_size);
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<uint8_t>(i * 131u);
+    }
+
+    for (size_t size = 64; size <= g_options.max_size; size *= 4) {
+        runCase("fast_hash/" + formatSize(size), size, [&]() {
+            volatile uint64_t hash = fastHash64(buffer.data(), size, 0);
+            (void)hash;
+        });
+        runCase("sha256/" + formatSize(size), size, [&]() {
+            unsigned char digest[SHA256_DIGEST_LENGTH];
+            SHA256_CTX ctx;
+            SHA256_Init(&ctx);
+            SHA256_Update(&ctx, buffer.data(), size);
+            SHA256_Final(digest, &ctx);
+        });
+    }
+}
+
+// Raw block functions on 4 KiB messages, independent of the backend picked at
+// load time, so the multi-buffer kernels can be compared on any CPU.
+void benchSha256Kernels() {
+    const size_t kMessage = 4096;
+    std::vector<uint8_t> buffer(8 * kMessage, 0x5a);
+    unsigned int states[8][8] = {};
+    unsigned int* statePtrs[8];
+    const unsigned char* dataPtrs[8];
+    for (size_t l = 0; l < 8; l++) {
+        statePtrs[l] = states[l];
+        dataPtrs[l] = buffer.data() + l * kMessage;
+    }
+
+    runCase("sha256_kernel/scalar/1x4K", kMessage, [&]() {
+        sha256_blocks_scalar(states[0], dataPtrs[0], kMessage / 64);
+    });
+    runCase("sha256_kernel/multi_x4/4x4K", 4 * kMessage, [&]() {
+        sha256_multi_blocks_x4(statePtrs, dataPtrs, kMessage / 64);
+    });
+    sha256_multi_block_fn avx2 = sha256_multi_blocks_avx2_backend();
+    if (avx2) {
+        runCase("sha256_kernel/multi_avx2/8x4K", 8 * kMessage, [&]() {
+            avx2(statePtrs, dataPtrs, kMessage / 64);
+        });
+    }
+
+    // What scanAllProtectedRegions does for small regions with the active backend.
+    const size_t kRegions = 64;
+    std::vector<uint8_t> regions(kRegions * kMessage, 0xa5);
+    std::vector<SHA256_CTX> contexts(kRegions);
+    std::vector<SHA256_CTX*> ctxPtrs(kRegions);
+    std::vector<const void*> data(kRegions);
+    std::vector<size_t> lengths(kRegions, kMessage);
+    for (size_t i = 0; i < kRegions; i++) {
+        ctxPtrs[i] = &contexts[i];
+        data[i] = regions.data() + i * kMessage;
+    }
+    runCase("sha256_multi_update/64x4K", kRegions * kMessage, [&]() {
+        for (auto& ctx : contexts) {
+            SHA256_Init(&ctx);
+        }
+        SHA256_MultiUpdate(ctxPtrs.data(), data.data(), lengths.data(), kRegions);
+    });
+}
+
+void scanCase(MemoryMonitor& monitor, const std::string& label, const std::string& region, size_t bytes) {
+    if (!monitor.protectMemoryRegion(region)) {
+        fprintf(stderr, "Skipping %s: failed to protect %s\n", label.c_str(), region.c_str());
+        return;
+    }
+
+    runCase("scan_region/" + label, bytes, [&]() { monitor.scanMemoryRegion(region); });
+
+    RegionId id = monitor.getRegionId(region);
+    runCase("scan_region_by_id/" + label, bytes, [&]() { monitor.scanMemoryRegion(id); });
+
+    monitor.unprotectMemoryRegion(region);
+}
+
+void benchScanRegion() {
+    MemoryMonitor monitor;
+    monitor.startMonitoring();
+
+    // Named regions that are not paths get a 4 KiB anonymous mapping.
+    scanCase(monitor, "anon/4K", "bench_anon", 4096);
+
+    ScanPolicy policy = monitor.getScanPolicy();
+    policy.fast_hash_memory = true;
+    monitor.setScanPolicy(policy);
+    scanCase(monitor, "anon_fast_tier/4K", "bench_anon_fast", 4096);
+    policy.fast_hash_memory = false;
+    monitor.setScanPolicy(policy);
+
+    static const size_t kFileSizes[] = {4096, 1u << 20, 16u << 20};
+    for (size_t size : kFileSizes) {
+        if (size > g_options.max_size) {
+            continue;
+        }
+        std::string path = createTestFile(size);
+        if (path.empty()) {
+            continue;
+        }
+        scanCase(monitor, "file/" + formatSize(size), path, size);
+        unlink(path.c_str());
+    }
+
+    // Proc files are streamed, so their cost is dominated by the kernel
+    // generating the text rather than by hashing.
+    scanCase(monitor, "proc/self_cmdline", "/proc/self/cmdline", 0);
+    scanCase(monitor, "proc/self_status", "/proc/self/status", 0);
+    scanCase(monitor, "proc/self_maps", "/proc/self/maps", 0);
+}
+
+void benchScanAll() {
+    static const size_t kRegionCounts[] = {1, 10, 100, 1000};
+    for (size_t count : kRegionCounts) {
+        MemoryMonitor monitor;
+        monitor.startMonitoring();
+
+        std::vector<std::string> names;
+        for (size_t i = 0; i < count; i++) {
+            names.push_back("bench_region_" + std::to_string(i));
+        }
+        std::vector<RegionId> ids;
+        monitor.protectMemoryRegions(names, false, ids);
+
+        runCase("scan_all/" + std::to_string(count), count * 4096, [&]() { monitor.scanAllProtectedRegions(); });
+
+        std::vector<RegionScanResult> results;
+        runCase("scan_batch/" + std::to_string(count), count * 4096, [&]() { monitor.scanMemoryRegions(ids, results); });
+    }
+}
+
+#ifdef APP_PROTECTION_BENCH_JNI
+// A real JNI round trip needs a running VM, so this measures the native half
+// of the entry points that do not touch JNIEnv: handle lookup, logging and the
+// call itself. Compare with scan_region_by_id/anon/4K to see the overhead; the
+// VM transition has to be measured from managed code with System.nanoTime().
+void benchJniEntries() {
+    jlong handle = Java_com_appprotection_sdk_internal_MemoryMonitor_nativeCreate(nullptr, nullptr);
+    Java_com_appprotection_sdk_internal_MemoryMonitor_nativeStartMonitoring(nullptr, nullptr, handle);
+
+    MemoryMonitor* monitor = reinterpret_cast<MemoryMonitor*>(handle);
+    monitor->protectMemoryRegion("bench_jni");
+    jint id = monitor->getRegionId("bench_jni");
+
+    runCase("jni_native/is_monitoring", 0, [&]() {
+        Java_com_appprotection_sdk_internal_MemoryMonitor_nativeIsMonitoring(nullptr, nullptr, handle);
+    });
+    runCase("jni_native/scan_region_by_id", 4096, [&]() {
+        Java_com_appprotection_sdk_internal_MemoryMonitor_nativeScanMemoryRegionById(nullptr, nullptr, handle, id);
+    });
+
+    Java_com_appprotection_sdk_internal_MemoryMonitor_nativeDestroy(nullptr, nullptr, handle);
+}
+#endif
+
+bool parseOptions(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--filter=") == 0) {
+            g_options.filter = arg.substr(9);
+        } else if (arg.compare(0, 14, "--min-time-ms=") == 0) {
+            g_options.min_time_ns = strtoull(arg.c_str() + 14, nullptr, 10) * 1000000ULL;
+        } else if (arg.compare(0, 11, "--max-size=") == 0) {
+            g_options.max_size = strtoull(arg.c_str() + 11, nullptr, 10);
+        } else if (arg.compare(0, 9, "--tmpdir=") == 0) {
+            g_options.tmpdir = arg.substr(9);
+        } else if (arg == "--csv") {
+            g_options.csv = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (g_options.max_size < 64) {
+        g_options.max_size = 64;
+    }
+    if (g_options.tmpdir.empty()) {
+        g_options.tmpdir = defaultTmpdir();
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (!parseOptions(argc, argv)) {
+        fprintf(stderr, "Usage: %s [--filter=<substring>] [--min-time-ms=<ms>] "
+                        "[--max-size=<bytes>] [--tmpdir=<dir>] [--csv]\n", argv[0]);
+        return 2;
+    }
+
+    if (g_options.csv) {
+        printf("name,iterations,ns_per_op,mb_per_s\n");
+    } else {
+        printf("sha256 backend: %s, multi-buffer lanes: %zu\n", sha256_backend_name(), sha256_multi_lanes());
+        printf("%-40s %12s %17s %15s\n", "case", "iterations", "time/op", "throughput");
+    }
+
+    benchSha256();
+    benchSha256Kernels();
+    benchScanRegion();
+    benchScanAll();
+#ifdef APP_PROTECTION_BENCH_JNI
+    benchJniEntries();
+#endif
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "byte_compare.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const size_t kBlockSize = 64;
+
+#if defined(__ARM_NEON)
+static bool blockEqual(const uint8_t* a, const uint8_t* b) {
+    uint8x16_t eq = vandq_u8(vandq_u8(vceqq_u8(vld1q_u8(a), vld1q_u8(b)),
+                                      vceqq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16))),
+                             vandq_u8(vceqq_u8(vld1q_u8(a + 32), vld1q_u8(b + 32)),
+                                      vceqq_u8(vld1q_u8(a + 48), vld1q_u8(b + 48))));
+#if defined(__aarch64__)
+    return vminvq_u8(eq) == 0xFF;
+#else
+    uint8x8_t min = vmin_u8(vget_low_u8(eq), vget_high_u8(eq));
+    min = vpmin_u8(min, min);
+    min = vpmin_u8(min, min);
+    min = vpmin_u8(min, min);
+    return vget_lane_u8(min, 0) == 0xFF;
+#endif
+}
+#elif defined(__SSE2__)
+static bool blockEqual(const uint8_t* a, const uint8_t* b) {
+    const __m128i* va = reinterpret_cast<const __m128i*>(a);
+    const __m128i* vb = reinterpret_cast<const __m128i*>(b);
+    __m128i eq = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(va), _mm_loadu_si128(vb)),
+                                             _mm_cmpeq_epi8(_mm_loadu_si128(va + 1), _mm_loadu_si128(vb + 1))),
+                               _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(va + 2), _mm_loadu_si128(vb + 2)),
+                                             _mm_cmpeq_epi8(_mm_loadu_si128(va + 3), _mm_loadu_si128(vb + 3))));
+    return _mm_movemask_epi8(eq) == 0xFFFF;
+}
+#else
+static bool blockEqual(const uint8_t* a, const uint8_t* b) {
+    uint64_t diff = 0;
+    for (size_t i = 0; i < kBlockSize; i += sizeof(uint64_t)) {
+        uint64_t x, y;
+        __builtin_memcpy(&x, a + i, sizeof(x));
+        __builtin_memcpy(&y, b + i, sizeof(y));
+        diff |= x ^ y;
+    }
+    return diff == 0;
+}
+#endif
+
+size_t findFirstDifference(const uint8_t* a, const uint8_t* b, size_t size) {
+    size_t offset = 0;
+    while (offset + kBlockSize <= size && blockEqual(a + offset, b + offset)) {
+        offset += kBlockSize;
+    }
+    // The differing block, or the tail, is narrowed down byte by byte.
+    while (offset < size && a[offset] == b[offset]) {
+        offset++;
+    }
+    return offset;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_BYTE_COMPARE_H
+#define APP_PROTECTION_BYTE_COMPARE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Offset of the first byte at which `a` and `b` differ, or `size` if the
+ * two ranges are equal. Compares 64 bytes per step with NEON or SSE2 where
+ * available; unlike memcmp it reports where the ranges diverge.
+ */
+size_t findFirstDifference(const uint8_t* a, const uint8_t* b, size_t size);
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "code_segment.h"
+#include <cstring>
+#include <elf.h>
+#include <link.h>
+#include <unistd.h>
+
+namespace {
+
+struct SegmentSearch {
+    const std::string* library;
+    CodeSegment* segment;
+    size_t page_size;
+    bool found;
+};
+
+bool pathMatches(const char* path, const std::string& library) {
+    size_t length = strlen(path);
+    if (length < library.size() || path[length - library.size()] != library[0] ||
+        strcmp(path + length - library.size(), library.c_str()) != 0) {
+        return false;
+    }
+    return length == library.size() || path[length - library.size() - 1] == '/';
+}
+
+int findSegmentCallback(struct dl_phdr_info* info, size_t, void* data) {
+    SegmentSearch* search = static_cast<SegmentSearch*>(data);
+    if (!info->dlpi_name || !pathMatches(info->dlpi_name, *search->library)) {
+        return 0;
+    }
+
+    CodeSegment& segment = *search->segment;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type != PT_LOAD || !(phdr.p_flags & PF_X) || phdr.p_memsz == 0) {
+            continue;
+        }
+        // Execute-only text cannot be read back, so it cannot be hashed.
+        if (!(phdr.p_flags & PF_R)) {
+            continue;
+        }
+        if (search->found) {
+            segment.other_segments++;
+            continue;
+        }
+
+        uintptr_t pageMask = ~(static_cast<uintptr_t>(search->page_size) - 1);
+        uintptr_t start = (info->dlpi_addr + phdr.p_vaddr) & pageMask;
+        uintptr_t end = (info->dlpi_addr + phdr.p_vaddr + phdr.p_memsz + search->page_size - 1) & pageMask;
+        segment.address = reinterpret_cast<void*>(start);
+        segment.size = end - start;
+        segment.path = info->dlpi_name;
+        search->found = true;
+    }
+    // Stop at the first object with the name.
+    return 1;
+}
+
+} // namespace
+
+bool isCodeRegion(const std::string& region) {
+    return region.compare(0, sizeof(kCodeRegionPrefix) - 1, kCodeRegionPrefix) == 0;
+}
+
+bool findCodeSegment(const std::string& library, CodeSegment& segment) {
+    if (library.empty()) {
+        return false;
+    }
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    segment = CodeSegment();
+    SegmentSearch search = {&library, &segment, pageSize > 0 ? static_cast<size_t>(pageSize) : 4096, false};
+    dl_iterate_phdr(findSegmentCallback, &search);
+    return search.found;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_CODE_SEGMENT_H
+#define APP_PROTECTION_CODE_SEGMENT_H
+
+#include <stddef.h>
+#include <string>
+
+// Region names of the form "elf:<library>" protect the in-memory text of a
+// library already loaded into the process.
+static const char kCodeRegionPrefix[] = "elf:";
+
+bool isCodeRegion(const std::string& region);
+
+/**
+ * Executable text of a loaded ELF object, rounded out to whole pages.
+ */
+struct CodeSegment {
+    void* address = nullptr;
+    size_t size = 0;
+    // Path the loader reports for the object.
+    std::string path;
+    // Executable PT_LOAD segments besides the one found.
+    size_t other_segments = 0;
+};
+
+// Finds, through dl_iterate_phdr, the first readable and executable PT_LOAD
+// segment of the loaded object whose path is `library` or ends in
+// "/<library>". No file is opened: the text is taken as the loader mapped
+// and relocated it.
+bool findCodeSegment(const std::string& library, CodeSegment& segment);
+
+#endif
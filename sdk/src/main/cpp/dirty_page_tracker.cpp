@@ -0,0 +1,207 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dirty_page_tracker.h"
+#include "log.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define TAG "DirtyPageTracker"
+
+static const uint64_t kPagemapSoftDirty = 1ULL << 55;
+
+// Value written to clear_refs to clear the soft-dirty bits of all pages.
+static const char kClearSoftDirty[] = "4";
+
+enum {
+    SUPPORT_UNKNOWN = -1,
+    SUPPORT_NO = 0,
+    SUPPORT_YES = 1
+};
+
+DirtyPageTracker& DirtyPageTracker::instance() {
+    static DirtyPageTracker tracker;
+    return tracker;
+}
+
+DirtyPageTracker::DirtyPageTracker() : support_(SUPPORT_UNKNOWN) {
+    long pageSize = sysconf(_SC_PAGESIZE);
+    page_size_ = pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+}
+
+bool DirtyPageTracker::isSupported() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (support_ == SUPPORT_UNKNOWN) {
+        support_ = probe() ? SUPPORT_YES : SUPPORT_NO;
+        LOGI("Soft-dirty page tracking %s",
+                            support_ == SUPPORT_YES ? "available" : "unavailable");
+    }
+    return support_ == SUPPORT_YES;
+}
+
+bool DirtyPageTracker::probe() {
+    void* page = mmap(nullptr, page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED) {
+        return false;
+    }
+
+    std::vector<uint8_t> dirty;
+    volatile uint8_t* bytes = static_cast<volatile uint8_t*>(page);
+    bytes[0] = 1;
+
+    // A written page must read back clean after a clear and dirty again
+    // after the next write; kernels without CONFIG_MEM_SOFT_DIRTY fail one
+    // of the two checks.
+    bool supported = clearSoftDirty() &&
+                     readPagemap(page, 1, dirty) && dirty[0] == 0;
+    if (supported) {
+        bytes[0] = 2;
+        supported = readPagemap(page, 1, dirty) && dirty[0] != 0;
+    }
+
+    munmap(page, page_size_);
+    return supported;
+}
+
+bool DirtyPageTracker::clearSoftDirty() {
+    int fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+    ssize_t written = write(fd, kClearSoftDirty, sizeof(kClearSoftDirty) - 1);
+    close(fd);
+    return written == static_cast<ssize_t>(sizeof(kClearSoftDirty) - 1);
+}
+
+bool DirtyPageTracker::readPagemap(void* address, size_t pages, std::vector<uint8_t>& dirty) {
+    int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+
+    // Read through a fixed block so periodic scans do not allocate.
+    uint64_t entries[512];
+    off_t offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(address) / page_size_ * sizeof(uint64_t));
+    dirty.resize(pages);
+    size_t page = 0;
+    while (page < pages) {
+        size_t count = std::min(pages - page, sizeof(entries) / sizeof(entries[0]));
+        size_t wanted = count * sizeof(uint64_t);
+        size_t done = 0;
+        while (done < wanted) {
+            ssize_t n = pread(fd, reinterpret_cast<uint8_t*>(entries) + done, wanted - done,
+                              offset + static_cast<off_t>(page * sizeof(uint64_t) + done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+        if (done != wanted) {
+            close(fd);
+            return false;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dirty[page + i] = (entries[i] & kPagemapSoftDirty) ? 1 : 0;
+        }
+        page += count;
+    }
+    close(fd);
+    return true;
+}
+
+void DirtyPageTracker::registerRange(void* address, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Range range;
+    range.size = size;
+    range.sticky_dirty.assign((size + page_size_ - 1) / page_size_, 0);
+    ranges_[reinterpret_cast<uintptr_t>(address)] = range;
+}
+
+void DirtyPageTracker::unregisterRange(void* address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ranges_.erase(reinterpret_cast<uintptr_t>(address));
+}
+
+bool DirtyPageTracker::resetBaseline(void* address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<uint8_t> dirty;
+    for (auto& entry : ranges_) {
+        if (entry.first == reinterpret_cast<uintptr_t>(address)) {
+            continue;
+        }
+        Range& range = entry.second;
+        if (!readPagemap(reinterpret_cast<void*>(entry.first), range.sticky_dirty.size(), dirty)) {
+            // Without the current state we cannot safely clear it.
+            return false;
+        }
+        for (size_t i = 0; i < dirty.size(); i++) {
+            range.sticky_dirty[i] |= dirty[i];
+        }
+    }
+
+    if (!clearSoftDirty()) {
+        LOGW("Failed to clear soft-dirty bits: %s", strerror(errno));
+        return false;
+    }
+
+    auto it = ranges_.find(reinterpret_cast<uintptr_t>(address));
+    if (it != ranges_.end()) {
+        std::fill(it->second.sticky_dirty.begin(), it->second.sticky_dirty.end(), 0);
+    }
+    return true;
+}
+
+bool DirtyPageTracker::collectDirtyPages(void* address, std::vector<uint8_t>& dirty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = ranges_.find(reinterpret_cast<uintptr_t>(address));
+    if (it == ranges_.end()) {
+        return false;
+    }
+
+    const Range& range = it->second;
+    if (!readPagemap(address, range.sticky_dirty.size(), dirty)) {
+        return false;
+    }
+    for (size_t i = 0; i < dirty.size(); i++) {
+        dirty[i] |= range.sticky_dirty[i];
+    }
+    return true;
+}
+
+void DirtyPageTracker::markVerified(void* address, const std::vector<uint8_t>& verified) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = ranges_.find(reinterpret_cast<uintptr_t>(address));
+    if (it == ranges_.end()) {
+        return;
+    }
+    Range& range = it->second;
+    for (size_t i = 0; i < verified.size() && i < range.sticky_dirty.size(); i++) {
+        if (verified[i]) {
+            range.sticky_dirty[i] = 0;
+        }
+    }
+}
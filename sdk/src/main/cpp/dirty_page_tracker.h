@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_DIRTY_PAGE_TRACKER_H
+#define APP_PROTECTION_DIRTY_PAGE_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * Tracks writes to anonymous protected regions through the kernel's
+ * soft-dirty bits (/proc/self/clear_refs + /proc/self/pagemap), so a scan
+ * only has to rehash pages written since the baseline was captured.
+ *
+ * Clearing soft-dirty bits is process-wide. Before every clear the tracker
+ * folds the current dirty state of all registered ranges into a sticky
+ * per-range bitmap, so a write to one region is never lost because another
+ * region was (re)baselined. Sticky bits are only dropped once a scan has
+ * verified the page against its baseline digest.
+ */
+class DirtyPageTracker {
+public:
+    static DirtyPageTracker& instance();
+
+    // True when the kernel exposes working soft-dirty tracking to this process.
+    bool isSupported();
+
+    void registerRange(void* address, size_t size);
+    void unregisterRange(void* address);
+
+    // Marks the pages of a freshly baselined range clean, preserving the
+    // dirty state of every other registered range.
+    bool resetBaseline(void* address);
+
+    // Fills `dirty` with one byte per page of the range, non-zero for pages
+    // written since the last baseline. Returns false if the kernel state
+    // could not be read, in which case the caller must rehash everything.
+    bool collectDirtyPages(void* address, std::vector<uint8_t>& dirty);
+
+    // Drops sticky dirty bits for pages a scan has verified.
+    void markVerified(void* address, const std::vector<uint8_t>& verified);
+
+    size_t pageSize() const { return page_size_; }
+
+private:
+    DirtyPageTracker();
+
+    struct Range {
+        size_t size;
+        std::vector<uint8_t> sticky_dirty;
+    };
+
+    bool probe();
+    bool clearSoftDirty();
+    bool readPagemap(void* address, size_t pages, std::vector<uint8_t>& dirty);
+
+    std::mutex mutex_;
+    std::map<uintptr_t, Range> ranges_;
+    size_t page_size_;
+    int support_;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "environment_check.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "log.h"
+#include "proc_parser.h"
+
+#define TAG "EnvironmentCheck"
+
+namespace {
+
+// Default ports of the IDA and gdb remote debug servers.
+const unsigned kDebuggerPorts[] = {23946, 23947, 23948};
+
+// Sorted so entries sharing a parent directory are adjacent.
+const char* const kRootPaths[] = {
+    "/data/local/bin/su",
+    "/data/local/su",
+    "/data/local/xbin/su",
+    "/sbin/su",
+    "/system/app/Superuser.apk",
+    "/system/bin/failsafe/su",
+    "/system/bin/su",
+    "/system/sd/xbin/su",
+    "/system/xbin/su"
+};
+
+const size_t kMaxDirLength = 256;
+
+void onStatusField(const ProcField& field, void* context) {
+    if (field.type == PROC_FIELD_TRACER_PID && field.tracer_pid > 0) {
+        *static_cast<uint32_t*>(context) |= ENV_TRACER_ATTACHED;
+    }
+}
+
+void onTcpField(const ProcField& field, void* context) {
+    for (unsigned port : kDebuggerPorts) {
+        if (field.port == port) {
+            *static_cast<uint32_t*>(context) |= ENV_DEBUGGER_PORT;
+        }
+    }
+}
+
+// Probes `name` relative to `dir`, opening the directory only when it differs
+// from the previous probe. A missing directory answers for all of its entries.
+class DirectoryProbe {
+public:
+    DirectoryProbe() : fd_(-1), dir_length_(0), open_failed_(false) { dir_[0] = '\0'; }
+    ~DirectoryProbe() {
+        if (fd_ != -1) {
+            close(fd_);
+        }
+    }
+
+    bool exists(const char* dir, size_t dirLength, const char* name, int mode) {
+        if (dirLength == 0 || dirLength >= kMaxDirLength) {
+            return false;
+        }
+        if (dirLength != dir_length_ || memcmp(dir, dir_, dirLength) != 0) {
+            if (fd_ != -1) {
+                close(fd_);
+            }
+            memcpy(dir_, dir, dirLength);
+            dir_[dirLength] = '\0';
+            dir_length_ = dirLength;
+            fd_ = open(dir_, O_PATH | O_DIRECTORY | O_CLOEXEC);
+            open_failed_ = fd_ == -1;
+        }
+        return !open_failed_ && faccessat(fd_, name, mode, 0) == 0;
+    }
+
+private:
+    int fd_;
+    char dir_[kMaxDirLength];
+    size_t dir_length_;
+    bool open_failed_;
+};
+
+bool anyRootPathExists() {
+    DirectoryProbe probe;
+    for (const char* path : kRootPaths) {
+        const char* slash = strrchr(path, '/');
+        if (probe.exists(path, (size_t)(slash - path), slash + 1, F_OK)) {
+            LOGD("Root path present: %s", path);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool suOnPath() {
+    const char* path = getenv("PATH");
+    if (!path) {
+        return false;
+    }
+
+    DirectoryProbe probe;
+    while (*path) {
+        const char* end = strchr(path, ':');
+        size_t length = end ? (size_t)(end - path) : strlen(path);
+        if (probe.exists(path, length, "su", X_OK)) {
+            LOGD("su found on PATH");
+            return true;
+        }
+        if (!end) {
+            break;
+        }
+        path = end + 1;
+    }
+    return false;
+}
+
+} // namespace
+
+uint32_t checkEnvironment() {
+    uint32_t flags = 0;
+
+    parseProcFile("/proc/self/status", PROC_FILE_STATUS, onStatusField, &flags);
+    parseProcFile("/proc/net/tcp", PROC_FILE_TCP, onTcpField, &flags);
+    parseProcFile("/proc/net/tcp6", PROC_FILE_TCP, onTcpField, &flags);
+
+    if (anyRootPathExists()) {
+        flags |= ENV_ROOT_PATH;
+    }
+    if (suOnPath()) {
+        flags |= ENV_SU_ON_PATH;
+    }
+
+    LOGD("Environment check result: 0x%x", flags);
+    return flags;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_ENVIRONMENT_CHECK_H
+#define APP_PROTECTION_ENVIRONMENT_CHECK_H
+
+#include <stdint.h>
+
+// Bits of the checkEnvironment() result. Mirrored in EnvironmentCheck.kt.
+enum EnvironmentFlag {
+    ENV_TRACER_ATTACHED = 1 << 0,
+    ENV_DEBUGGER_PORT = 1 << 1,
+    ENV_ROOT_PATH = 1 << 2,
+    ENV_SU_ON_PATH = 1 << 3
+};
+
+/**
+ * Runs the debugger and root checks in one native pass: /proc/self/status
+ * and /proc/net/tcp{,6} are each read once through the proc parser, known
+ * su locations are probed with faccessat() against one directory fd per
+ * parent, and the su lookup walks $PATH instead of spawning a process.
+ * Returns a mask of EnvironmentFlag bits.
+ */
+uint32_t checkEnvironment();
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_FAST_HASH_H
+#define APP_PROTECTION_FAST_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Non-cryptographic 64-bit hash (XXH64) used as a cheap first tier for
+ * routine scans of in-process memory. It runs several times faster than
+ * SHA-256 but gives no pre-image resistance, so a mismatch -- or a periodic
+ * full check -- always escalates to the SHA-256 baseline.
+ */
+
+uint64_t fastHash64(const void* data, size_t size, uint64_t seed);
+
+// Random per-process seed, so the fast baselines of a build cannot be
+// computed ahead of time to craft a matching modification.
+uint64_t fastHashSeed();
+
+#endif
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_watcher.h"
+#include "log.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define TAG "FileWatcher"
+
+static const uint32_t kWatchMask = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+
+// How long to keep collecting events after the first one of a burst.
+static const int kSettleMs = 20;
+
+FileWatcher::FileWatcher()
+    : inotify_fd_(-1), wake_fd_(-1), generation_(0), running_(false) {
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+    if (worker_.joinable() || retired_.joinable()) {
+        // Destroyed from inside the handler, which run() returns to afterwards.
+        LOGE("File watcher destroyed from its own worker thread");
+        abort();
+    }
+}
+
+bool FileWatcher::start(Handler handler) {
+    if (!handler) {
+        return false;
+    }
+
+    stop();
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        LOGE("inotify_init1 failed: %s", strerror(errno));
+        return false;
+    }
+
+    int wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (wakeFd < 0 || epollFd < 0) {
+        LOGE("Failed to set up epoll: %s", strerror(errno));
+        close(inotifyFd);
+        if (wakeFd >= 0) close(wakeFd);
+        if (epollFd >= 0) close(epollFd);
+        return false;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = inotifyFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, inotifyFd, &ev);
+    ev.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker_.joinable()) {
+        // Restarted from inside the handler: this thread is the old worker,
+        // which exits after the handler now that its generation is out of date.
+        retired_ = std::move(worker_);
+    }
+    handler_ = handler;
+    inotify_fd_ = inotifyFd;
+    wake_fd_ = wakeFd;
+    paths_.clear();
+    watches_.clear();
+    running_ = true;
+    worker_ = std::thread(&FileWatcher::run, this, ++generation_, inotifyFd, epollFd, wakeFd);
+
+    LOGI("File watcher started");
+    return true;
+}
+
+void FileWatcher::stop() {
+    bool wasRunning;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wasRunning = running_;
+        if (running_) {
+            running_ = false;
+
+            uint64_t one = 1;
+            if (write(wake_fd_, &one, sizeof(one)) < 0) {
+                LOGW("Failed to wake watcher thread: %s", strerror(errno));
+            }
+            // The worker owns and closes the descriptors.
+            inotify_fd_ = -1;
+            wake_fd_ = -1;
+            paths_.clear();
+            watches_.clear();
+        }
+    }
+
+    // Stopped from inside the handler, the loop exits on its own; that
+    // thread is joined by a later start() or stop() from another thread.
+    std::thread::id self = std::this_thread::get_id();
+    if (worker_.joinable() && worker_.get_id() != self) {
+        worker_.join();
+    }
+    if (retired_.joinable() && retired_.get_id() != self) {
+        retired_.join();
+    }
+
+    if (wasRunning) {
+        LOGI("File watcher stopped");
+    }
+}
+
+bool FileWatcher::isWorkerThread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::thread::id self = std::this_thread::get_id();
+    return worker_.get_id() == self || retired_.get_id() == self;
+}
+
+bool FileWatcher::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+bool FileWatcher::addWatch(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return false;
+    }
+    if (watches_.count(path)) {
+        return true;
+    }
+
+    int wd = inotify_add_watch(inotify_fd_, path.c_str(), kWatchMask);
+    if (wd < 0) {
+        LOGW("Cannot watch %s: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    paths_[wd] = path;
+    watches_[path] = wd;
+    return true;
+}
+
+void FileWatcher::removeWatch(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = watches_.find(path);
+    if (it == watches_.end()) {
+        return;
+    }
+
+    inotify_rm_watch(inotify_fd_, it->second);
+    paths_.erase(it->second);
+    watches_.erase(it);
+}
+
+// Reads all pending events, recording changed paths (true when the watch was
+// lost). Returns false once the inotify queue is empty.
+bool FileWatcher::drainEvents(int inotifyFd, std::map<std::string, bool>& changed) {
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t n = read(inotifyFd, buffer, sizeof(buffer));
+    if (n <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (char* p = buffer; p < buffer + n; ) {
+        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+        p += sizeof(struct inotify_event) + event->len;
+
+        auto it = paths_.find(event->wd);
+        if (it == paths_.end()) {
+            continue;
+        }
+
+        bool lost = (event->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) != 0;
+        changed[it->second] = changed[it->second] || lost;
+        if (event->mask & IN_IGNORED) {
+            watches_.erase(it->second);
+            paths_.erase(it);
+        }
+    }
+    return true;
+}
+
+void FileWatcher::run(uint64_t generation, int inotifyFd, int epollFd, int wakeFd) {
+    for (;;) {
+        struct epoll_event events[2];
+        int ready = epoll_wait(epollFd, events, 2, -1);
+        if (ready < 0 && errno != EINTR) {
+            LOGE("epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+
+        std::map<std::string, bool> changed;
+        while (drainEvents(inotifyFd, changed)) {
+        }
+        if (!changed.empty()) {
+            struct epoll_event settle;
+            while (epoll_wait(epollFd, &settle, 1, kSettleMs) > 0 && drainEvents(inotifyFd, changed)) {
+            }
+        }
+
+        Handler handler;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_ || generation_ != generation) {
+                break;
+            }
+            handler = handler_;
+        }
+
+        for (const auto& entry : changed) {
+            handler(entry.first);
+
+            // A replaced or deleted file loses its watch; follow whatever
+            // now lives at the path.
+            if (entry.second) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = watches_.find(entry.first);
+                    if (it != watches_.end()) {
+                        inotify_rm_watch(inotifyFd, it->second);
+                        paths_.erase(it->second);
+                        watches_.erase(it);
+                    }
+                }
+                addWatch(entry.first);
+            }
+        }
+    }
+
+    close(epollFd);
+    close(wakeFd);
+    close(inotifyFd);
+}
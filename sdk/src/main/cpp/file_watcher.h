@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_FILE_WATCHER_H
+#define APP_PROTECTION_FILE_WATCHER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Watches files through inotify and reports changes from a native epoll
+ * thread, so a modified file can be rescanned right away instead of when
+ * the polling scheduler next gets to it. The thread sleeps in epoll_wait
+ * while nothing happens.
+ *
+ * Events arriving within a short settle window are coalesced, so a burst
+ * of writes to one file triggers a single callback. A watched file that is
+ * deleted or replaced by rename is reported and then re-watched at its
+ * path if a file exists there again.
+ */
+class FileWatcher {
+public:
+    typedef std::function<void(const std::string& path)> Handler;
+
+    FileWatcher();
+    ~FileWatcher();
+
+    bool start(Handler handler);
+    // From inside the handler it only signals; the watcher must then not be
+    // destroyed on that thread.
+    void stop();
+    bool isRunning() const;
+    bool isWorkerThread() const;
+
+    bool addWatch(const std::string& path);
+    void removeWatch(const std::string& path);
+
+private:
+    void run(uint64_t generation, int inotifyFd, int epollFd, int wakeFd);
+    bool drainEvents(int inotifyFd, std::map<std::string, bool>& changed);
+
+    mutable std::mutex mutex_;
+    std::thread worker_;
+    // A worker replaced by start() from inside its own handler, joined later.
+    std::thread retired_;
+    Handler handler_;
+    std::map<int, std::string> paths_;
+    std::map<std::string, int> watches_;
+    int inotify_fd_;
+    int wake_fd_;
+    uint64_t generation_;
+    bool running_;
+};
+
+#endif
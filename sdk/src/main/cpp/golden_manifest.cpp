@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "golden_manifest.h"
+#include <string.h>
+#include <algorithm>
+#include "code_segment.h"
+#include "log.h"
+#include "merkle_tree.h"
+
+#define TAG "GoldenManifest"
+
+#ifdef APP_PROTECTION_MANIFEST_PATH
+// The manifest file is assembled into its own allocated, non-writable
+// section, so the loader maps it read-only along with the library's rodata.
+__asm__(
+    "  .pushsection .app_protection_manifest, \"a\"\n"
+    "  .balign 8\n"
+    "  .globl app_protection_manifest_begin\n"
+    "  .hidden app_protection_manifest_begin\n"
+    "app_protection_manifest_begin:\n"
+    "  .incbin \"" APP_PROTECTION_MANIFEST_PATH "\"\n"
+    "  .globl app_protection_manifest_end\n"
+    "  .hidden app_protection_manifest_end\n"
+    "app_protection_manifest_end:\n"
+    "  .popsection\n");
+
+extern "C" __attribute__((visibility("hidden"))) const uint8_t app_protection_manifest_begin[];
+extern "C" __attribute__((visibility("hidden"))) const uint8_t app_protection_manifest_end[];
+#endif
+
+GoldenManifest::GoldenManifest() : entries_(nullptr), digests_(nullptr), names_(nullptr), count_(0) {
+}
+
+GoldenManifest::GoldenManifest(const uint8_t* data, size_t size)
+    : entries_(nullptr), digests_(nullptr), names_(nullptr), count_(0) {
+    if (!data || size < sizeof(ManifestHeader) || reinterpret_cast<uintptr_t>(data) % alignof(ManifestEntry) != 0) {
+        return;
+    }
+    const ManifestHeader& header = *reinterpret_cast<const ManifestHeader*>(data);
+    if (header.magic != kManifestMagic || header.version != kManifestVersion) {
+        LOGE("Unsupported golden manifest (magic %08x, version %u)", header.magic, header.version);
+        return;
+    }
+
+    uint64_t digestsOffset = sizeof(ManifestHeader) + static_cast<uint64_t>(header.entry_count) * sizeof(ManifestEntry);
+    uint64_t digestsEnd = digestsOffset + static_cast<uint64_t>(header.digest_count) * SHA256_DIGEST_LENGTH;
+    if (digestsEnd > header.names_offset ||
+        static_cast<uint64_t>(header.names_offset) + header.names_size > size) {
+        LOGE("Golden manifest is truncated");
+        return;
+    }
+
+    const ManifestEntry* entries = reinterpret_cast<const ManifestEntry*>(data + sizeof(ManifestHeader));
+    for (uint32_t i = 0; i < header.entry_count; i++) {
+        const ManifestEntry& entry = entries[i];
+        uint64_t expected = entry.chunk_size > 0 ? merkleChunkCount(entry.size, entry.chunk_size) : 0;
+        if (static_cast<uint64_t>(entry.name_offset) + entry.name_length > header.names_size ||
+            static_cast<uint64_t>(entry.first_digest) + entry.digest_count > header.digest_count ||
+            entry.digest_count != expected) {
+            LOGE("Golden manifest entry %u is malformed", i);
+            return;
+        }
+    }
+
+    entries_ = entries;
+    digests_ = data + digestsOffset;
+    names_ = reinterpret_cast<const char*>(data + header.names_offset);
+    count_ = header.entry_count;
+}
+
+const GoldenManifest& GoldenManifest::embedded() {
+#ifdef APP_PROTECTION_MANIFEST_PATH
+    static const GoldenManifest manifest(app_protection_manifest_begin,
+                                         static_cast<size_t>(app_protection_manifest_end - app_protection_manifest_begin));
+#else
+    static const GoldenManifest manifest;
+#endif
+    return manifest;
+}
+
+int GoldenManifest::compareName(const ManifestEntry& entry, const std::string& name) const {
+    size_t common = std::min<size_t>(entry.name_length, name.size());
+    int order = memcmp(names_ + entry.name_offset, name.data(), common);
+    if (order != 0) {
+        return order;
+    }
+    return entry.name_length < name.size() ? -1 : (entry.name_length > name.size() ? 1 : 0);
+}
+
+const ManifestEntry* GoldenManifest::find(const std::string& name) const {
+    size_t low = 0;
+    size_t high = count_;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = compareName(entries_[middle], name);
+        if (order == 0) {
+            return &entries_[middle];
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* GoldenManifest::digests(const ManifestEntry& entry) const {
+    return digests_ + static_cast<size_t>(entry.first_digest) * SHA256_DIGEST_LENGTH;
+}
+
+std::string manifestNameOf(const std::string& region) {
+    if (isCodeRegion(region)) {
+        return region;
+    }
+    size_t slash = region.rfind('/');
+    return slash == std::string::npos ? region : region.substr(slash + 1);
+}
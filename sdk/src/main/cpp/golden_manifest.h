@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_GOLDEN_MANIFEST_H
+#define APP_PROTECTION_GOLDEN_MANIFEST_H
+
+#include <openssl/sha.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Golden manifest: digests of shipped libraries and files computed at build
+ * time by tools/golden_manifest_tool.cpp, so regions can be protected
+ * against known-good contents instead of whatever is on disk at first use.
+ * The manifest is embedded read-only in the library and read in place;
+ * nothing is decoded or copied to look an entry up.
+ *
+ * Layout, little-endian, offsets from the start of the manifest:
+ *
+ *   ManifestHeader
+ *   ManifestEntry[entry_count]         sorted bytewise by name
+ *   uint8_t[digest_count][32]          chunk digests, entry after entry
+ *   char[names_size]                   entry names, not NUL-terminated
+ */
+static const uint32_t kManifestMagic = 0x4e4d5041; // "APMN"
+static const uint32_t kManifestVersion = 1;
+
+struct ManifestHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t digest_count;
+    uint32_t names_offset;
+    uint32_t names_size;
+};
+
+struct ManifestEntry {
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint64_t size;
+    // 0 when `root` is the plain SHA-256 of the contents; otherwise the
+    // chunk digests are folded into `root` as a Merkle tree.
+    uint32_t chunk_size;
+    uint32_t first_digest;
+    uint32_t digest_count;
+    uint32_t reserved;
+    uint8_t root[SHA256_DIGEST_LENGTH];
+};
+
+static_assert(sizeof(ManifestHeader) == 24, "manifest header layout");
+static_assert(sizeof(ManifestEntry) == 64, "manifest entry layout");
+
+/**
+ * Read-only view of a manifest. The bounds of every entry are checked once
+ * when the view is created; a manifest that fails the check reads as empty.
+ */
+class GoldenManifest {
+public:
+    GoldenManifest();
+    // `data` must stay mapped for as long as the view is used.
+    GoldenManifest(const uint8_t* data, size_t size);
+
+    // Manifest embedded at build time (APP_PROTECTION_MANIFEST), or an
+    // empty one.
+    static const GoldenManifest& embedded();
+
+    bool empty() const { return count_ == 0; }
+    size_t entryCount() const { return count_; }
+
+    // Binary search by name; nullptr if there is no such entry.
+    const ManifestEntry* find(const std::string& name) const;
+    const uint8_t* digests(const ManifestEntry& entry) const;
+
+private:
+    int compareName(const ManifestEntry& entry, const std::string& name) const;
+
+    const ManifestEntry* entries_;
+    const uint8_t* digests_;
+    const char* names_;
+    size_t count_;
+};
+
+// Manifest entry name for a region: "elf:" regions keep their name, file
+// regions use the file name without its directory.
+std::string manifestNameOf(const std::string& region);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_LOG_H
+#define APP_PROTECTION_LOG_H
+
+// Log levels, numbered like android_LogPriority.
+#define APP_LOG_LEVEL_VERBOSE 2
+#define APP_LOG_LEVEL_DEBUG   3
+#define APP_LOG_LEVEL_INFO    4
+#define APP_LOG_LEVEL_WARN    5
+#define APP_LOG_LEVEL_ERROR   6
+#define APP_LOG_LEVEL_SILENT  8
+
+// Set per build through the APP_PROTECTION_LOG_LEVEL CMake option.
+#ifndef APP_PROTECTION_LOG_MIN_LEVEL
+#define APP_PROTECTION_LOG_MIN_LEVEL APP_LOG_LEVEL_INFO
+#endif
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#define APP_LOG_WRITE(level, tag, ...) __android_log_print(level, tag, __VA_ARGS__)
+#else
+#include <stdarg.h>
+#include <stdio.h>
+
+// Host builds (tools, benchmarks) have no logd; write to stderr instead.
+static inline void __attribute__((format(printf, 3, 4)))
+appLogStderr(int level, const char* tag, const char* fmt, ...) {
+    static const char kLevels[] = "??VDIWEF";
+    va_list args;
+    va_start(args, fmt);
+    flockfile(stderr);
+    fprintf(stderr, "%c/%s: ", kLevels[level & 7], tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    funlockfile(stderr);
+    va_end(args);
+}
+#define APP_LOG_WRITE(level, tag, ...) appLogStderr(level, tag, __VA_ARGS__)
+#endif
+
+// The level test is a constant expression, so calls below the minimum
+// level are dropped by the compiler, arguments included, while still
+// being type-checked against the format string.
+#define APP_LOG(level, ...)                                  \
+    do {                                                     \
+        if ((level) >= APP_PROTECTION_LOG_MIN_LEVEL) {       \
+            APP_LOG_WRITE(level, TAG, __VA_ARGS__);          \
+        }                                                    \
+    } while (0)
+
+#define LOGV(...) APP_LOG(APP_LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#define LOGD(...) APP_LOG(APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOGI(...) APP_LOG(APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOGW(...) APP_LOG(APP_LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOGE(...) APP_LOG(APP_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif
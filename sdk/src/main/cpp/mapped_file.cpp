@@ -0,0 +1,169 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <openssl/sha.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Read size for files that cannot be mapped.
+static const size_t kStreamBufferSize = 4096;
+
+MappedFile::MappedFile() : mapping_(MAP_FAILED), data_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+bool MappedFile::map(int fd, size_t size) {
+    unmap();
+    if (size == 0) {
+        return true;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    mapping_ = mapping;
+    data_ = static_cast<const uint8_t*>(mapping);
+    size_ = size;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (mapping_ != MAP_FAILED) {
+        munmap(mapping_, size_);
+    }
+    mapping_ = MAP_FAILED;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+FileBlockReader::FileBlockReader(int fd, off_t offset, size_t size, uint8_t* buffer, size_t blockSize)
+    : fd_(fd), offset_(offset), size_(size), buffer_(buffer), block_size_(blockSize), position_(0), ended_(false),
+      syscalls_(1) {
+    posix_fadvise(fd, offset, static_cast<off_t>(size), POSIX_FADV_SEQUENTIAL);
+}
+
+ssize_t FileBlockReader::next() {
+    size_t length = std::min(block_size_, size_ - position_);
+    if (length == 0 || ended_) {
+        return 0;
+    }
+
+    size_t ahead = position_ + length;
+    if (ahead < size_) {
+        posix_fadvise(fd_, offset_ + static_cast<off_t>(ahead),
+                      static_cast<off_t>(std::min(block_size_, size_ - ahead)), POSIX_FADV_WILLNEED);
+        syscalls_++;
+    }
+
+    // pread may return less than asked for; only 0 means the file ended.
+    size_t filled = 0;
+    while (filled < length) {
+        ssize_t n = pread(fd_, buffer_ + filled, length - filled,
+                          offset_ + static_cast<off_t>(position_ + filled));
+        syscalls_++;
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        filled += static_cast<size_t>(n);
+    }
+    position_ += filled;
+    // A file that ended early is not read again.
+    ended_ = filled < length;
+    return static_cast<ssize_t>(filled);
+}
+
+FileStamp fileStampOf(const struct stat& st) {
+    FileStamp stamp;
+    stamp.dev = st.st_dev;
+    stamp.ino = st.st_ino;
+    stamp.size = st.st_size;
+    stamp.mtime = st.st_mtim;
+    stamp.ctime = st.st_ctim;
+    return stamp;
+}
+
+bool operator==(const FileStamp& a, const FileStamp& b) {
+    return a.dev == b.dev && a.ino == b.ino && a.size == b.size &&
+           a.mtime.tv_sec == b.mtime.tv_sec && a.mtime.tv_nsec == b.mtime.tv_nsec &&
+           a.ctime.tv_sec == b.ctime.tv_sec && a.ctime.tv_nsec == b.ctime.tv_nsec;
+}
+
+bool hashFileContents(int fd, const struct stat& st, uint8_t* hash, size_t* bytesHashed,
+                      uint32_t* syscalls) {
+    uint32_t calls = 0;
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        MappedFile file;
+        bool mapped = file.map(fd, static_cast<size_t>(st.st_size));
+        // mmap, plus madvise and munmap once mapped.
+        calls += mapped ? 3 : 1;
+        if (mapped) {
+            SHA256_Update(&sha256, file.data(), file.size());
+            SHA256_Final(hash, &sha256);
+            *bytesHashed = file.size();
+            if (syscalls) {
+                *syscalls += calls;
+            }
+            return true;
+        }
+        // sysfs attributes and similar files look regular but cannot be mapped.
+    }
+
+    uint8_t buffer[kStreamBufferSize];
+    size_t total = 0;
+    for (;;) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        calls++;
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            if (syscalls) {
+                *syscalls += calls;
+            }
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        SHA256_Update(&sha256, buffer, static_cast<size_t>(n));
+        total += static_cast<size_t>(n);
+    }
+
+    SHA256_Final(hash, &sha256);
+    *bytesHashed = total;
+    if (syscalls) {
+        *syscalls += calls;
+    }
+    return true;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_MAPPED_FILE_H
+#define APP_PROTECTION_MAPPED_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/**
+ * Read-only mapping of a regular file for a single hashing pass. Hashing
+ * straight from the page cache avoids a heap copy the size of the file;
+ * the mapping is advised MADV_SEQUENTIAL so the kernel reads ahead and
+ * drops pages behind the scan.
+ *
+ * If the file is truncated while mapped, touching the lost pages raises
+ * SIGBUS, so callers check the size against their baseline first.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Maps the first `size` bytes of `fd`. The fd may be closed afterwards.
+    bool map(int fd, size_t size);
+    void unmap();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    void* mapping_;
+    const uint8_t* data_;
+    size_t size_;
+};
+
+/**
+ * Reads a byte range of a regular file front to back in blocks, for files
+ * too large to map in one piece. Each block is read into the caller's
+ * buffer with pread(); the block after it is first requested with
+ * POSIX_FADV_WILLNEED, so storage fetches it while the caller hashes the
+ * current one. Memory use is the one block however large the file is.
+ */
+class FileBlockReader {
+public:
+    FileBlockReader(int fd, off_t offset, size_t size, uint8_t* buffer, size_t blockSize);
+
+    // Reads the next block into the buffer and returns its length: 0 once
+    // the range is exhausted or the file ended early, -1 on a read error.
+    ssize_t next();
+
+    const uint8_t* data() const { return buffer_; }
+    // Bytes read so far, relative to the start of the range.
+    size_t position() const { return position_; }
+    // True once the whole range has been read.
+    bool complete() const { return position_ == size_; }
+    uint32_t syscalls() const { return syscalls_; }
+
+private:
+    int fd_;
+    off_t offset_;
+    size_t size_;
+    uint8_t* buffer_;
+    size_t block_size_;
+    size_t position_;
+    bool ended_;
+    uint32_t syscalls_;
+};
+
+/**
+ * File identity and change metadata. A file that has not been replaced or
+ * written keeps the same stamp; content edits that restore the mtime still
+ * bump the ctime.
+ */
+struct FileStamp {
+    dev_t dev = 0;
+    ino_t ino = 0;
+    off_t size = 0;
+    struct timespec mtime = {};
+    struct timespec ctime = {};
+};
+
+FileStamp fileStampOf(const struct stat& st);
+bool operator==(const FileStamp& a, const FileStamp& b);
+
+// Hashes the contents of `fd` with SHA-256. Regular files are hashed from a
+// mapping; pseudo-files (procfs, sysfs, devices), whose st_size is not their
+// real length, are streamed through a small fixed buffer. Returns false on
+// a read error, otherwise stores the number of bytes hashed in `bytesHashed`.
+// The syscalls issued are added to `syscalls` when given.
+bool hashFileContents(int fd, const struct stat& st, uint8_t* hash, size_t* bytesHashed,
+                      uint32_t* syscalls = nullptr);
+
+#endif
@@ -15,28 +15,96 @@
  */
 
 #include "memory_monitor.h"
+#include <algorithm>
 #include <sys/mman.h>
 #include <unistd.h>
-#include <sys/system_properties.h>
-#include <android/log.h>
+#include "log.h"
 #include <map>
 #include <cstring>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <random>
+#include <chrono>
 
 #define TAG "MemoryMonitor"
 
 #include <openssl/sha.h>
+#include "sha256_internal.h"
+#include "merkle_tree.h"
+#include "fast_hash.h"
+#include "byte_compare.h"
+#include "code_segment.h"
+#include "dirty_page_tracker.h"
+#include "write_trap.h"
+#include "mapped_file.h"
+#include "proc_parser.h"
+#include "scan_coordinator.h"
+#include "baseline_store.h"
+#include "trace_ring.h"
+#include "scan_thread_pool.h"
 
-struct MemoryRegionInfo {
-    void* address;
-    size_t size;
-    uint8_t hash[SHA256_DIGEST_LENGTH];
-    bool is_protected;
+// Upper bound on the chunk offsets spelled out in a tamper report.
+static const size_t kMaxReportedChunks = 8;
+
+// Chunked regions larger than this many chunks are split into sub-ranges
+// of this size when scanned in parallel.
+static const size_t kChunksPerScanTask = 64;
+
+struct TamperReport {
+    std::string region;
+    std::string details;
+};
+
+struct ParallelScanTask {
+    size_t region;
+    // Chunk sub-range; chunk_count == 0 means the whole region.
+    size_t first_chunk;
+    size_t chunk_count;
+    bool intact;
+    std::vector<size_t> changed;
+    std::vector<TamperReport> reports;
+    VerifyStats stats;
+    uint64_t duration_ns = 0;
+    // A whole-region task whose lock was busy; rerun once split locks are released.
+    bool deferred = false;
 };
 
-static std::map<std::string, MemoryRegionInfo> memory_regions;
+// Working state of one scan, leased from the monitor's scan arena. Buffers
+// are cleared, never shrunk, between uses.
+struct ScanScratch {
+    PageBuffer io;
+    DetailBuffer details;
+    std::vector<size_t> changed;
+    std::vector<uint8_t> dirty;
+    std::vector<uint8_t> verified;
+
+    // scanAllProtectedRegions and its SIMD batch.
+    std::vector<uint8_t> digests;
+    std::vector<uint8_t> hashed;
+    std::vector<size_t> batch;
+    std::vector<const void*> batch_data;
+    std::vector<size_t> batch_lengths;
+    std::vector<SHA256_CTX> contexts;
+    std::vector<SHA256_CTX*> context_ptrs;
+    std::vector<RegionId> compromised;
+
+    // scanRegionsInParallel, indexed by position in the protected list.
+    std::vector<size_t> lock_order;
+    std::vector<std::unique_lock<std::mutex>> region_locks;
+    std::vector<MemoryRegionInfo*> infos;
+    std::vector<FileStamp> split_stamps;
+    std::vector<uint8_t> has_split_stamp;
+    std::vector<uint32_t> split_syscalls;
+    // Regions hashed through sub-range tasks in this pass.
+    std::vector<uint8_t> split_hashed;
+    std::vector<ParallelScanTask> tasks;
+    std::vector<uint8_t> intact;
+    std::vector<std::vector<size_t>> region_changed;
+    std::vector<std::vector<TamperReport>> region_reports;
+    std::vector<VerifyStats> region_stats;
+    std::vector<uint64_t> durations;
+    std::vector<TamperReport> reports;
+};
 
 static void fill_random_buffer(void* buffer, size_t size) {
     int fd = open("/dev/urandom", O_RDONLY);
@@ -58,44 +126,104 @@ static void fill_random_buffer(void* buffer, size_t size) {
     }
 }
 
-MemoryMonitor::MemoryMonitor() : is_monitoring_(false) {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Using SHA-256 for memory integrity");
+MemoryMonitor::MemoryMonitor()
+    : is_monitoring_(false), regions_(std::make_shared<RegionTable>()),
+      settings_(std::make_shared<ScanSettings>()), incremental_scanning_(false),
+      parallel_scanning_(false), write_trapping_(false), adaptive_scanning_(false),
+      scan_interval_ms_(0), manifest_(GoldenManifest::embedded()), bytes_hashed_(0), syscalls_(0),
+      mismatches_(0) {
+    LOGI("Using SHA-256 (%s) for memory integrity", sha256_backend_name());
 }
 
 MemoryMonitor::~MemoryMonitor() {
-    stopMonitoring();
+    {
+        // Queued captures still run their completions, but fail fast.
+        std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+        is_monitoring_ = false;
+    }
+    baseline_queue_.stop();
+    stopFileWatching();
+    stopScanScheduler();
+    // stopMonitoring() is a no-op from here on, so the regions are torn down
+    // directly; their state and mappings go with regions_. Trap handlers
+    // call back into this monitor, and shared results published under its
+    // address must not outlive it.
+    for (RegionId id : regions_->protectedIds()) {
+        disarmWriteTrap(*regions_->state(id));
+        ScanCoordinator::instance().release(this, regions_->name(id));
+    }
+    tamper_events_.stop();
+}
+
+bool MemoryMonitor::isOwnThread() const {
+    return scan_scheduler_.isWorkerThread() || file_watcher_.isWorkerThread() ||
+           baseline_queue_.isWorkerThread() || tamper_events_.isDispatcherThread();
 }
 
 bool MemoryMonitor::startMonitoring() {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
     if (is_monitoring_) {
         return true;
     }
 
     is_monitoring_ = true;
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory monitoring started");
+    LOGI("Memory monitoring started");
     return true;
 }
 
 void MemoryMonitor::stopMonitoring() {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
     if (!is_monitoring_) {
         return;
     }
 
-    for (const auto& region : protected_regions_) {
-        unprotectMemoryRegion(region);
+    std::vector<RegionId> regions = regions_->protectedIds();
+    for (RegionId id : regions) {
+        unprotectMemoryRegion(regions_->name(id));
     }
     
-    memory_regions.clear();
-    protected_regions_.clear();
+    std::shared_ptr<RegionTable> table = copyRegions();
+    table->clear();
+    publishRegions(table);
     
     is_monitoring_ = false;
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory monitoring stopped");
+    LOGI("Memory monitoring stopped");
 }
 
 bool MemoryMonitor::isMonitoring() const {
     return is_monitoring_;
 }
 
+std::shared_ptr<const RegionTable> MemoryMonitor::loadRegions() const {
+    return std::atomic_load(&regions_);
+}
+
+std::shared_ptr<const ScanSettings> MemoryMonitor::loadSettings() const {
+    return std::atomic_load(&settings_);
+}
+
+std::shared_ptr<RegionTable> MemoryMonitor::copyRegions() const {
+    if (batch_regions_) {
+        return batch_regions_;
+    }
+    // Only writers store regions_, and they hold state_mutex_, so reading
+    // it here cannot race with a store.
+    return std::make_shared<RegionTable>(*regions_);
+}
+
+void MemoryMonitor::publishRegions(const std::shared_ptr<RegionTable>& table) {
+    if (table == batch_regions_) {
+        return;
+    }
+    std::atomic_store(&regions_, std::shared_ptr<const RegionTable>(table));
+}
+
+RegionState* MemoryMonitor::writerState(const std::string& region) const {
+    const RegionTable& table = batch_regions_ ? *batch_regions_ : *regions_;
+    return table.state(table.find(region));
+}
+
 static void calculateHash(const void* data, size_t size, uint8_t* hash) {
     SHA256_CTX sha256;
     SHA256_Init(&sha256);
@@ -107,202 +235,757 @@ static bool compareHashes(const uint8_t* hash1, const uint8_t* hash2) {
     return memcmp(hash1, hash2, SHA256_DIGEST_LENGTH) == 0;
 }
 
+// Where two baselines of the same chunk layout diverge: the first differing
+// chunk, or 0 when only whole-region digests are known.
+static int64_t compareDigests(const MemoryRegionInfo& info1, const MemoryRegionInfo& info2) {
+    if (info1.size == info2.size && compareHashes(info1.hash, info2.hash)) {
+        return kRegionsIdentical;
+    }
+    if (info1.chunk_size == 0) {
+        return 0;
+    }
+    size_t chunks = std::min(info1.chunk_hashes.size(), info2.chunk_hashes.size()) / SHA256_DIGEST_LENGTH;
+    for (size_t i = 0; i < chunks; i++) {
+        size_t at = i * SHA256_DIGEST_LENGTH;
+        if (!compareHashes(&info1.chunk_hashes[at], &info2.chunk_hashes[at])) {
+            return static_cast<int64_t>(i * info1.chunk_size);
+        }
+    }
+    return static_cast<int64_t>(std::min(info1.size, info2.size));
+}
+
+// Current bytes of a region: memory in place, regular files through a
+// read-only mapping held by `file`. Proc and streamed files have no stable
+// byte image and yield nullptr.
+static const uint8_t* currentBytes(const std::string& region, const MemoryRegionInfo& info, MappedFile& file,
+                                   size_t& size) {
+    if (region.find("/") != 0) {
+        size = info.size;
+        return static_cast<const uint8_t*>(info.address);
+    }
+    if (region.find("/proc/") == 0 || info.streamed) {
+        return nullptr;
+    }
+
+    int fd = open(region.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        LOGE("Failed to open %s: %s", region.c_str(), strerror(errno));
+        return nullptr;
+    }
+    struct stat st;
+    bool opened = fstat(fd, &st) == 0;
+    if (opened && st.st_size == 0) {
+        close(fd);
+        static const uint8_t empty = 0;
+        size = 0;
+        return &empty;
+    }
+    bool mapped = opened && file.map(fd, static_cast<size_t>(st.st_size));
+    close(fd);
+    if (!mapped) {
+        return nullptr;
+    }
+    size = file.size();
+    return file.data();
+}
+
+static void captureBaseline(MemoryRegionInfo& info, const void* data, size_t size, size_t chunkSize) {
+    info.chunk_size = chunkSize;
+    info.fast_hash = fastHash64(data, size, fastHashSeed());
+    info.scans_until_full = 0;
+    if (chunkSize == 0) {
+        info.chunk_hashes.clear();
+        calculateHash(data, size, info.hash);
+        return;
+    }
+
+    size_t chunkCount = merkleChunkCount(size, chunkSize);
+    info.chunk_hashes.resize(chunkCount * SHA256_DIGEST_LENGTH);
+    merkleHashChunks(static_cast<const uint8_t*>(data), size, chunkSize, 0, chunkCount, info.chunk_hashes.data());
+    merkleRoot(info.chunk_hashes.data(), chunkCount, info.hash);
+}
+
+static size_t findChangedChunks(const MemoryRegionInfo& info, const void* data, size_t size,
+                                bool stopAtFirst, std::vector<size_t>& changed) {
+    size_t chunkCount = info.chunk_hashes.size() / SHA256_DIGEST_LENGTH;
+    return merkleFindChangedChunks(static_cast<const uint8_t*>(data), size, info.chunk_size,
+                                   info.chunk_hashes.data(), 0, chunkCount, stopAtFirst, changed);
+}
+
+static void appendChangedChunks(DetailBuffer& details, const std::vector<size_t>& changed, size_t chunkSize) {
+    details.append("Changed chunks: ").appendNumber(changed.size())
+           .append(" (chunk size: ").appendNumber(chunkSize).append(", offsets: ");
+    for (size_t i = 0; i < changed.size() && i < kMaxReportedChunks; i++) {
+        if (i > 0) {
+            details.append(", ");
+        }
+        details.appendHexOffset(static_cast<uint64_t>(changed[i]) * chunkSize);
+    }
+    if (changed.size() > kMaxReportedChunks) {
+        details.append(", ...");
+    }
+    details.append(")");
+}
+
+// Formats the first eight digest bytes of `hash` as hex.
+static void formatHashPrefix(const uint8_t* hash, char (&prefix)[17]) {
+    static const char kHex[] = "0123456789abcdef";
+    for (int i = 0; i < 8; i++) {
+        prefix[i * 2] = kHex[hash[i] >> 4];
+        prefix[i * 2 + 1] = kHex[hash[i] & 0xf];
+    }
+    prefix[16] = '\0';
+}
+
+// Bytes a chunk comparison hashed: all of them, unless it stopped early at
+// the first changed chunk.
+static uint64_t chunkBytesHashed(const std::vector<size_t>& changed, size_t size, size_t chunkSize,
+                                 bool stopAtFirst) {
+    if (changed.empty() || !stopAtFirst) {
+        return size;
+    }
+    return std::min<uint64_t>(size, (changed.back() + 1) * static_cast<uint64_t>(chunkSize));
+}
+
+bool MemoryMonitor::scanDirtyChunks(const MemoryRegionInfo& info, bool stopAtFirst, ScanScratch& scratch,
+                                    VerifyStats& stats) {
+    DirtyPageTracker& tracker = DirtyPageTracker::instance();
+    std::vector<uint8_t>& dirty = scratch.dirty;
+    std::vector<size_t>& changed = scratch.changed;
+    // open, pread and close of /proc/self/pagemap.
+    stats.syscalls += 3;
+    if (!tracker.collectDirtyPages(info.address, dirty)) {
+        return false;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(info.address);
+    std::vector<uint8_t>& verified = scratch.verified;
+    verified.assign(dirty.size(), 0);
+    for (size_t i = 0; i < dirty.size(); i++) {
+        if (!dirty[i]) {
+            continue;
+        }
+        stats.bytes_hashed += info.chunk_size;
+        if (merkleFindChangedChunks(data, info.size, info.chunk_size, info.chunk_hashes.data(),
+                                    i, 1, true, changed) == 0) {
+            verified[i] = 1;
+        } else if (stopAtFirst) {
+            break;
+        }
+    }
+
+    tracker.markVerified(info.address, verified);
+    return true;
+}
+
+static size_t chunkSizeFor(const ChunkingConfig& config, size_t regionSize) {
+    if (config.chunk_size == 0 || regionSize < config.min_region_size) {
+        return 0;
+    }
+    return config.chunk_size;
+}
+
+static bool streamsFile(const StreamingConfig& config, size_t fileSize) {
+    return config.min_file_size > 0 && fileSize >= config.min_file_size;
+}
+
+// Streaming block size; a whole number of chunks, so no chunk straddles
+// two blocks.
+static size_t streamBlockSize(const StreamingConfig& config, size_t chunkSize) {
+    size_t blockSize = std::max(config.block_size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    if (chunkSize == 0) {
+        return blockSize;
+    }
+    return std::max<size_t>(blockSize / chunkSize, 1) * chunkSize;
+}
+
+// Baseline of a streamed file: the whole-file SHA-256, or the chunk digests
+// and their Merkle root, folded in block by block. Fails unless exactly
+// `size` bytes were read.
+static bool streamFileBaseline(int fd, size_t size, size_t chunkSize, const StreamingConfig& config,
+                               MemoryRegionInfo& info) {
+    size_t blockSize = streamBlockSize(config, chunkSize);
+    PageBuffer buffer;
+    if (!buffer.reserve(blockSize)) {
+        return false;
+    }
+
+    info.chunk_size = chunkSize;
+    info.fast_hash = 0;
+    info.scans_until_full = 0;
+    size_t chunkCount = chunkSize > 0 ? merkleChunkCount(size, chunkSize) : 0;
+    info.chunk_hashes.assign(chunkCount * SHA256_DIGEST_LENGTH, 0);
+
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    FileBlockReader reader(fd, 0, size, buffer.data(), blockSize);
+    ssize_t length;
+    while ((length = reader.next()) > 0) {
+        if (chunkSize == 0) {
+            SHA256_Update(&sha256, reader.data(), static_cast<size_t>(length));
+            continue;
+        }
+        size_t firstChunk = (reader.position() - static_cast<size_t>(length)) / chunkSize;
+        merkleHashChunks(reader.data(), static_cast<size_t>(length), chunkSize, 0,
+                         merkleChunkCount(static_cast<size_t>(length), chunkSize),
+                         info.chunk_hashes.data() + firstChunk * SHA256_DIGEST_LENGTH);
+    }
+    if (length < 0 || !reader.complete()) {
+        return false;
+    }
+
+    info.size = size;
+    if (chunkSize == 0) {
+        SHA256_Final(info.hash, &sha256);
+    } else {
+        merkleRoot(info.chunk_hashes.data(), chunkCount, info.hash);
+    }
+    return true;
+}
+
+// Streaming counterpart of findChangedChunks() for a file region. A file
+// that ends early reports its first missing chunk as changed.
+static bool streamChangedChunks(int fd, const MemoryRegionInfo& info, const StreamingConfig& config,
+                                bool stopAtFirst, PageBuffer& buffer, std::vector<size_t>& changed,
+                                VerifyStats& stats) {
+    size_t blockSize = streamBlockSize(config, info.chunk_size);
+    if (!buffer.reserve(blockSize)) {
+        return false;
+    }
+
+    FileBlockReader reader(fd, 0, info.size, buffer.data(), blockSize);
+    ssize_t length;
+    while ((length = reader.next()) > 0) {
+        size_t firstChunk = (reader.position() - static_cast<size_t>(length)) / info.chunk_size;
+        size_t before = changed.size();
+        stats.bytes_hashed += static_cast<uint64_t>(length);
+        merkleFindChangedChunks(reader.data(), static_cast<size_t>(length), info.chunk_size,
+                                info.chunk_hashes.data() + firstChunk * SHA256_DIGEST_LENGTH, 0,
+                                merkleChunkCount(static_cast<size_t>(length), info.chunk_size),
+                                stopAtFirst, changed);
+        for (size_t i = before; i < changed.size(); i++) {
+            changed[i] += firstChunk;
+        }
+        if (stopAtFirst && !changed.empty()) {
+            break;
+        }
+    }
+    stats.syscalls += reader.syscalls();
+    if (length < 0) {
+        return false;
+    }
+    if (length == 0 && !reader.complete()) {
+        changed.push_back(reader.position() / info.chunk_size);
+    }
+    return true;
+}
+
+// Whole-file SHA-256 of a streamed file; a short file simply hashes fewer
+// bytes and so fails to match.
+static bool streamFileHash(int fd, size_t size, const StreamingConfig& config, PageBuffer& buffer,
+                           uint8_t* hash, size_t* bytesHashed, uint32_t* syscalls) {
+    size_t blockSize = streamBlockSize(config, 0);
+    if (!buffer.reserve(blockSize)) {
+        return false;
+    }
+
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    FileBlockReader reader(fd, 0, size, buffer.data(), blockSize);
+    ssize_t length;
+    while ((length = reader.next()) > 0) {
+        SHA256_Update(&sha256, reader.data(), static_cast<size_t>(length));
+    }
+    *syscalls += reader.syscalls();
+    if (length < 0) {
+        return false;
+    }
+    SHA256_Final(hash, &sha256);
+    *bytesHashed = reader.position();
+    return true;
+}
+
+RegionId MemoryMonitor::getRegionId(const std::string& region) const {
+    return loadRegions()->find(region);
+}
+
+// Number of stamp-matching scans to skip before the next forced rehash.
+static uint32_t nextDeepScanDelay(const ScanPolicy& policy) {
+    uint32_t interval = policy.deep_scan_interval;
+    if (!policy.jitter_deep_scans || interval < 2) {
+        return interval - 1;
+    }
+
+    // Pool threads verify regions concurrently, so each uses its own engine.
+    static thread_local std::minstd_rand rng(std::random_device{}());
+    std::uniform_int_distribution<uint32_t> dist(interval / 2, interval + interval / 2);
+    return dist(rng) - 1;
+}
+
+static bool canSkipFileHash(const ScanPolicy& policy, MemoryRegionInfo& info, const struct stat& st) {
+    if (!policy.skip_unchanged_files || info.streamed || !info.has_stamp ||
+        !(fileStampOf(st) == info.stamp)) {
+        return false;
+    }
+
+    if (policy.deep_scan_interval == 0) {
+        return true;
+    }
+    if (info.scans_until_deep > 0) {
+        info.scans_until_deep--;
+        return true;
+    }
+
+    info.scans_until_deep = nextDeepScanDelay(policy);
+    return false;
+}
+
+// Soft-dirty tracking already limits incremental regions to the pages that
+// changed, so the fast tier only applies to regions hashed in full.
+static bool canUseFastHash(const ScanPolicy& policy, const MemoryRegionInfo& info) {
+    return policy.fast_hash_memory && !info.incremental && info.scans_until_full > 0;
+}
+
+// Called after a passing SHA-256 check to schedule the next one.
+static void resetFastHashCadence(const ScanPolicy& policy, MemoryRegionInfo& info) {
+    uint32_t interval = policy.full_hash_interval;
+    info.scans_until_full = interval > 1 ? interval - 1 : 0;
+}
+
+// A trapped region is rescanned as soon as it is written, so the regular
+// scans in between only have to catch writes that bypassed the trap.
+static bool canSkipTrappedRegion(const MemoryRegionInfo& info) {
+    return info.write_trapped && info.scans_until_rehash > 0;
+}
+
+static void resetTrapCadence(const ScanPolicy& policy, MemoryRegionInfo& info) {
+    uint32_t interval = policy.trapped_rehash_interval;
+    info.scans_until_rehash = info.write_trapped && interval > 1 ? interval - 1 : 0;
+}
+
+// Soft-dirty bits only say what the kernel saw since the last clear, and
+// any code in the process can clear them, so dirty-page scans are only
+// trusted between periodic full rehashes.
+static bool canScanDirtyPagesOnly(const MemoryRegionInfo& info) {
+    return info.incremental && info.scans_until_sweep > 0;
+}
+
+static void resetSweepCadence(const ScanPolicy& policy, MemoryRegionInfo& info) {
+    uint32_t interval = policy.incremental_full_scan_interval;
+    info.scans_until_sweep = info.incremental && interval > 1 ? interval - 1 : 0;
+}
+
+// Protection a memory region is kept at between scans.
+static int protectionOf(const MemoryRegionInfo& info) {
+    return info.code ? PROT_READ | PROT_EXEC : PROT_READ;
+}
+
+// A tampered region may have been made writable to get the write in; put it
+// back to read-only so the trap, if armed, covers it again.
+static void restoreReadOnly(const std::string& region, const MemoryRegionInfo& info, VerifyStats& stats) {
+    stats.syscalls++;
+    if (mprotect(info.address, info.size, protectionOf(info)) != 0) {
+        LOGE("Failed to restore memory protection of %s: %s", region.c_str(), strerror(errno));
+    }
+}
+
+// Regions whose bytes are the same in every monitor that protects them:
+// regular files and loaded library text.
+static bool sharesVerification(const ScanPolicy& policy, const std::string& region, const MemoryRegionInfo& info) {
+    if (policy.shared_result_max_age_ms == 0) {
+        return false;
+    }
+    if (info.code) {
+        return true;
+    }
+    return region.find("/") == 0 && region.find("/proc/") != 0 && !info.streamed;
+}
+
+// Takes a region as verified when another monitor recently hashed it and
+// matched the same baseline; `st` is the file's current metadata.
+static bool reuseSharedVerification(const void* owner, const ScanPolicy& policy, const std::string& region,
+                                    MemoryRegionInfo& info, const struct stat* st) {
+    if (!sharesVerification(policy, region, info)) {
+        return false;
+    }
+
+    FileStamp stamp;
+    if (st) {
+        stamp = fileStampOf(*st);
+    }
+    uint64_t maxAgeNs = static_cast<uint64_t>(policy.shared_result_max_age_ms) * 1000000ULL;
+    if (!ScanCoordinator::instance().verifiedRecently(owner, region, info.chunk_size, info.hash,
+                                                      st ? &stamp : nullptr, TraceRing::nowNs(), maxAgeNs)) {
+        return false;
+    }
+    if (st) {
+        info.stamp = stamp;
+        info.has_stamp = true;
+    }
+    return true;
+}
+
 bool MemoryMonitor::scanMemoryRegion(const std::string& region) {
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot scan region %s - monitoring not active", region.c_str());
+        LOGE("Cannot scan region %s - monitoring not active", region.c_str());
+        return false;
+    }
+
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionId id = table->find(region);
+    if (id == kInvalidRegionId) {
+        LOGE("Cannot scan region %s - region not found", region.c_str());
+        return false;
+    }
+
+    return scanRegion(*table, id, *loadSettings(), nullptr);
+}
+
+bool MemoryMonitor::scanMemoryRegion(RegionId id) {
+    return scanRegion(*loadRegions(), id, *loadSettings(), nullptr);
+}
+
+bool MemoryMonitor::scanRegion(const RegionTable& table, RegionId id, const ScanSettings& settings,
+                               const uint8_t* digest) {
+    const std::string& region = table.name(id);
+    if (!is_monitoring_) {
+        LOGE("Cannot scan region %s - monitoring not active", region.c_str());
         return false;
     }
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot scan region %s - region not found", region.c_str());
+    RegionState* state = table.state(id);
+    if (!state) {
+        LOGE("Cannot scan region %s - region not found", region.c_str());
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
+    bool result;
+    std::vector<TamperReport> reports;
+    {
+        std::lock_guard<std::mutex> lock(state->lock);
+        uint64_t start = TraceRing::nowNs();
+        VerifyStats stats;
+        result = verifyRegion(region, state->info, settings, reports, &stats, digest);
+        recordScan(id, state->info, start, TraceRing::nowNs() - start, stats, result);
+    }
+    
+    // Delivered unlocked, so the callback may scan this region again.
+    for (const auto& report : reports) {
+        notifyTampering(report.region, report.details);
+    }
     
+    return result;
+}
+
+void MemoryMonitor::recordScan(RegionId id, MemoryRegionInfo& info, uint64_t startNs, uint64_t durationNs,
+                               const VerifyStats& stats, bool intact) {
+    scan_latency_.record(durationNs);
+    bytes_hashed_.fetch_add(stats.bytes_hashed, std::memory_order_relaxed);
+    syscalls_.fetch_add(stats.syscalls, std::memory_order_relaxed);
+    if (!intact) {
+        mismatches_.fetch_add(1, std::memory_order_relaxed);
+        scan_rate_.recordTamper(id);
+    }
+    info.metrics.record(startNs, durationNs, stats, intact);
+    TraceRing::instance().record(TRACE_SCAN_REGION, id, durationNs, intact);
+}
+
+// Checks one region against its baseline without touching monitor state,
+// so it can run on scan pool threads. Tamper notifications are appended to
+// `reports` for the caller to deliver. Verdicts on regions other monitors
+// can share are passed on to the ScanCoordinator.
+bool MemoryMonitor::verifyRegion(const std::string& region, MemoryRegionInfo& info,
+                                 const ScanSettings& settings, std::vector<TamperReport>& reports,
+                                 VerifyStats* stats, const uint8_t* digest) {
+    VerifyStats localStats;
+    VerifyStats& s = stats ? *stats : localStats;
+    uint64_t hashedBefore = s.bytes_hashed;
+    bool intact = verifyRegionContents(region, info, settings, reports, s, digest);
+    if (sharesVerification(settings.policy, region, info)) {
+        // Only a fresh hash is worth passing on, not a skipped or reused scan.
+        if (!intact) {
+            ScanCoordinator::instance().invalidate(region);
+        } else if (s.bytes_hashed > hashedBefore) {
+            ScanCoordinator::instance().publish(this, region, info.chunk_size, info.hash,
+                                                info.has_stamp ? &info.stamp : nullptr, TraceRing::nowNs());
+        }
+    }
+    return intact;
+}
+
+bool MemoryMonitor::verifyRegionContents(const std::string& region, MemoryRegionInfo& info,
+                                         const ScanSettings& settings, std::vector<TamperReport>& reports,
+                                         VerifyStats& s, const uint8_t* digest) {
     bool isFilePath = region.find("/") == 0;
     bool isProcFile = region.find("/proc/") == 0;
+    ScanArena<ScanScratch>::Lease scratch(scan_arena_);
+    DetailBuffer& details = scratch->details;
+    details.clear();
     
     if (isProcFile && (info.hash[0] == 0xFF || info.hash[0] == 0x00)) {
-        __android_log_print(ANDROID_LOG_WARN, TAG, "SECURITY ALERT: Simulated tampering detected for %s", 
+        LOGW("SECURITY ALERT: Simulated tampering detected for %s", 
                            region.c_str());
         
-        std::string details = "Simulated tampering detected for: " + region;
-        
-        notifyTampering(region, details);
+        details.append("Simulated tampering detected for: ").append(region);
+        reports.push_back(TamperReport{region, details.str()});
         
         return false;
     }
     
     if (isFilePath) {
-        if (region == "/proc/self/status") {
-            int fd = open(region.c_str(), O_RDONLY);
-            if (fd != -1) {
-                char buffer[4096];
-                ssize_t bytesRead = read(fd, buffer, sizeof(buffer));
-                close(fd);
-                
-                if (bytesRead > 0) {
-                    calculateHash(buffer, bytesRead, info.hash);
-                    info.size = bytesRead;
-                }
-            }
-            
-            return true;
+        ProcFileKind procKind = isProcFile ? procFileKindOf(region.c_str()) : PROC_FILE_OTHER;
+        if (procKind != PROC_FILE_OTHER) {
+            return verifyCriticalLines(region, procKind, info, reports, s);
         }
         
         int fd = open(region.c_str(), O_RDONLY);
+        s.syscalls++;
         if (fd == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to open file %s for scanning: %s", 
+            LOGE("Failed to open file %s for scanning: %s", 
                                region.c_str(), strerror(errno));
             
             if (!isProcFile) {
-                std::string details = "File cannot be opened: " + region +
-                                     ", Error: " + strerror(errno);
-                notifyTampering(region, details);
+                details.append("File cannot be opened: ").append(region)
+                       .append(", Error: ").append(strerror(errno));
+                reports.push_back(TamperReport{region, details.str()});
             }
             
             return false;
         }
         
+        // fstat and the eventual close.
+        s.syscalls += 2;
         struct stat st;
         if (fstat(fd, &st) == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get file size for %s: %s", 
+            LOGE("Failed to get file size for %s: %s", 
                                region.c_str(), strerror(errno));
             close(fd);
             
             if (!isProcFile) {
-                std::string details = "Failed to get file size: " + region +
-                                     ", Error: " + strerror(errno);
-                notifyTampering(region, details);
+                details.append("Failed to get file size: ").append(region)
+                       .append(", Error: ").append(strerror(errno));
+                reports.push_back(TamperReport{region, details.str()});
             }
             
             return false;
         }
         
-        if (!isProcFile && st.st_size != info.size) {
-            __android_log_print(ANDROID_LOG_WARN, TAG, "File size changed for %s: original=%zu, current=%zu", 
+        if (!isProcFile && !info.streamed && static_cast<size_t>(st.st_size) != info.size) {
+            LOGW("File size changed for %s: original=%zu, current=%zu", 
                                region.c_str(), info.size, (size_t)st.st_size);
             close(fd);
             
-            std::string details = "File size changed: " + region +
-                                 ", Original size: " + std::to_string(info.size) + 
-                                 ", Current size: " + std::to_string(st.st_size);
-            notifyTampering(region, details);
+            details.append("File size changed: ").append(region)
+                   .append(", Original size: ").appendNumber(info.size)
+                   .append(", Current size: ").appendNumber(st.st_size);
+            reports.push_back(TamperReport{region, details.str()});
             return false;
         }
         
-        size_t readSize = st.st_size;
-        if (isProcFile && readSize == 0) {
-            readSize = 4096;
+        if (!isProcFile && canSkipFileHash(settings.policy, info, st)) {
+            close(fd);
+            return true;
+        }
+        
+        if (!isProcFile && reuseSharedVerification(this, settings.policy, region, info, &st)) {
+            close(fd);
+            return true;
         }
         
-        void* buffer = malloc(readSize > 0 ? readSize : 1);
-        if (!buffer) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to allocate memory for file content: %s", 
-                               region.c_str());
+        if (info.chunk_size > 0 && streamsFile(settings.streaming, info.size)) {
+            std::vector<size_t>& changed = scratch->changed;
+            changed.clear();
+            bool read = streamChangedChunks(fd, info, settings.streaming, settings.chunking.stop_at_first_mismatch,
+                                            scratch->io, changed, s);
+            close(fd);
+            if (!read) {
+                LOGE("Failed to read file %s for scanning: %s", region.c_str(), strerror(errno));
+                return false;
+            }
+
+            s.changed_chunks = changed.size();
+            if (changed.empty()) {
+                info.stamp = fileStampOf(st);
+                info.has_stamp = true;
+                return true;
+            }
+
+            LOGW("SECURITY ALERT: File tampering detected for %s", region.c_str());
+
+            details.append("File content tampered: ").append(region).append(", ");
+            appendChangedChunks(details, changed, info.chunk_size);
+            reports.push_back(TamperReport{region, details.str()});
+            return false;
+        }
+
+        if (info.chunk_size > 0) {
+            MappedFile file;
+            s.syscalls++;
+            if (!file.map(fd, info.size)) {
+                LOGE("Failed to map file %s for scanning: %s", 
+                                   region.c_str(), strerror(errno));
+                close(fd);
+                return false;
+            }
             close(fd);
+            
+            std::vector<size_t>& changed = scratch->changed;
+            changed.clear();
+            findChangedChunks(info, file.data(), file.size(), settings.chunking.stop_at_first_mismatch, changed);
+            file.unmap();
+            // madvise and munmap.
+            s.syscalls += 2;
+            
+            s.changed_chunks = changed.size();
+            s.bytes_hashed += chunkBytesHashed(changed, info.size, info.chunk_size,
+                                               settings.chunking.stop_at_first_mismatch);
+            if (changed.empty()) {
+                info.stamp = fileStampOf(st);
+                info.has_stamp = true;
+                return true;
+            }
+            
+            LOGW("SECURITY ALERT: File tampering detected for %s", 
+                               region.c_str());
+            
+            details.append("File content tampered: ").append(region).append(", ");
+            appendChangedChunks(details, changed, info.chunk_size);
+            reports.push_back(TamperReport{region, details.str()});
             return false;
         }
         
-        ssize_t bytesRead = read(fd, buffer, readSize);
+        uint8_t currentHash[SHA256_DIGEST_LENGTH];
+        size_t bytesHashed = 0;
+        bool hashed = !isProcFile && S_ISREG(st.st_mode) && streamsFile(settings.streaming, info.size)
+                ? streamFileHash(fd, info.size, settings.streaming, scratch->io, currentHash, &bytesHashed, &s.syscalls)
+                : hashFileContents(fd, st, currentHash, &bytesHashed, &s.syscalls);
         close(fd);
         
-        if (bytesRead < 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to read file content: %s", 
+        if (!hashed) {
+            LOGE("Failed to read file content: %s", 
                                region.c_str());
-            free(buffer);
             return false;
         }
+        s.bytes_hashed += bytesHashed;
         
         if (isProcFile) {
-            info.size = bytesRead;
+            info.size = bytesHashed;
         }
         
-        uint8_t currentHash[SHA256_DIGEST_LENGTH];
-        calculateHash(buffer, bytesRead, currentHash);
-        free(buffer);
-        
         bool result = compareHashes(currentHash, info.hash);
         
+        if (result && !isProcFile) {
+            info.stamp = fileStampOf(st);
+            info.has_stamp = true;
+        }
+        
         if (!result) {
-            if (isProcFile) {
-                int diffCount = 0;
-                for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-                    if (currentHash[i] != info.hash[i]) {
-                        diffCount++;
-                    }
-                }
-                
-                if (diffCount < SHA256_DIGEST_LENGTH / 4) {
-                    memcpy(info.hash, currentHash, SHA256_DIGEST_LENGTH);
-                    __android_log_print(ANDROID_LOG_INFO, TAG, "Minor changes detected in %s - updating baseline", 
-                                      region.c_str());
-                    return true;
-                }
-            }
-            
-            __android_log_print(ANDROID_LOG_WARN, TAG, "SECURITY ALERT: File tampering detected for %s", 
+            LOGW("SECURITY ALERT: File tampering detected for %s", 
                                region.c_str());
             
-            std::string originalHashStr, currentHashStr;
-            for (int i = 0; i < 8 && i < SHA256_DIGEST_LENGTH; i++) {
-                char hexByte[3];
-                snprintf(hexByte, sizeof(hexByte), "%02x", info.hash[i]);
-                originalHashStr += hexByte;
-                
-                snprintf(hexByte, sizeof(hexByte), "%02x", currentHash[i]);
-                currentHashStr += hexByte;
-            }
-            
-            std::string details = "File content tampered: " + region + 
-                                 ", Original hash prefix: " + originalHashStr + 
-                                 ", Current hash prefix: " + currentHashStr;
+            char originalPrefix[17], currentPrefix[17];
+            formatHashPrefix(info.hash, originalPrefix);
+            formatHashPrefix(currentHash, currentPrefix);
             
-            notifyTampering(region, details);
+            details.append("File content tampered: ").append(region)
+                   .append(", Original hash prefix: ").append(originalPrefix)
+                   .append(", Current hash prefix: ").append(currentPrefix);
+            reports.push_back(TamperReport{region, details.str()});
             
             if (isProcFile) {
                 memcpy(info.hash, currentHash, SHA256_DIGEST_LENGTH);
-                __android_log_print(ANDROID_LOG_INFO, TAG, "Updated baseline for %s to reduce alerts", 
+                LOGI("Updated baseline for %s to reduce alerts", 
                                   region.c_str());
             }
         }
         
         return result;
     } else {
-        if (mprotect(info.address, info.size, PROT_READ) != 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to make memory readable for scanning: %s", strerror(errno));
-            return false;
+        // Protected memory stays read-only between scans, so it is hashed in
+        // place without touching its protection.
+        if (canSkipTrappedRegion(info)) {
+            info.scans_until_rehash--;
+            return true;
         }
-    
-    uint8_t currentHash[SHA256_DIGEST_LENGTH];
-    calculateHash(info.address, info.size, currentHash);
         
-        if (mprotect(info.address, info.size, PROT_READ) != 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to restore memory protection after scanning: %s", strerror(errno));
+        if (!digest && reuseSharedVerification(this, settings.policy, region, info, nullptr)) {
+            return true;
         }
-    
-    bool result = compareHashes(currentHash, info.hash);
-    
-    if (!result) {
-            __android_log_print(ANDROID_LOG_WARN, TAG, "SECURITY ALERT: Memory tampering detected in region %s", region.c_str());
-            
-            __android_log_print(ANDROID_LOG_WARN, TAG, "Memory region: %s, Address: %p, Size: %zu",
-                               region.c_str(), info.address, info.size);
-            
-            std::string originalHashStr, currentHashStr;
-            for (int i = 0; i < 8 && i < SHA256_DIGEST_LENGTH; i++) {
-                char hexByte[3];
-                snprintf(hexByte, sizeof(hexByte), "%02x", info.hash[i]);
-                originalHashStr += hexByte;
-                
-                snprintf(hexByte, sizeof(hexByte), "%02x", currentHash[i]);
-                currentHashStr += hexByte;
+        
+        if (canUseFastHash(settings.policy, info)) {
+            s.bytes_hashed += info.size;
+            if (fastHash64(info.address, info.size, fastHashSeed()) == info.fast_hash) {
+                info.scans_until_full--;
+                return true;
             }
-            __android_log_print(ANDROID_LOG_WARN, TAG, "Original hash prefix: %s, Current hash prefix: %s", 
-                               originalHashStr.c_str(), currentHashStr.c_str());
-            
+            // A fast-tier mismatch is confirmed, and located, by SHA-256.
+            info.scans_until_full = 0;
+        }
+        
+        if (info.chunk_size > 0) {
+            std::vector<size_t>& changed = scratch->changed;
+            changed.clear();
+            bool stopAtFirst = settings.chunking.stop_at_first_mismatch;
+            if (canScanDirtyPagesOnly(info) && scanDirtyChunks(info, stopAtFirst, *scratch, s)) {
+                if (changed.empty()) {
+                    info.scans_until_sweep--;
+                }
+            } else {
+                changed.clear();
+                findChangedChunks(info, info.address, info.size, stopAtFirst, changed);
+                s.bytes_hashed += chunkBytesHashed(changed, info.size, info.chunk_size, stopAtFirst);
+                // Every page matches its baseline, so dirty tracking can
+                // start over from here.
+                if (changed.empty() && info.incremental) {
+                    if (DirtyPageTracker::instance().resetBaseline(info.address)) {
+                        resetSweepCadence(settings.policy, info);
+                    }
+                }
+            }
+            
+            s.changed_chunks = changed.size();
+            if (changed.empty()) {
+                resetFastHashCadence(settings.policy, info);
+                resetTrapCadence(settings.policy, info);
+                return true;
+            }
+            
+            LOGW("SECURITY ALERT: Memory tampering detected in region %s", region.c_str());
+            restoreReadOnly(region, info, s);
+            
+            details.append("Memory region tampered: ").append(region).append(", ");
+            appendChangedChunks(details, changed, info.chunk_size);
+            reports.push_back(TamperReport{region, details.str()});
+            return false;
+        }
+    
+    uint8_t currentHash[SHA256_DIGEST_LENGTH];
+    if (digest) {
+        memcpy(currentHash, digest, SHA256_DIGEST_LENGTH);
+    } else {
+        calculateHash(info.address, info.size, currentHash);
+    }
+    s.bytes_hashed += info.size;
+    
+    bool result = compareHashes(currentHash, info.hash);
+    if (result) {
+        resetFastHashCadence(settings.policy, info);
+        resetTrapCadence(settings.policy, info);
+    }
+    
+    if (!result) {
+            LOGW("SECURITY ALERT: Memory tampering detected in region %s", region.c_str());
+            restoreReadOnly(region, info, s);
+            
+            LOGW("Memory region: %s, Address: %p, Size: %zu",
+                               region.c_str(), info.address, info.size);
+            
+            char originalPrefix[17], currentPrefix[17];
+            formatHashPrefix(info.hash, originalPrefix);
+            formatHashPrefix(currentHash, currentPrefix);
+            LOGW("Original hash prefix: %s, Current hash prefix: %s", 
+                               originalPrefix, currentPrefix);
+            
             int tamperedByteCount = 0;
             for (size_t i = 0; i < info.size && i < 1024; i++) {
                 uint8_t* originalData = static_cast<uint8_t*>(info.address);
@@ -311,180 +994,754 @@ bool MemoryMonitor::scanMemoryRegion(const std::string& region) {
                 }
             }
             if (tamperedByteCount > 0) {
-                __android_log_print(ANDROID_LOG_WARN, TAG, "Found %d potentially tampered bytes in the first 1KB", 
+                LOGW("Found %d potentially tampered bytes in the first 1KB", 
                                    tamperedByteCount);
             }
             
-            std::string details = "Memory region tampered: " + region + 
-                                 ", Original hash prefix: " + originalHashStr + 
-                                 ", Current hash prefix: " + currentHashStr;
-            
-            notifyTampering(region, details);
+            details.append("Memory region tampered: ").append(region)
+                   .append(", Original hash prefix: ").append(originalPrefix)
+                   .append(", Current hash prefix: ").append(currentPrefix);
+            reports.push_back(TamperReport{region, details.str()});
     }
     
     return result;
     }
 }
 
-bool MemoryMonitor::compareMemoryRegions(const std::string& region1, const std::string& region2) {
+void MemoryMonitor::scanMemoryRegions(const std::vector<RegionId>& ids, std::vector<RegionScanResult>& results) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    std::shared_ptr<const ScanSettings> settings = loadSettings();
+
+    results.assign(ids.size(), RegionScanResult());
+    std::vector<TamperReport> reports;
+    for (size_t i = 0; i < ids.size(); i++) {
+        RegionScanResult& result = results[i];
+        if (!is_monitoring_) {
+            result.status = REGION_SCAN_NOT_MONITORING;
+            continue;
+        }
+
+        RegionState* state = table->state(ids[i]);
+        if (!state) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(state->lock);
+        uint64_t start = TraceRing::nowNs();
+        VerifyStats stats;
+        bool intact = verifyRegion(table->name(ids[i]), state->info, *settings, reports, &stats);
+        uint64_t duration = TraceRing::nowNs() - start;
+        recordScan(ids[i], state->info, start, duration, stats, intact);
+        
+        result.elapsed_ns = static_cast<int64_t>(duration);
+        result.changed_chunks = stats.changed_chunks;
+        result.status = intact ? REGION_SCAN_INTACT : REGION_SCAN_TAMPERED;
+    }
+
+    for (const auto& report : reports) {
+        notifyTampering(report.region, report.details);
+    }
+}
+
+bool MemoryMonitor::compareMemoryRegions(const std::string& region1, const std::string& region2, bool deep,
+                                         int64_t* firstDifference) {
+    if (firstDifference) {
+        *firstDifference = kRegionsNotComparable;
+    }
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot compare regions - monitoring not active");
+        LOGE("Cannot compare regions - monitoring not active");
         return false;
     }
 
-    auto it1 = memory_regions.find(region1);
-    auto it2 = memory_regions.find(region2);
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state1 = table->state(table->find(region1));
+    RegionState* state2 = table->state(table->find(region2));
     
-    if (it1 == memory_regions.end() || it2 == memory_regions.end()) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot compare regions - one or both regions not found");
+    if (!state1 || !state2) {
+        LOGE("Cannot compare regions - one or both regions not found");
         return false;
     }
 
-    MemoryRegionInfo& info1 = it1->second;
-    MemoryRegionInfo& info2 = it2->second;
-    
-    if (info1.size != info2.size) {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Regions have different sizes");
-        return false;
+    // Region locks are only ever nested in ascending address order.
+    std::unique_lock<std::mutex> lock1(std::min(state1, state2)->lock);
+    std::unique_lock<std::mutex> lock2;
+    if (state1 != state2) {
+        lock2 = std::unique_lock<std::mutex>(std::max(state1, state2)->lock);
     }
-    
-    bool result = (memcmp(info1.address, info2.address, info1.size) == 0);
-    
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Memory regions comparison result: %d", result);
+
+    MemoryRegionInfo& info1 = state1->info;
+    MemoryRegionInfo& info2 = state2->info;
+
+    // Baselines hashed with different chunk layouts cannot be matched
+    // digest for digest, so those fall back to the current bytes.
+    int64_t difference;
+    if (!deep && info1.chunk_size == info2.chunk_size) {
+        difference = compareDigests(info1, info2);
+    } else {
+        MappedFile file1;
+        MappedFile file2;
+        size_t size1 = 0;
+        size_t size2 = 0;
+        const uint8_t* data1 = currentBytes(region1, info1, file1, size1);
+        const uint8_t* data2 = currentBytes(region2, info2, file2, size2);
+        if (!data1 || !data2) {
+            LOGE("Cannot compare the contents of %s and %s", region1.c_str(), region2.c_str());
+            return false;
+        }
+        size_t common = std::min(size1, size2);
+        size_t offset = findFirstDifference(data1, data2, common);
+        difference = offset == common && size1 == size2 ? kRegionsIdentical : static_cast<int64_t>(offset);
+    }
+
+    if (firstDifference) {
+        *firstDifference = difference;
+    }
+    bool result = difference == kRegionsIdentical;
+    LOGD("Memory regions comparison result: %d", result);
     return result;
 }
 
+bool MemoryMonitor::createRegionGroup(const std::string& group, const std::vector<std::string>& members) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (members.empty()) {
+        LOGE("Cannot create region group %s - no members", group.c_str());
+        return false;
+    }
+
+    std::shared_ptr<RegionGroup> entry = std::make_shared<RegionGroup>();
+    for (const auto& member : members) {
+        RegionId id = regions_->find(member);
+        RegionState* state = regions_->state(id);
+        if (!state) {
+            LOGE("Cannot create region group %s - %s is not protected", group.c_str(), member.c_str());
+            return false;
+        }
+        std::lock_guard<std::mutex> regionLock(state->lock);
+        if (entry->members.empty()) {
+            memcpy(entry->digest, state->info.hash, SHA256_DIGEST_LENGTH);
+        } else if (!compareHashes(entry->digest, state->info.hash)) {
+            LOGE("Cannot create region group %s - baseline of %s differs from %s", group.c_str(),
+                 member.c_str(), members[0].c_str());
+            return false;
+        }
+        entry->members.push_back(id);
+    }
+
+    std::shared_ptr<RegionTable> table = copyRegions();
+    table->putGroup(group, entry);
+    publishRegions(table);
+    LOGI("Created region group %s with %zu members", group.c_str(), entry->members.size());
+    return true;
+}
+
+void MemoryMonitor::removeRegionGroup(const std::string& group) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (!regions_->group(group)) {
+        LOGI("Region group %s does not exist", group.c_str());
+        return;
+    }
+    std::shared_ptr<RegionTable> table = copyRegions();
+    table->removeGroup(group);
+    publishRegions(table);
+    LOGI("Removed region group %s", group.c_str());
+}
+
+bool MemoryMonitor::scanRegionGroup(const std::string& name) {
+    if (!is_monitoring_) {
+        LOGE("Cannot scan region group %s - monitoring not active", name.c_str());
+        return false;
+    }
+
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionGroup* group = table->group(name);
+    if (!group) {
+        LOGE("Cannot scan region group %s - group not found", name.c_str());
+        return false;
+    }
+
+    // One member per scan is rehashed regardless of its metadata; the rest
+    // are trusted while their file stamp is unchanged. Memory regions have
+    // no stamp and are always hashed.
+    std::shared_ptr<const ScanSettings> settings = loadSettings();
+    ScanSettings full = *settings;
+    full.policy.skip_unchanged_files = false;
+    ScanSettings byStamp = *settings;
+    byStamp.policy.skip_unchanged_files = true;
+    byStamp.policy.deep_scan_interval = 0;
+
+    size_t deep = group->next_deep.fetch_add(1, std::memory_order_relaxed) % group->members.size();
+    bool intact = true;
+    for (size_t i = 0; i < group->members.size(); i++) {
+        RegionId id = group->members[i];
+        RegionState* state = table->state(id);
+        if (!state) {
+            LOGW("Region group %s: %s is no longer protected", name.c_str(), table->name(id).c_str());
+            intact = false;
+            continue;
+        }
+        if (!scanRegion(*table, id, i == deep ? full : byStamp, nullptr)) {
+            intact = false;
+            continue;
+        }
+
+        // A member that was re-baselined since the group was created no
+        // longer vouches for the same contents as the others.
+        bool diverged;
+        {
+            std::lock_guard<std::mutex> regionLock(state->lock);
+            diverged = !compareHashes(state->info.hash, group->digest);
+        }
+        if (diverged) {
+            const std::string& member = table->name(id);
+            LOGW("SECURITY ALERT: %s no longer matches region group %s", member.c_str(), name.c_str());
+            DetailBuffer details;
+            details.append("Baseline of ").append(member).append(" no longer matches region group ").append(name);
+            notifyTampering(member, details.str());
+            intact = false;
+        }
+    }
+    return intact;
+}
+
 void MemoryMonitor::addCriticalRegion(const std::string& region) {
-    auto it = std::find(critical_regions_.begin(), critical_regions_.end(), region);
-    if (it == critical_regions_.end()) {
-        critical_regions_.push_back(region);
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Added critical region: %s", region.c_str());
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    std::shared_ptr<RegionTable> table = copyRegions();
+    RegionId id = table->intern(region);
+    if (!table->isCritical(id)) {
+        table->setCritical(id, true);
+        publishRegions(table);
+        LOGI("Added critical region: %s", region.c_str());
     } else {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Critical region %s already exists", region.c_str());
+        LOGI("Critical region %s already exists", region.c_str());
     }
 }
 
 void MemoryMonitor::removeCriticalRegion(const std::string& region) {
-    auto it = std::find(critical_regions_.begin(), critical_regions_.end(), region);
-    if (it != critical_regions_.end()) {
-        critical_regions_.erase(it);
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Removed critical region: %s", region.c_str());
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    RegionId id = regions_->find(region);
+    if (regions_->isCritical(id)) {
+        std::shared_ptr<RegionTable> table = copyRegions();
+        table->setCritical(id, false);
+        publishRegions(table);
+        LOGI("Removed critical region: %s", region.c_str());
     } else {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Critical region %s not found", region.c_str());
+        LOGI("Critical region %s not found", region.c_str());
+    }
+}
+
+std::vector<std::string> MemoryMonitor::getCriticalRegions() const {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    const std::vector<RegionId>& critical = table->criticalIds();
+
+    LOGD("Getting %zu critical regions", critical.size());
+    std::vector<std::string> names;
+    names.reserve(critical.size());
+    for (RegionId id : critical) {
+        names.push_back(table->name(id));
     }
+    return names;
 }
 
-const std::vector<std::string>& MemoryMonitor::getCriticalRegions() const {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Getting %zu critical regions", critical_regions_.size());
-    return critical_regions_;
+// Layout: version, bucket count, then the scan, protect and scan-all
+// histograms (count, total ns, max ns, buckets), then bytes hashed, syscalls
+// and mismatches, then the number of regions followed by one record per
+// protected region: id, scans, mismatches, last scan ns, last duration ns,
+// bytes hashed and its latency buckets.
+void MemoryMonitor::getScanMetrics(std::vector<int64_t>& packed) const {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    const std::vector<RegionId>& ids = table->protectedIds();
+
+    packed.clear();
+    packed.push_back(1);
+    packed.push_back(static_cast<int64_t>(kLatencyBuckets));
+    scan_latency_.append(packed);
+    protect_latency_.append(packed);
+    scan_all_latency_.append(packed);
+    packed.push_back(static_cast<int64_t>(bytes_hashed_.load(std::memory_order_relaxed)));
+    packed.push_back(static_cast<int64_t>(syscalls_.load(std::memory_order_relaxed)));
+    packed.push_back(static_cast<int64_t>(mismatches_.load(std::memory_order_relaxed)));
+
+    packed.push_back(static_cast<int64_t>(ids.size()));
+    for (RegionId id : ids) {
+        RegionState* state = table->state(id);
+        RegionMetrics metrics;
+        {
+            std::lock_guard<std::mutex> lock(state->lock);
+            metrics = state->info.metrics;
+        }
+        packed.push_back(id);
+        packed.push_back(static_cast<int64_t>(metrics.scan_count));
+        packed.push_back(static_cast<int64_t>(metrics.mismatch_count));
+        packed.push_back(static_cast<int64_t>(metrics.last_scan_ns));
+        packed.push_back(static_cast<int64_t>(metrics.last_duration_ns));
+        packed.push_back(static_cast<int64_t>(metrics.bytes_hashed));
+        for (uint32_t count : metrics.latency) {
+            packed.push_back(count);
+        }
+    }
 }
 
-const std::vector<std::string>& MemoryMonitor::getProtectedRegions() const {
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Getting %zu protected regions", protected_regions_.size());
-    return protected_regions_;
+// Only regular files have a stable identity to check a snapshot against;
+// memory regions are recreated per process and proc files change freely.
+static bool isSnapshotRegion(const std::string& region, const MemoryRegionInfo& info) {
+    return region.find("/") == 0 && region.find("/proc/") != 0 && info.has_stamp;
 }
 
-bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
+bool MemoryMonitor::saveBaseline(const std::string& path, const std::vector<uint8_t>& key) const {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+
+    std::vector<BaselineEntry> entries;
+    for (RegionId id : table->protectedIds()) {
+        RegionState* state = table->state(id);
+        std::lock_guard<std::mutex> lock(state->lock);
+        const MemoryRegionInfo* info = &state->info;
+        const std::string& region = table->name(id);
+        if (!isSnapshotRegion(region, *info)) {
+            continue;
+        }
+
+        BaselineEntry entry;
+        entry.path = region;
+        entry.stamp = info->stamp;
+        entry.size = info->size;
+        entry.chunk_size = info->chunk_size;
+        entry.streamed = info->streamed;
+        memcpy(entry.hash, info->hash, SHA256_DIGEST_LENGTH);
+        entry.chunk_hashes = info->chunk_hashes;
+        entries.push_back(std::move(entry));
+    }
+
+    return writeBaselineFile(path, entries, key);
+}
+
+bool MemoryMonitor::loadBaseline(const std::string& path, const std::vector<uint8_t>& key, size_t* restored) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (restored) {
+        *restored = 0;
+    }
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot protect region %s - monitoring not active", region.c_str());
+        LOGE("Cannot load baseline - monitoring not active");
         return false;
     }
 
-    if (std::find(protected_regions_.begin(), protected_regions_.end(), region) != protected_regions_.end()) {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Region %s is already protected", region.c_str());
-        return true;
+    std::vector<BaselineEntry> entries;
+    if (!readBaselineFile(path, key, entries)) {
+        return false;
     }
 
-    bool isFilePath = region.find("/") == 0;
-    
-    if (isFilePath) {
-        if (region == "/proc/self/status") {
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Adding special handling for dynamic file: %s", region.c_str());
-            
-            MemoryRegionInfo info;
-            info.address = nullptr;
-            info.size = 4096;
-            
-            int fd = open(region.c_str(), O_RDONLY);
-            if (fd != -1) {
-                char buffer[4096];
-                ssize_t bytesRead = read(fd, buffer, sizeof(buffer));
-                close(fd);
-                
-                if (bytesRead > 0) {
-                    info.size = bytesRead;
-                    calculateHash(buffer, bytesRead, info.hash);
-                } else {
-                    memset(info.hash, 0, SHA256_DIGEST_LENGTH);
-                }
-            } else {
-                memset(info.hash, 0, SHA256_DIGEST_LENGTH);
-                __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to open file %s for protection: %s", 
-                                  region.c_str(), strerror(errno));
-            }
-            
-            memory_regions[region] = info;
-            
-            protected_regions_.push_back(region);
-            
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Dynamic file %s protected with special handling (size: %zu bytes)", 
-                              region.c_str(), info.size);
-            
-            return true;
-        }
-        
-        int fd = open(region.c_str(), O_RDONLY);
-        if (fd == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to open file %s for protection: %s", 
-                               region.c_str(), strerror(errno));
-            return false;
+    std::shared_ptr<RegionTable> table = copyRegions();
+    size_t count = 0;
+    for (const BaselineEntry& entry : entries) {
+        RegionId id = table->find(entry.path);
+        if (id != kInvalidRegionId && table->state(id)) {
+            continue;
         }
-        
+
+        // A file that changed since the snapshot needs a fresh baseline from
+        // protectMemoryRegion; the snapshot cannot vouch for it.
         struct stat st;
-        if (fstat(fd, &st) == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get file size for %s: %s", 
-                               region.c_str(), strerror(errno));
-            close(fd);
-            return false;
+        if (stat(entry.path.c_str(), &st) != 0 || !(fileStampOf(st) == entry.stamp)) {
+            LOGD("Baseline for %s is stale, skipping", entry.path.c_str());
+            continue;
         }
-        
-        bool isProcFile = region.find("/proc/") == 0;
-        
-        size_t readSize = st.st_size;
-        if (isProcFile && readSize == 0) {
-            readSize = 4096;
+        if (entry.chunk_size > 0 &&
+            entry.chunk_hashes.size() != merkleChunkCount(entry.size, entry.chunk_size) * SHA256_DIGEST_LENGTH) {
+            continue;
         }
-        
-        void* buffer = malloc(readSize > 0 ? readSize : 1);
-        if (!buffer) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to allocate memory for file content: %s", 
+
+        MemoryRegionInfo info;
+        info.size = entry.size;
+        memcpy(info.hash, entry.hash, SHA256_DIGEST_LENGTH);
+        info.is_protected = true;
+        info.chunk_size = entry.chunk_size;
+        info.chunk_hashes = entry.chunk_hashes;
+        info.streamed = entry.streamed;
+        info.stamp = entry.stamp;
+        info.has_stamp = true;
+        // Zero makes the stat fast path rehash on the first scan, so every
+        // restored baseline is checked once against the real contents.
+        info.scans_until_deep = 0;
+
+        id = table->intern(entry.path);
+        table->put(id, info);
+        if (isWatchableFile(entry.path, info)) {
+            file_watcher_.addWatch(entry.path);
+        }
+        count++;
+    }
+    publishRegions(table);
+
+    LOGI("Restored %zu of %zu region baselines from %s", count, entries.size(), path.c_str());
+    if (restored) {
+        *restored = count;
+    }
+    return true;
+}
+
+std::vector<std::string> MemoryMonitor::getProtectedRegions() const {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    const std::vector<RegionId>& ids = table->protectedIds();
+
+    LOGD("Getting %zu protected regions", ids.size());
+    std::vector<std::string> names;
+    names.reserve(ids.size());
+    for (RegionId id : ids) {
+        names.push_back(table->name(id));
+    }
+    return names;
+}
+
+bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    bool wasProtected = writerState(region) != nullptr;
+    uint64_t start = TraceRing::nowNs();
+    bool result = protectRegion(region);
+    protect_latency_.record(TraceRing::nowNs() - start);
+
+    RegionState* state = writerState(region);
+    if (result && !wasProtected && state) {
+        std::lock_guard<std::mutex> regionLock(state->lock);
+        bytes_hashed_.fetch_add(state->info.size, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// Opens, stats and hashes a file region into `info`. Touches no monitor
+// state, so the asynchronous path can run it without holding the lock.
+static bool captureFileBaseline(const std::string& region, const ScanSettings& settings,
+                                MemoryRegionInfo& info) {
+    int fd = open(region.c_str(), O_RDONLY);
+    if (fd == -1) {
+        LOGE("Failed to open file %s for protection: %s", 
+                           region.c_str(), strerror(errno));
+        return false;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        LOGE("Failed to get file size for %s: %s", 
+                           region.c_str(), strerror(errno));
+        close(fd);
+        return false;
+    }
+    
+    bool isProcFile = region.find("/proc/") == 0;
+    
+    info.address = nullptr;
+    
+    // Chunk digests are only kept for regular files, which are either
+    // mapped whole or, when very large, streamed in whole-chunk blocks.
+    size_t chunkSize = isProcFile || !S_ISREG(st.st_mode) ? 0 : chunkSizeFor(settings.chunking, st.st_size);
+    MappedFile file;
+    if (!isProcFile && S_ISREG(st.st_mode) && streamsFile(settings.streaming, st.st_size)) {
+        bool hashed = streamFileBaseline(fd, st.st_size, chunkSize, settings.streaming, info);
+        close(fd);
+
+        if (!hashed) {
+            LOGE("Failed to read file content: %s", 
                                region.c_str());
-            close(fd);
             return false;
         }
-        
-        ssize_t bytesRead = read(fd, buffer, readSize);
+    } else if (chunkSize > 0 && file.map(fd, st.st_size)) {
+        close(fd);
+        info.size = file.size();
+        captureBaseline(info, file.data(), file.size(), chunkSize);
+    } else {
+        size_t bytesHashed = 0;
+        bool hashed = hashFileContents(fd, st, info.hash, &bytesHashed);
         close(fd);
         
-        if (bytesRead < 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to read file content: %s", 
+        if (!hashed) {
+            LOGE("Failed to read file content: %s", 
                                region.c_str());
-            free(buffer);
             return false;
         }
+        info.size = bytesHashed;
+        info.streamed = bytesHashed != static_cast<size_t>(st.st_size);
+    }
+    
+    if (!isProcFile) {
+        info.stamp = fileStampOf(st);
+        info.has_stamp = true;
+    }
+    return true;
+}
+
+void MemoryMonitor::installFileRegion(RegionId id, const MemoryRegionInfo& info) {
+    std::shared_ptr<RegionTable> table = copyRegions();
+    table->put(id, info);
+    publishRegions(table);
+    
+    if (isWatchableFile(table->name(id), info)) {
+        file_watcher_.addWatch(table->name(id));
+    }
+}
+
+// A zero TracerPid is the normal state, so only an attached tracer makes
+// a line; detaching then reads as a removal, which is not reported.
+static bool isCriticalField(const ProcField& field) {
+    return field.type != PROC_FIELD_TRACER_PID || field.tracer_pid != 0;
+}
+
+static const size_t kCriticalLineMax = 640;
+
+static void appendCriticalLine(const ProcField& field, void* context) {
+    if (!isCriticalField(field)) {
+        return;
+    }
+    char line[kCriticalLineMax];
+    size_t length = formatProcField(field, line, sizeof(line));
+    std::string* content = static_cast<std::string*>(context);
+    content->append(line, length);
+    content->push_back('\n');
+}
+
+// Hashes the same text appendCriticalLine builds without materializing it,
+// so an unchanged proc file is verified without allocating.
+static void digestCriticalLine(const ProcField& field, void* context) {
+    if (!isCriticalField(field)) {
+        return;
+    }
+    char line[kCriticalLineMax + 1];
+    size_t length = formatProcField(field, line, kCriticalLineMax);
+    line[length++] = '\n';
+    SHA256_Update(static_cast<SHA256_CTX*>(context), line, length);
+}
+
+static std::set<std::string> splitCriticalLines(const std::string& content) {
+    std::set<std::string> lines;
+    size_t begin = 0;
+    while (begin < content.size()) {
+        size_t end = content.find('\n', begin);
+        if (end == std::string::npos) {
+            end = content.size();
+        }
+        lines.insert(content.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return lines;
+}
+
+bool MemoryMonitor::extractCriticalLines(const std::string& path, std::string& content, uint32_t* syscalls) {
+    content.clear();
+    return parseProcFile(path.c_str(), procFileKindOf(path.c_str()), appendCriticalLine, &content, syscalls);
+}
+
+// Proc files change between every read, so they are compared by the fields
+// that matter rather than by their bytes. Only fields that appeared since
+// the baseline are reported; the baseline then follows the file so each
+// change is reported once.
+bool MemoryMonitor::verifyCriticalLines(const std::string& region, ProcFileKind kind, MemoryRegionInfo& info,
+                                        std::vector<TamperReport>& reports, VerifyStats& stats) {
+    SHA256_CTX ctx;
+    SHA256_Init(&ctx);
+    if (!parseProcFile(region.c_str(), kind, digestCriticalLine, &ctx, &stats.syscalls)) {
+        LOGE("Failed to read critical fields of %s: %s", region.c_str(), strerror(errno));
+        return false;
+    }
+    uint8_t currentHash[SHA256_DIGEST_LENGTH];
+    SHA256_Final(currentHash, &ctx);
+    if (compareHashes(currentHash, info.hash)) {
+        return true;
+    }
+
+    std::string content;
+    if (!extractCriticalLines(region, content, &stats.syscalls)) {
+        LOGE("Failed to read critical fields of %s: %s", region.c_str(), strerror(errno));
+        return false;
+    }
+
+    std::set<std::string> current = splitCriticalLines(content);
+    std::set<std::string>& baseline = info.critical_lines;
+    std::vector<std::string> added;
+    std::set_difference(current.begin(), current.end(), baseline.begin(), baseline.end(),
+                        std::back_inserter(added));
+
+    baseline.swap(current);
+    info.size = content.size();
+    calculateHash(content.data(), content.size(), info.hash);
+
+    if (added.empty()) {
+        LOGD("Critical fields removed from %s - updating baseline", region.c_str());
+        return true;
+    }
+
+    LOGW("SECURITY ALERT: New critical fields in %s", region.c_str());
+
+    static const size_t kMaxListedFields = 4;
+    DetailBuffer details;
+    details.append("Critical fields added to ").append(region).append(": ");
+    for (size_t i = 0; i < added.size() && i < kMaxListedFields; i++) {
+        if (i > 0) {
+            details.append("; ");
+        }
+        details.append(added[i]);
+    }
+    if (added.size() > kMaxListedFields) {
+        details.append("; and ").appendNumber(added.size() - kMaxListedFields).append(" more");
+    }
+    reports.push_back(TamperReport{region, details.str()});
+    return false;
+}
+
+bool MemoryMonitor::protectMemoryRegionAsync(const std::string& region, ProtectCompletion completion) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (!is_monitoring_) {
+        LOGE("Cannot protect region %s - monitoring not active", region.c_str());
+        return false;
+    }
+
+    RegionId id = regions_->find(region);
+    if (id == kInvalidRegionId) {
+        std::shared_ptr<RegionTable> table = copyRegions();
+        id = table->intern(region);
+        publishRegions(table);
+    }
+    bool queued = baseline_queue_.post([this, region, id, completion]() {
+        bool result = completeAsyncProtect(region, id);
+        if (completion) {
+            completion(region, result);
+        }
+    });
+    if (queued) {
+        pending_regions_.insert(id);
+    }
+    return queued;
+}
+
+// Runs on the baseline worker. Files, the slow case, are hashed without the
+// state lock so scans and other calls are not held up; the lock is only taken
+// to install the finished baseline.
+bool MemoryMonitor::completeAsyncProtect(const std::string& region, RegionId id) {
+    std::shared_ptr<const ScanSettings> settings;
+    {
+        std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+        bool hashUnlocked = region.find("/") == 0 && region.find("/proc/") != 0;
+        if (!is_monitoring_ || regions_->state(id) || !hashUnlocked) {
+            pending_regions_.erase(id);
+            return is_monitoring_ && protectMemoryRegion(region);
+        }
+        settings = settings_;
+    }
+
+    uint64_t start = TraceRing::nowNs();
+    MemoryRegionInfo info;
+    bool captured = captureFileBaseline(region, *settings, info);
+    protect_latency_.record(TraceRing::nowNs() - start);
+
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    pending_regions_.erase(id);
+    if (!captured || !is_monitoring_) {
+        return false;
+    }
+    // Protected synchronously while this capture was running.
+    if (regions_->state(id)) {
+        return true;
+    }
+
+    bytes_hashed_.fetch_add(info.size, std::memory_order_relaxed);
+    installFileRegion(id, info);
+    LOGI("File %s protected asynchronously (size: %zu bytes)", region.c_str(), info.size);
+    return true;
+}
+
+bool MemoryMonitor::isRegionPending(const std::string& region) const {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    RegionId id = regions_->find(region);
+    return id != kInvalidRegionId && pending_regions_.count(id) > 0;
+}
+
+// Hashes the library text in place, in page chunks so a scan names each
+// patched page. Only the loader writes the text, before the library is
+// handed out, so the relocated image is itself the baseline.
+bool MemoryMonitor::protectCodeRegion(const std::shared_ptr<RegionTable>& table, RegionId id, const std::string& region) {
+    std::string library = region.substr(sizeof(kCodeRegionPrefix) - 1);
+    CodeSegment segment;
+    if (!findCodeSegment(library, segment)) {
+        LOGE("Failed to find the executable segment of loaded library %s", library.c_str());
+        return false;
+    }
+    if (segment.other_segments > 0) {
+        LOGW("Library %s has %zu more executable segments, only the first is protected",
+                          segment.path.c_str(), segment.other_segments);
+    }
+
+    MemoryRegionInfo info;
+    info.address = segment.address;
+    info.size = segment.size;
+    info.is_protected = true;
+    info.code = true;
+    captureBaseline(info, segment.address, segment.size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+
+    table->put(id, info);
+    publishRegions(table);
+
+    LOGI("Protected code of %s (addr: %p, size: %zu)", 
+                        segment.path.c_str(), segment.address, segment.size);
+    return true;
+}
+
+bool MemoryMonitor::protectRegion(const std::string& region) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (!is_monitoring_) {
+        LOGE("Cannot protect region %s - monitoring not active", region.c_str());
+        return false;
+    }
+
+    std::shared_ptr<RegionTable> table = copyRegions();
+    RegionId id = table->intern(region);
+    if (table->state(id)) {
+        LOGI("Region %s is already protected", region.c_str());
+        return true;
+    }
+
+    if (isCodeRegion(region)) {
+        return protectCodeRegion(table, id, region);
+    }
+
+    bool isFilePath = region.find("/") == 0;
+    
+    if (isFilePath) {
+        if (procFileKindOf(region.c_str()) != PROC_FILE_OTHER) {
+            std::string content;
+            if (!extractCriticalLines(region, content)) {
+                LOGE("Failed to read critical fields of %s: %s", 
+                                  region.c_str(), strerror(errno));
+                return false;
+            }
+            
+            MemoryRegionInfo info;
+            info.address = nullptr;
+            info.size = content.size();
+            calculateHash(content.data(), content.size(), info.hash);
+            info.critical_lines = splitCriticalLines(content);
+            
+            table->put(id, info);
+            publishRegions(table);
+            
+            LOGI("Proc file %s protected by %zu critical fields", 
+                              region.c_str(), info.critical_lines.size());
+            
+            return true;
+        }
         
         MemoryRegionInfo info;
-        info.address = nullptr;
-        info.size = bytesRead;
-        
-        calculateHash(buffer, bytesRead, info.hash);
-        free(buffer);
-        
-        memory_regions[region] = info;
-        
-        protected_regions_.push_back(region);
+        if (!captureFileBaseline(region, *settings_, info)) {
+            return false;
+        }
+        publishRegions(table);
+        installFileRegion(id, info);
         
-        __android_log_print(ANDROID_LOG_INFO, TAG, "File %s protected successfully (size: %zu bytes)", 
+        LOGI("File %s protected successfully (size: %zu bytes)", 
                            region.c_str(), info.size);
         
         return true;
@@ -498,10 +1755,10 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
             
             int fd = open(region.c_str(), O_RDONLY);
             if (fd == -1) {
-                __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to open file %s: %s", region.c_str(), strerror(errno));
+                LOGE("Failed to open file %s: %s", region.c_str(), strerror(errno));
                 
                 if (isProcFile) {
-                    __android_log_print(ANDROID_LOG_INFO, TAG, "Creating dummy region for proc file: %s", region.c_str());
+                    LOGI("Creating dummy region for proc file: %s", region.c_str());
                     createDummyRegion = true;
                 } else {
                     return false;
@@ -511,11 +1768,11 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
             if (!createDummyRegion) {
                 struct stat st;
                 if (fstat(fd, &st) == -1) {
-                    __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get file size for %s: %s", region.c_str(), strerror(errno));
+                    LOGE("Failed to get file size for %s: %s", region.c_str(), strerror(errno));
                     close(fd);
                     
                     if (isProcFile) {
-                        __android_log_print(ANDROID_LOG_INFO, TAG, "Creating dummy region for proc file after fstat failure: %s", region.c_str());
+                        LOGI("Creating dummy region for proc file after fstat failure: %s", region.c_str());
                         createDummyRegion = true;
                     } else {
                         return false;
@@ -525,7 +1782,7 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
                     
                     if (regionSize == 0 && isProcFile) {
                         regionSize = 4096;
-                        __android_log_print(ANDROID_LOG_INFO, TAG, "Using default size for zero-sized proc file: %s", region.c_str());
+                        LOGI("Using default size for zero-sized proc file: %s", region.c_str());
                     }
 
                     int mapFlags = MAP_PRIVATE;
@@ -537,17 +1794,17 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
                     memoryAddress = mmap(nullptr, regionSize, PROT_READ, mapFlags, fd, 0);
                     
                     if (memoryAddress == MAP_FAILED) {
-                        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to map file %s: %s", region.c_str(), strerror(errno));
+                        LOGE("Failed to map file %s: %s", region.c_str(), strerror(errno));
                         
                         if (isProcFile) {
-                            __android_log_print(ANDROID_LOG_INFO, TAG, "Creating dummy region for proc file after mmap failure: %s", region.c_str());
+                            LOGI("Creating dummy region for proc file after mmap failure: %s", region.c_str());
                             createDummyRegion = true;
                         } else {
                             close(fd);
                             return false;
                         }
                     } else {
-                        __android_log_print(ANDROID_LOG_INFO, TAG, "Mapped file %s to memory address %p with size %zu", 
+                        LOGI("Mapped file %s to memory address %p with size %zu", 
                                           region.c_str(), memoryAddress, regionSize);
                     }
                 }
@@ -560,14 +1817,14 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
                 memoryAddress = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
                 
                 if (memoryAddress == MAP_FAILED) {
-                    __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to allocate memory for region %s: %s", 
+                    LOGE("Failed to allocate memory for region %s: %s", 
                                       region.c_str(), strerror(errno));
                     return false;
                 }
                 
                 fill_random_buffer(memoryAddress, regionSize);
                 
-                __android_log_print(ANDROID_LOG_INFO, TAG, "Allocated memory for region %s at address %p with size %zu", 
+                LOGI("Allocated memory for region %s at address %p with size %zu", 
                                   region.c_str(), memoryAddress, regionSize);
             }
         } else {
@@ -576,14 +1833,14 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
             memoryAddress = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
             
             if (memoryAddress == MAP_FAILED) {
-                __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to allocate memory for region %s: %s", 
+                LOGE("Failed to allocate memory for region %s: %s", 
                                   region.c_str(), strerror(errno));
         return false;
     }
     
             fill_random_buffer(memoryAddress, regionSize);
             
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Allocated memory for region %s at address %p with size %zu", 
+            LOGI("Allocated memory for region %s at address %p with size %zu", 
                               region.c_str(), memoryAddress, regionSize);
         }
     
@@ -592,57 +1849,204 @@ bool MemoryMonitor::protectMemoryRegion(const std::string& region) {
     info.size = regionSize;
     info.is_protected = true;
     
-    calculateHash(memoryAddress, regionSize, info.hash);
+    DirtyPageTracker& tracker = DirtyPageTracker::instance();
+    info.incremental = incremental_scanning_ && tracker.isSupported();
+    
+    captureBaseline(info, memoryAddress, regionSize,
+                    info.incremental ? tracker.pageSize() : chunkSizeFor(settings_->chunking, regionSize));
         
-        if (mprotect(memoryAddress, regionSize, PROT_READ) != 0) {
-            __android_log_print(ANDROID_LOG_WARN, TAG, "Failed to set memory protection for %s: %s", 
+        bool readOnly = mprotect(memoryAddress, regionSize, PROT_READ) == 0;
+        if (!readOnly) {
+            LOGW("Failed to set memory protection for %s: %s", 
                               region.c_str(), strerror(errno));
         } else {
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Applied memory protection (read-only) to region %s", 
+            LOGI("Applied memory protection (read-only) to region %s", 
                               region.c_str());
         }
+        
+        if (info.incremental) {
+            tracker.registerRange(memoryAddress, regionSize);
+            if (!tracker.resetBaseline(memoryAddress)) {
+                LOGW("Incremental scanning unavailable for %s, using full rescans", 
+                                  region.c_str());
+                tracker.unregisterRange(memoryAddress);
+                info.incremental = false;
+            }
+            resetSweepCadence(settings_->policy, info);
+        }
     
-    memory_regions[region] = info;
-    
-    auto it = std::find(protected_regions_.begin(), protected_regions_.end(), region);
-    if (it == protected_regions_.end()) {
-        protected_regions_.push_back(region);
+    if (readOnly && write_trapping_) {
+        info.write_trapped = WriteTrap::instance().arm(memoryAddress, regionSize,
+                                                       [this, id]() { onWriteTrapped(id); });
+        resetTrapCadence(settings_->policy, info);
     }
     
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Protected memory region: %s (addr: %p, size: %zu)", 
+    // The state now owns the mapping and unmaps it once no table refers to it.
+    table->put(id, info);
+    publishRegions(table);
+    
+    LOGI("Protected memory region: %s (addr: %p, size: %zu)", 
                         region.c_str(), memoryAddress, regionSize);
     
     return true;
     }
 }
 
-bool MemoryMonitor::unprotectMemoryRegion(const std::string& region) {
+void MemoryMonitor::protectMemoryRegions(const std::vector<std::string>& regions, bool critical,
+                                         std::vector<RegionId>& ids) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    ids.clear();
+    ids.reserve(regions.size());
+    // One table copy for the whole batch instead of one per region, which
+    // would make large batches quadratic.
+    batch_regions_ = copyRegions();
+    for (const auto& region : regions) {
+        if (critical) {
+            addCriticalRegion(region);
+        }
+        ids.push_back(protectMemoryRegion(region) ? batch_regions_->find(region) : kInvalidRegionId);
+    }
+    std::shared_ptr<RegionTable> table = batch_regions_;
+    batch_regions_.reset();
+    publishRegions(table);
+}
+
+void MemoryMonitor::setGoldenManifest(const GoldenManifest& manifest) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    manifest_ = manifest;
+    LOGI("Golden manifest set (%zu entries)", manifest.entryCount());
+}
+
+void MemoryMonitor::protectFromManifest(const std::vector<std::string>& regions, std::vector<RegionId>& ids) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    ids.assign(regions.size(), kInvalidRegionId);
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot unprotect region %s - monitoring not active", region.c_str());
+        LOGE("Cannot protect regions from the golden manifest - monitoring not active");
+        return;
+    }
+
+    std::vector<RegionId> installed;
+    for (size_t i = 0; i < regions.size(); i++) {
+        const std::string& region = regions[i];
+        bool isFile = region.find("/") == 0 && region.find("/proc/") != 0;
+        if (!isFile && !isCodeRegion(region)) {
+            LOGE("Cannot protect %s from the golden manifest - only files and loaded libraries are listed",
+                              region.c_str());
+            continue;
+        }
+        const ManifestEntry* entry = manifest_.find(manifestNameOf(region));
+        if (!entry) {
+            LOGE("Golden manifest has no entry for %s", region.c_str());
+            continue;
+        }
+
+        std::shared_ptr<RegionTable> table = copyRegions();
+        RegionId id = table->intern(region);
+        if (table->state(id)) {
+            LOGI("Region %s is already protected", region.c_str());
+            ids[i] = id;
+            continue;
+        }
+        if (protectManifestRegion(table, id, region, *entry)) {
+            ids[i] = id;
+            installed.push_back(id);
+        }
+    }
+
+    if (!installed.empty() && !baseline_queue_.post([this, installed]() { verifyManifestRegions(installed); })) {
+        LOGW("Golden manifest regions are only verified by regular scans - baseline worker stopped");
+    }
+}
+
+bool MemoryMonitor::protectManifestRegion(const std::shared_ptr<RegionTable>& table, RegionId id,
+                                          const std::string& region, const ManifestEntry& entry) {
+    MemoryRegionInfo info;
+    info.is_protected = true;
+    info.size = static_cast<size_t>(entry.size);
+    info.chunk_size = entry.chunk_size;
+    const uint8_t* digests = manifest_.digests(entry);
+    info.chunk_hashes.assign(digests, digests + static_cast<size_t>(entry.digest_count) * SHA256_DIGEST_LENGTH);
+    memcpy(info.hash, entry.root, SHA256_DIGEST_LENGTH);
+
+    if (!isCodeRegion(region)) {
+        // No stamp yet: the first scan hashes the file, and only a match
+        // lets later scans rely on its metadata.
+        publishRegions(table);
+        installFileRegion(id, info);
+        LOGI("File %s protected from the golden manifest (size: %zu bytes)", region.c_str(), info.size);
+        return true;
+    }
+
+    std::string library = region.substr(sizeof(kCodeRegionPrefix) - 1);
+    CodeSegment segment;
+    if (!findCodeSegment(library, segment)) {
+        LOGE("Failed to find the executable segment of loaded library %s", library.c_str());
         return false;
     }
+    // A different page size or segment size means the manifest was built
+    // for another device or build, which no scan could match.
+    if (segment.size != info.size || info.chunk_size != static_cast<size_t>(sysconf(_SC_PAGESIZE))) {
+        LOGE("Golden manifest entry for %s does not fit the loaded library (size %zu, expected %zu)",
+                          region.c_str(), segment.size, info.size);
+        return false;
+    }
+    info.address = segment.address;
+    info.code = true;
+
+    table->put(id, info);
+    publishRegions(table);
+    LOGI("Protected code of %s from the golden manifest (addr: %p, size: %zu)",
+                        segment.path.c_str(), segment.address, segment.size);
+    return true;
+}
+
+// First verification of regions protected from the manifest. Code regions
+// get their fast-tier hash here, once they are known to match.
+void MemoryMonitor::verifyManifestRegions(const std::vector<RegionId>& ids) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    std::shared_ptr<const ScanSettings> settings = loadSettings();
+    size_t verified = 0;
+    for (RegionId id : ids) {
+        RegionState* state = table->state(id);
+        if (!state || !scanRegion(*table, id, *settings, nullptr)) {
+            continue;
+        }
+        verified++;
+        std::lock_guard<std::mutex> regionLock(state->lock);
+        if (state->info.code) {
+            state->info.fast_hash = fastHash64(state->info.address, state->info.size, fastHashSeed());
+        }
+    }
+    LOGI("Verified %zu of %zu regions against the golden manifest", verified, ids.size());
+}
+
+bool MemoryMonitor::unprotectMemoryRegion(const std::string& region) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot unprotect region %s - region not found", region.c_str());
+    if (!is_monitoring_) {
+        LOGE("Cannot unprotect region %s - monitoring not active", region.c_str());
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
-    
-    if (munmap(info.address, info.size) != 0) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to unmap memory for region %s: %s", 
-                           region.c_str(), strerror(errno));
+    RegionId id = regions_->find(region);
+    if (!regions_->state(id)) {
+        LOGE("Cannot unprotect region %s - region not found", region.c_str());
+        return false;
     }
+
+    disarmWriteTrap(*regions_->state(id));
     
-    memory_regions.erase(it);
+    // Scans still running on an older table keep the region state, and its
+    // memory, alive until they finish; the mapping is released with it.
+    std::shared_ptr<RegionTable> table = copyRegions();
+    table->remove(id);
+    publishRegions(table);
     
-    auto protIt = std::find(protected_regions_.begin(), protected_regions_.end(), region);
-    if (protIt != protected_regions_.end()) {
-        protected_regions_.erase(protIt);
-    }
+    file_watcher_.removeWatch(region);
     
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Unprotected memory region: %s", region.c_str());
+    LOGI("Unprotected memory region: %s", region.c_str());
     
     return true;
 }
@@ -652,12 +2056,14 @@ bool MemoryMonitor::readMemoryRegion(const std::string& region, void* buffer, si
         return false;
     }
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state = table->state(table->find(region));
+    if (!state) {
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
+    std::lock_guard<std::mutex> lock(state->lock);
+    MemoryRegionInfo& info = state->info;
     
     if (size < info.size) {
         return false;
@@ -673,12 +2079,14 @@ bool MemoryMonitor::writeMemoryRegion(const std::string& region, const void* buf
         return false;
     }
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state = table->state(table->find(region));
+    if (!state) {
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
+    std::lock_guard<std::mutex> lock(state->lock);
+    MemoryRegionInfo& info = state->info;
     
     if (size > info.size) {
         return false;
@@ -686,7 +2094,13 @@ bool MemoryMonitor::writeMemoryRegion(const std::string& region, const void* buf
     
     memcpy(info.address, buffer, size);
     
-    calculateHash(info.address, info.size, info.hash);
+    captureBaseline(info, info.address, info.size, info.chunk_size);
+    
+    if (info.incremental && !DirtyPageTracker::instance().resetBaseline(info.address)) {
+        DirtyPageTracker::instance().unregisterRange(info.address);
+        info.incremental = false;
+    }
+    resetSweepCadence(loadSettings()->policy, info);
     
     return true;
 }
@@ -696,15 +2110,17 @@ bool MemoryMonitor::getMemoryRegionInfo(const std::string& region, void* infoOut
         return false;
     }
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state = table->state(table->find(region));
+    if (!state) {
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
+    std::lock_guard<std::mutex> lock(state->lock);
+    MemoryRegionInfo& info = state->info;
     
     if (infoOut) {
-        memcpy(infoOut, &info, sizeof(MemoryRegionInfo));
+        *static_cast<MemoryRegionInfo*>(infoOut) = info;
     }
     
     return true;
@@ -712,32 +2128,35 @@ bool MemoryMonitor::getMemoryRegionInfo(const std::string& region, void* infoOut
 
 bool MemoryMonitor::simulateMemoryTampering(const std::string& region) {
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot simulate tampering - monitoring not active");
+        LOGE("Cannot simulate tampering - monitoring not active");
         return false;
     }
 
-    auto it = memory_regions.find(region);
-    if (it == memory_regions.end()) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot simulate tampering - region not found: %s", region.c_str());
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state = table->state(table->find(region));
+    if (!state) {
+        LOGE("Cannot simulate tampering - region not found: %s", region.c_str());
         return false;
     }
 
-    MemoryRegionInfo& info = it->second;
+    std::unique_lock<std::mutex> lock(state->lock);
+    MemoryRegionInfo& info = state->info;
     
     bool isFilePath = region.find("/") == 0;
     bool isProcFile = region.find("/proc/") == 0;
     
     if (isFilePath) {
         if (isProcFile) {
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Simulating tampering with proc file: %s", region.c_str());
+            LOGI("Simulating tampering with proc file: %s", region.c_str());
             
             if (info.hash[0] != 0xFF) {
                 info.hash[0] = 0xFF;
             } else {
                 info.hash[0] = 0x00;
             }
+            lock.unlock();
             
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Simulated tampering for proc file: %s by modifying stored hash", 
+            LOGI("Simulated tampering for proc file: %s by modifying stored hash", 
                               region.c_str());
             
             std::string details = "Simulated tampering detected for proc file: " + region;
@@ -748,14 +2167,14 @@ bool MemoryMonitor::simulateMemoryTampering(const std::string& region) {
         
         int fd = open(region.c_str(), O_RDWR);
         if (fd == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to open file for tampering simulation: %s", 
+            LOGE("Failed to open file for tampering simulation: %s", 
                                strerror(errno));
             return false;
         }
         
         struct stat st;
         if (fstat(fd, &st) == -1) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to get file size for tampering: %s", 
+            LOGE("Failed to get file size for tampering: %s", 
                                strerror(errno));
             close(fd);
             return false;
@@ -764,13 +2183,13 @@ bool MemoryMonitor::simulateMemoryTampering(const std::string& region) {
         if (st.st_size > 0) {
             char tamperByte = 'X';
             if (write(fd, &tamperByte, 1) != 1) {
-                __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to write tamper byte: %s", 
+                LOGE("Failed to write tamper byte: %s", 
                                    strerror(errno));
                 close(fd);
                 return false;
             }
             
-            __android_log_print(ANDROID_LOG_INFO, TAG, "File tampering simulated for: %s", region.c_str());
+            LOGI("File tampering simulated for: %s", region.c_str());
             close(fd);
             return true;
         }
@@ -778,8 +2197,8 @@ bool MemoryMonitor::simulateMemoryTampering(const std::string& region) {
         close(fd);
         return false;
     } else {
-        if (mprotect(info.address, info.size, PROT_READ | PROT_WRITE) != 0) {
-            __android_log_print(ANDROID_LOG_ERROR, TAG, "Failed to make memory writable for tampering simulation: %s", 
+        if (mprotect(info.address, info.size, protectionOf(info) | PROT_WRITE) != 0) {
+            LOGE("Failed to make memory writable for tampering simulation: %s", 
                                strerror(errno));
             return false;
         }
@@ -788,71 +2207,707 @@ bool MemoryMonitor::simulateMemoryTampering(const std::string& region) {
             uint8_t* bytePtr = static_cast<uint8_t*>(info.address);
             bytePtr[0] = ~bytePtr[0];
             
-            __android_log_print(ANDROID_LOG_INFO, TAG, "Memory tampering simulated for region: %s", region.c_str());
+            LOGI("Memory tampering simulated for region: %s", region.c_str());
                 
-            mprotect(info.address, info.size, PROT_READ);
+            mprotect(info.address, info.size, protectionOf(info));
             return true;
         }
         
-        mprotect(info.address, info.size, PROT_READ);
+        mprotect(info.address, info.size, protectionOf(info));
         return false;
     }
 }
 
+void MemoryMonitor::setChunkingConfig(const ChunkingConfig& config) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    std::shared_ptr<ScanSettings> settings = std::make_shared<ScanSettings>(*settings_);
+    settings->chunking = config;
+    std::atomic_store(&settings_, std::shared_ptr<const ScanSettings>(settings));
+    LOGI("Chunked hashing %s (chunk size: %zu, min region size: %zu)",
+                        config.chunk_size > 0 ? "enabled" : "disabled", config.chunk_size, config.min_region_size);
+}
+
+void MemoryMonitor::setStreamingConfig(const StreamingConfig& config) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    std::shared_ptr<ScanSettings> settings = std::make_shared<ScanSettings>(*settings_);
+    settings->streaming = config;
+    std::atomic_store(&settings_, std::shared_ptr<const ScanSettings>(settings));
+    LOGI("Streamed file hashing %s (min file size: %zu, block size: %zu)",
+                        config.min_file_size > 0 ? "enabled" : "disabled", config.min_file_size, config.block_size);
+}
+
+void MemoryMonitor::setIncrementalScanning(bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (enabled && !DirtyPageTracker::instance().isSupported()) {
+        LOGW("Soft-dirty tracking not supported, incremental scanning stays off");
+        enabled = false;
+    }
+    incremental_scanning_ = enabled;
+    LOGI("Incremental scanning %s", enabled ? "enabled" : "disabled");
+}
+
+void MemoryMonitor::setParallelScanning(bool enabled) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+
+    parallel_scanning_ = enabled;
+    if (!enabled) {
+        scan_pool_.reset();
+    }
+    LOGI("Parallel scanning %s", enabled ? "enabled" : "disabled");
+}
+
+bool MemoryMonitor::setWriteTrapping(bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    if (enabled && !WriteTrap::instance().isSupported()) {
+        LOGW("Write trapping not supported, anonymous regions stay polled");
+        enabled = false;
+    }
+    write_trapping_ = enabled;
+    LOGI("Write trapping %s", enabled ? "enabled" : "disabled");
+    return enabled;
+}
+
 void MemoryMonitor::setTamperingCallback(TamperingCallback callback) {
-    tampering_callback_ = callback;
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Tampering callback set");
+    std::atomic_store(&tampering_callback_, std::shared_ptr<const TamperingCallback>(
+        callback ? std::make_shared<TamperingCallback>(std::move(callback)) : nullptr));
+    LOGI("Tampering callback set");
+}
+
+void MemoryMonitor::setTamperingBatchCallback(TamperingBatchCallback callback, const DispatcherHooks& hooks) {
+    tamper_events_.setHandler(std::move(callback), hooks);
+    LOGI("Tampering batch callback set");
 }
 
+// Called without any monitor lock held, so the callback is free to call
+// back into the monitor.
 void MemoryMonitor::notifyTampering(const std::string& region, const std::string& details) {
-    if (tampering_callback_) {
-        tampering_callback_(region, details);
-        __android_log_print(ANDROID_LOG_INFO, TAG, "Tampering notification sent for region: %s", region.c_str());
-    } else {
-        __android_log_print(ANDROID_LOG_WARN, TAG, "No tampering callback set, cannot notify about region: %s", region.c_str());
+    TraceRing::instance().record(TRACE_TAMPER, loadRegions()->find(region), 0, 0);
+    
+    std::shared_ptr<const TamperingCallback> callback = std::atomic_load(&tampering_callback_);
+    bool batched = tamper_events_.isActive();
+    if (batched && tamper_events_.push(region, details)) {
+        LOGI("Tampering notification queued for region: %s", region.c_str());
+    }
+    if (callback) {
+        (*callback)(region, details);
+        LOGI("Tampering notification sent for region: %s", region.c_str());
+    } else if (!batched) {
+        LOGW("No tampering callback set, cannot notify about region: %s", region.c_str());
+    }
+}
+
+// Most protected memory regions are a few KiB, too short for one SHA-256
+// stream to keep the core busy. Hashing the ones due for a full SHA-256
+// check side by side in SIMD lanes gets that parallelism back. hashed[i]
+// says whether digests holds the current SHA-256 of the table's i-th
+// protected region.
+void MemoryMonitor::hashMemoryRegionsBatch(const RegionTable& table, const ScanSettings& settings,
+                                           ScanScratch& work) {
+    const std::vector<RegionId>& ids = table.protectedIds();
+    work.hashed.assign(ids.size(), 0);
+    if (sha256_multi_lanes() < 2) {
+        return;
+    }
+
+    // The address and size of a memory region are fixed for the life of its
+    // state, so only the eligibility check needs the region's lock.
+    work.batch.clear();
+    work.batch_data.clear();
+    work.batch_lengths.clear();
+    for (size_t i = 0; i < ids.size(); i++) {
+        RegionState* state = table.state(ids[i]);
+        if (!state || table.name(ids[i]).find("/") == 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(state->lock);
+        const MemoryRegionInfo& info = state->info;
+        if (info.chunk_size == 0 && !canUseFastHash(settings.policy, info) && !canSkipTrappedRegion(info)) {
+            work.batch.push_back(i);
+            work.batch_data.push_back(info.address);
+            work.batch_lengths.push_back(info.size);
+        }
+    }
+    size_t count = work.batch.size();
+    if (count < 2) {
+        return;
+    }
+
+    work.contexts.resize(count);
+    work.context_ptrs.resize(count);
+    for (size_t j = 0; j < count; j++) {
+        SHA256_Init(&work.contexts[j]);
+        work.context_ptrs[j] = &work.contexts[j];
+    }
+    SHA256_MultiUpdate(work.context_ptrs.data(), work.batch_data.data(), work.batch_lengths.data(), count);
+
+    work.digests.resize(ids.size() * SHA256_DIGEST_LENGTH);
+    for (size_t j = 0; j < count; j++) {
+        SHA256_Final(&work.digests[work.batch[j] * SHA256_DIGEST_LENGTH], &work.contexts[j]);
+        work.hashed[work.batch[j]] = 1;
     }
 }
 
 bool MemoryMonitor::scanAllProtectedRegions() {
     if (!is_monitoring_) {
-        __android_log_print(ANDROID_LOG_ERROR, TAG, "Cannot scan all regions - monitoring not active");
+        LOGE("Cannot scan all regions - monitoring not active");
         return false;
     }
     
-    if (protected_regions_.empty()) {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "No protected regions to scan");
+    // Regions protected or unprotected while this scan runs are picked up,
+    // or dropped, by the next one.
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    std::shared_ptr<const ScanSettings> settings = loadSettings();
+    const std::vector<RegionId>& ids = table->protectedIds();
+    if (ids.empty()) {
+        LOGI("No protected regions to scan");
         return true;
     }
     
-    bool allRegionsIntact = true;
-    std::vector<std::string> compromisedRegions;
+    uint64_t start = TraceRing::nowNs();
+    ScanArena<ScanScratch>::Lease scratch(scan_arena_);
+    std::vector<RegionId>& compromised = scratch->compromised;
+    compromised.clear();
     
-    __android_log_print(ANDROID_LOG_INFO, TAG, "Scanning %zu protected regions", protected_regions_.size());
+    LOGD("Scanning %zu protected regions", ids.size());
     
-    for (const auto& region : protected_regions_) {
-        bool regionIntact = scanMemoryRegion(region);
-        if (!regionIntact) {
-            allRegionsIntact = false;
-            compromisedRegions.push_back(region);
+    if (parallel_scanning_) {
+        scanRegionsInParallel(*table, *settings, compromised);
+    } else {
+        hashMemoryRegionsBatch(*table, *settings, *scratch);
+        
+        for (size_t i = 0; i < ids.size(); i++) {
+            RegionId id = ids[i];
+            const uint8_t* digest = scratch->hashed[i] ? &scratch->digests[i * SHA256_DIGEST_LENGTH] : nullptr;
+            if (!scanRegion(*table, id, *settings, digest)) {
+                compromised.push_back(id);
+            }
         }
     }
+    bool allRegionsIntact = compromised.empty();
     
     if (!allRegionsIntact) {
-        std::string compromisedList;
-        for (const auto& region : compromisedRegions) {
-            if (!compromisedList.empty()) {
-                compromisedList += ", ";
+        DetailBuffer& details = scratch->details;
+        details.clear();
+        details.append("Compromised regions: ");
+        for (size_t i = 0; i < compromised.size(); i++) {
+            if (i > 0) {
+                details.append(", ");
             }
-            compromisedList += region;
+            details.append(table->name(compromised[i]));
         }
+        LOGW("%s", details.c_str());
         
-        std::string details = "Compromised regions: " + compromisedList;
-        __android_log_print(ANDROID_LOG_WARN, TAG, "%s", details.c_str());
-        
-        notifyTampering("multiple_regions", details);
+        notifyTampering("multiple_regions", details.str());
     } else {
-        __android_log_print(ANDROID_LOG_INFO, TAG, "All protected regions verified intact");
+        LOGD("All protected regions verified intact");
     }
     
+    uint64_t duration = TraceRing::nowNs() - start;
+    scan_all_latency_.record(duration);
+    TraceRing::instance().record(TRACE_SCAN_ALL, kInvalidRegionId, duration, allRegionsIntact);
+    
     return allRegionsIntact;
-} 
\ No newline at end of file
+}
+
+void MemoryMonitor::setScanPolicy(const ScanPolicy& policy) {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+
+    std::shared_ptr<ScanSettings> settings = std::make_shared<ScanSettings>(*settings_);
+    settings->policy = policy;
+    std::atomic_store(&settings_, std::shared_ptr<const ScanSettings>(settings));
+    LOGI("Stat fast path %s (deep scan every %u scans%s)",
+                        policy.skip_unchanged_files ? "enabled" : "disabled", policy.deep_scan_interval,
+                        policy.jitter_deep_scans ? ", jittered" : "");
+}
+
+ScanPolicy MemoryMonitor::getScanPolicy() const {
+    return loadSettings()->policy;
+}
+
+bool MemoryMonitor::startScanScheduler(long interval_ms, const ScanPolicy& policy) {
+    setScanPolicy(policy);
+    scan_interval_ms_ = interval_ms;
+
+    return scan_scheduler_.start(std::chrono::milliseconds(interval_ms), [this]() {
+        runScheduledScan();
+    });
+}
+
+void MemoryMonitor::stopScanScheduler() {
+    scan_scheduler_.stop();
+}
+
+bool MemoryMonitor::isScanSchedulerRunning() const {
+    return scan_scheduler_.isRunning();
+}
+
+void MemoryMonitor::setAdaptiveScanning(bool enabled, const AdaptiveScanConfig& config) {
+    scan_rate_.configure(config);
+    adaptive_scanning_ = enabled;
+    if (enabled) {
+        scan_scheduler_.setInterval(scan_rate_.interval());
+    } else if (scan_interval_ms_ > 0) {
+        scan_scheduler_.setInterval(std::chrono::milliseconds(scan_interval_ms_.load()));
+    }
+    LOGI("Adaptive scanning %s (base interval: %u ms, time slices: %u)", enabled ? "enabled" : "disabled",
+                        config.base_interval_ms, config.time_slices);
+}
+
+void MemoryMonitor::setDeviceState(const DeviceState& state) {
+    std::chrono::milliseconds previous = scan_rate_.interval();
+    scan_rate_.setDeviceState(state);
+    LOGI("Device state: %s, battery saver %s, thermal status %d", state.foreground ? "foreground" : "background",
+                        state.battery_saver ? "on" : "off", state.thermal_status);
+    if (!adaptive_scanning_) {
+        return;
+    }
+
+    std::chrono::milliseconds interval = scan_rate_.interval();
+    scan_scheduler_.setInterval(interval);
+    // A tick already waiting out a long background interval is cut short.
+    if (interval < previous) {
+        scan_scheduler_.wake();
+    }
+}
+
+bool MemoryMonitor::isWatchableFile(const std::string& region, const MemoryRegionInfo& info) const {
+    // Pseudo-files change without generating inotify events.
+    return region.find("/") == 0 && region.find("/proc/") != 0 && !info.streamed;
+}
+
+bool MemoryMonitor::startFileWatching() {
+    // The watcher thread is started and stopped outside the state lock:
+    // its handler takes that lock, so joining it while holding the lock
+    // could deadlock.
+    if (!file_watcher_.start([this](const std::string& path) { onWatchedFileChanged(path); })) {
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    size_t watched = 0;
+    for (RegionId id : regions_->protectedIds()) {
+        RegionState* state = regions_->state(id);
+        bool watchable;
+        {
+            std::lock_guard<std::mutex> regionLock(state->lock);
+            watchable = isWatchableFile(regions_->name(id), state->info);
+        }
+        if (watchable && file_watcher_.addWatch(regions_->name(id))) {
+            watched++;
+        }
+    }
+    LOGI("Watching %zu protected files for changes", watched);
+    return true;
+}
+
+void MemoryMonitor::stopFileWatching() {
+    file_watcher_.stop();
+}
+
+bool MemoryMonitor::isFileWatching() const {
+    return file_watcher_.isRunning();
+}
+
+void MemoryMonitor::onWatchedFileChanged(const std::string& path) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionId id = table->find(path);
+    if (!is_monitoring_ || !table->state(id)) {
+        return;
+    }
+
+    LOGI("Protected file %s changed, rescanning", path.c_str());
+    TraceRing::instance().record(TRACE_FILE_EVENT, id, 0, 0);
+    scanRegion(*table, id, *loadSettings(), nullptr);
+}
+
+void MemoryMonitor::onWriteTrapped(RegionId id) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    RegionState* state = table->state(id);
+    if (!is_monitoring_ || !state) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state->lock);
+        state->info.scans_until_rehash = 0;
+    }
+    LOGI("Write trapped in protected region %s, rescanning", table->name(id).c_str());
+    TraceRing::instance().record(TRACE_WRITE_TRAP, id, 0, 0);
+    scanRegion(*table, id, *loadSettings(), nullptr);
+}
+
+void MemoryMonitor::disarmWriteTrap(RegionState& state) {
+    void* address;
+    {
+        std::lock_guard<std::mutex> lock(state.lock);
+        if (!state.info.write_trapped) {
+            return;
+        }
+        state.info.write_trapped = false;
+        address = state.info.address;
+    }
+    // disarm() waits for a running handler, which locks the region to scan it.
+    WriteTrap::instance().disarm(address);
+}
+
+void MemoryMonitor::runScheduledScan() {
+    // The scheduler outlives stop/startMonitoring; ticks are idle until
+    // monitoring is active again.
+    if (!is_monitoring_) {
+        return;
+    }
+
+    std::shared_ptr<const ScanSettings> settings = loadSettings();
+    if (adaptive_scanning_) {
+        runAdaptiveScan(*settings);
+        return;
+    }
+    if (!settings->policy.critical_regions_only) {
+        scanAllProtectedRegions();
+        return;
+    }
+
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    for (RegionId id : table->protectedIds()) {
+        if (table->isCritical(id)) {
+            scanRegion(*table, id, *settings, nullptr);
+        }
+    }
+}
+
+void MemoryMonitor::runAdaptiveScan(const ScanSettings& settings) {
+    std::shared_ptr<const RegionTable> table = loadRegions();
+    std::vector<ScanRateController::Candidate> candidates;
+    candidates.reserve(table->protectedIds().size());
+    for (RegionId id : table->protectedIds()) {
+        bool critical = table->isCritical(id);
+        if (settings.policy.critical_regions_only && !critical) {
+            continue;
+        }
+        RegionState* state = table->state(id);
+        std::lock_guard<std::mutex> lock(state->lock);
+        candidates.push_back(ScanRateController::Candidate{id, state->info.size, critical});
+    }
+
+    std::vector<RegionId> selected;
+    scan_rate_.plan(candidates, selected);
+    for (RegionId id : selected) {
+        scanRegion(*table, id, settings, nullptr);
+    }
+    scan_scheduler_.setInterval(scan_rate_.interval());
+}
+
+// Verifies a chunk sub-range of a file region by reading just that window.
+// The task that owns chunk 0 also checks the file size, so a resized file
+// is reported once.
+static bool verifyFileChunkRange(const std::string& region, const MemoryRegionInfo& info,
+                                 size_t firstChunk, size_t chunkCount, bool stopAtFirst,
+                                 std::vector<size_t>& changed, std::vector<TamperReport>& reports,
+                                 VerifyStats& stats, ScanScratch& scratch) {
+    DetailBuffer& details = scratch.details;
+    details.clear();
+
+    int fd = open(region.c_str(), O_RDONLY);
+    // open, and close on success.
+    stats.syscalls += fd == -1 ? 1 : 2;
+    if (fd == -1) {
+        if (firstChunk == 0) {
+            LOGE("Failed to open file %s for scanning: %s", 
+                               region.c_str(), strerror(errno));
+            details.append("File cannot be opened: ").append(region).append(", Error: ").append(strerror(errno));
+            reports.push_back(TamperReport{region, details.str()});
+        }
+        return false;
+    }
+
+    if (firstChunk == 0) {
+        struct stat st;
+        stats.syscalls++;
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) != info.size) {
+            close(fd);
+            LOGW("File size changed for %s: original=%zu, current=%zu", 
+                               region.c_str(), info.size, (size_t)st.st_size);
+            details.append("File size changed: ").append(region)
+                   .append(", Original size: ").appendNumber(info.size)
+                   .append(", Current size: ").appendNumber(st.st_size);
+            reports.push_back(TamperReport{region, details.str()});
+            return false;
+        }
+    }
+
+    size_t offset = firstChunk * info.chunk_size;
+    size_t length = std::min(info.size - offset, chunkCount * info.chunk_size);
+    PageBuffer& window = scratch.io;
+    if (!window.reserve(length)) {
+        LOGE("Failed to allocate a %zu byte read window for %s", length, region.c_str());
+        close(fd);
+        return false;
+    }
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = pread(fd, window.data() + done, length - done, static_cast<off_t>(offset + done));
+        stats.syscalls++;
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    // A short read leaves the tail chunks empty, which then fail to match.
+    size_t before = changed.size();
+    stats.bytes_hashed += done;
+    merkleFindChangedChunks(window.data(), done, info.chunk_size,
+                            info.chunk_hashes.data() + firstChunk * SHA256_DIGEST_LENGTH,
+                            0, chunkCount, stopAtFirst, changed);
+    for (size_t i = before; i < changed.size(); i++) {
+        changed[i] += firstChunk;
+    }
+    return true;
+}
+
+void MemoryMonitor::scanRegionsInParallel(const RegionTable& table, const ScanSettings& settings,
+                                          std::vector<RegionId>& compromised) {
+    std::unique_lock<std::mutex> poolLock(pool_mutex_);
+    if (!scan_pool_) {
+        size_t cores = ScanThreadPool::bigCoreCount();
+        scan_pool_.reset(new ScanThreadPool(cores > 1 ? cores - 1 : 0));
+    }
+
+    ScanArena<ScanScratch>::Lease scratch(scan_arena_);
+    ScanScratch& work = *scratch;
+
+    // Sub-range tasks of one region share its info, so only a split region
+    // is held locked for the whole run; every other region is locked by its
+    // own task, as on the serial path. Split locks are taken in address
+    // order, the same order compareMemoryRegions uses, so the two cannot
+    // deadlock.
+    const std::vector<RegionId>& ids = table.protectedIds();
+    size_t count = ids.size();
+    work.lock_order.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (table.state(ids[i])) {
+            work.lock_order.push_back(i);
+        }
+    }
+    std::sort(work.lock_order.begin(), work.lock_order.end(), [&table, &ids](size_t a, size_t b) {
+        return table.state(ids[a]) < table.state(ids[b]);
+    });
+
+    uint64_t startNs = TraceRing::nowNs();
+    work.region_locks.clear();
+    work.infos.assign(count, nullptr);
+    // Pre-scan metadata of split files, adopted as their stamp if they verify.
+    work.split_stamps.resize(count);
+    work.has_split_stamp.assign(count, 0);
+    work.split_syscalls.assign(count, 0);
+    work.split_hashed.assign(count, 0);
+    work.tasks.clear();
+    for (size_t i : work.lock_order) {
+        RegionState* state = table.state(ids[i]);
+        std::unique_lock<std::mutex> lock(state->lock);
+
+        const std::string& region = table.name(ids[i]);
+        MemoryRegionInfo& info = state->info;
+        work.infos[i] = &info;
+        size_t chunkCount = info.chunk_hashes.size() / SHA256_DIGEST_LENGTH;
+        // Trapped regions stay whole so verifyRegion can apply their cadence.
+        bool splittable = info.chunk_size > 0 && !info.incremental && !info.write_trapped &&
+                          region.find("/proc/") != 0 && chunkCount > kChunksPerScanTask;
+
+        if (!splittable) {
+            work.tasks.push_back(ParallelScanTask{i, 0, 0, true, {}, {}, {}, 0, false});
+            continue;
+        }
+        
+        // An unchanged file, or a region another monitor has just verified,
+        // needs no sub-range tasks at all.
+        struct stat st;
+        bool skip = false;
+        if (region.find("/") == 0 && stat(region.c_str(), &st) == 0) {
+            work.split_syscalls[i] = 1;
+            if (canSkipFileHash(settings.policy, info, st) ||
+                reuseSharedVerification(this, settings.policy, region, info, &st)) {
+                skip = true;
+            } else {
+                work.split_stamps[i] = fileStampOf(st);
+                work.has_split_stamp[i] = 1;
+            }
+        } else if (info.code && reuseSharedVerification(this, settings.policy, region, info, nullptr)) {
+            skip = true;
+        }
+        if (skip) {
+            VerifyStats stats;
+            stats.syscalls = work.split_syscalls[i];
+            recordScan(ids[i], info, startNs, 0, stats, true);
+            continue;
+        }
+
+        work.split_hashed[i] = 1;
+        for (size_t first = 0; first < chunkCount; first += kChunksPerScanTask) {
+            work.tasks.push_back(ParallelScanTask{i, first, std::min(kChunksPerScanTask, chunkCount - first),
+                                                  true, {}, {}, {}, 0, false});
+        }
+        work.region_locks.push_back(std::move(lock));
+    }
+
+    bool stopAtFirst = settings.chunking.stop_at_first_mismatch;
+    // The task captures just two pointers, small enough for std::function
+    // to store inline instead of allocating per pass.
+    struct PassContext {
+        const RegionTable& table;
+        const ScanSettings& settings;
+        ScanScratch& work;
+        bool stopAtFirst;
+    } pass = {table, settings, work, stopAtFirst};
+    scan_pool_->run(work.tasks.size(), [this, &pass](size_t index) {
+        ParallelScanTask& task = pass.work.tasks[index];
+        RegionId id = pass.table.protectedIds()[task.region];
+        const std::string& region = pass.table.name(id);
+        MemoryRegionInfo& info = *pass.work.infos[task.region];
+        uint64_t taskStart = TraceRing::nowNs();
+
+        if (task.chunk_count == 0) {
+            // Blocking here while this pass holds split locks could deadlock
+            // against a caller nesting this region's lock with one of them.
+            std::unique_lock<std::mutex> lock(pass.table.state(id)->lock, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                task.deferred = true;
+                return;
+            }
+            task.intact = verifyRegion(region, info, pass.settings, task.reports, &task.stats);
+            task.duration_ns = TraceRing::nowNs() - taskStart;
+            recordScan(id, info, taskStart, task.duration_ns, task.stats, task.intact);
+            return;
+        } else if (region.find("/") == 0) {
+            ScanArena<ScanScratch>::Lease taskScratch(scan_arena_);
+            task.intact = verifyFileChunkRange(region, info, task.first_chunk, task.chunk_count,
+                                               pass.stopAtFirst, task.changed, task.reports, task.stats,
+                                               *taskScratch);
+        } else {
+            merkleFindChangedChunks(static_cast<const uint8_t*>(info.address), info.size, info.chunk_size,
+                                    info.chunk_hashes.data(), task.first_chunk, task.chunk_count,
+                                    pass.stopAtFirst, task.changed);
+            task.stats.bytes_hashed += std::min(info.size - task.first_chunk * info.chunk_size,
+                                                task.chunk_count * info.chunk_size);
+        }
+        task.duration_ns = TraceRing::nowNs() - taskStart;
+    });
+
+    // Results are merged and delivered on the calling thread, in region order.
+    work.intact.assign(count, 1);
+    work.region_changed.resize(count);
+    work.region_reports.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        work.region_changed[i].clear();
+        work.region_reports[i].clear();
+    }
+    work.region_stats.assign(count, VerifyStats());
+    work.durations.assign(count, 0);
+    for (auto& task : work.tasks) {
+        size_t i = task.region;
+        work.intact[i] = work.intact[i] && task.intact;
+        work.region_reports[i].insert(work.region_reports[i].end(), std::make_move_iterator(task.reports.begin()),
+                                      std::make_move_iterator(task.reports.end()));
+        if (task.chunk_count == 0) {
+            continue;
+        }
+        work.region_stats[i].bytes_hashed += task.stats.bytes_hashed;
+        work.region_stats[i].syscalls += task.stats.syscalls;
+        work.region_stats[i].changed_chunks += task.stats.changed_chunks;
+        work.durations[i] += task.duration_ns;
+        work.region_changed[i].insert(work.region_changed[i].end(), task.changed.begin(), task.changed.end());
+    }
+
+    // Whole regions were checked and recorded by their own tasks; only the
+    // split ones are finished here, while their locks are still held.
+    for (size_t i = 0; i < count; i++) {
+        if (!work.split_hashed[i]) {
+            continue;
+        }
+        const std::string& region = table.name(ids[i]);
+        MemoryRegionInfo* info = work.infos[i];
+
+        // A failed sub-range (unreadable or resized file) has already been
+        // reported; chunk mismatches are only meaningful otherwise.
+        std::vector<size_t>& changed = work.region_changed[i];
+        bool isFile = region.find("/") == 0;
+        if (work.intact[i] && !changed.empty()) {
+            std::sort(changed.begin(), changed.end());
+            if (stopAtFirst) {
+                changed.resize(1);
+            }
+
+            LOGW("SECURITY ALERT: %s tampering detected for %s",
+                                isFile ? "File" : "Memory", region.c_str());
+            if (!isFile) {
+                restoreReadOnly(region, *info, work.region_stats[i]);
+            }
+            DetailBuffer& details = work.details;
+            details.clear();
+            details.append(isFile ? "File content tampered: " : "Memory region tampered: ")
+                   .append(region).append(", ");
+            appendChangedChunks(details, changed, info->chunk_size);
+            work.region_reports[i].push_back(TamperReport{region, details.str()});
+            work.intact[i] = 0;
+        }
+
+        // Split regions are charged the summed time of their sub-range tasks.
+        work.region_stats[i].syscalls += work.split_syscalls[i];
+        work.region_stats[i].changed_chunks += changed.size();
+        recordScan(ids[i], *info, startNs, work.durations[i], work.region_stats[i], work.intact[i]);
+
+        if (work.intact[i] && work.has_split_stamp[i]) {
+            info->stamp = work.split_stamps[i];
+            info->has_stamp = true;
+        }
+        if (sharesVerification(settings.policy, region, *info)) {
+            if (!work.intact[i]) {
+                ScanCoordinator::instance().invalidate(region);
+            } else {
+                ScanCoordinator::instance().publish(this, region, info->chunk_size, info->hash,
+                                                    info->has_stamp ? &info->stamp : nullptr, TraceRing::nowNs());
+            }
+        }
+    }
+    work.region_locks.clear();
+
+    for (auto& task : work.tasks) {
+        if (!task.deferred) {
+            continue;
+        }
+        size_t i = task.region;
+        RegionState* state = table.state(ids[i]);
+        std::lock_guard<std::mutex> lock(state->lock);
+        uint64_t taskStart = TraceRing::nowNs();
+        VerifyStats stats;
+        work.intact[i] = verifyRegion(table.name(ids[i]), state->info, settings, work.region_reports[i], &stats);
+        recordScan(ids[i], state->info, taskStart, TraceRing::nowNs() - taskStart, stats, work.intact[i]);
+    }
+
+    work.reports.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (!work.infos[i]) {
+            LOGE("Cannot scan region %s - region not found", table.name(ids[i]).c_str());
+            compromised.push_back(ids[i]);
+            continue;
+        }
+        if (!work.intact[i]) {
+            compromised.push_back(ids[i]);
+        }
+        work.reports.insert(work.reports.end(), std::make_move_iterator(work.region_reports[i].begin()),
+                            std::make_move_iterator(work.region_reports[i].end()));
+    }
+    poolLock.unlock();
+
+    for (const auto& report : work.reports) {
+        notifyTampering(report.region, report.details);
+    }
+}
@@ -17,57 +17,329 @@
 #ifndef APP_PROTECTION_MEMORY_MONITOR_H
 #define APP_PROTECTION_MEMORY_MONITOR_H
 
-#include <jni.h>
 #include <string>
 #include <vector>
 #include <functional>
-#include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
+#include "file_watcher.h"
+#include "golden_manifest.h"
+#include "proc_parser.h"
+#include "region_table.h"
+#include "scan_arena.h"
+#include "scan_rate_controller.h"
+#include "scan_scheduler.h"
+#include "scan_thread_pool.h"
+#include "tamper_event_queue.h"
+#include "work_queue.h"
 
 typedef std::function<void(const std::string&, const std::string&)> TamperingCallback;
+// Called on the baseline worker thread with the region and whether it is now protected.
+typedef std::function<void(const std::string&, bool)> ProtectCompletion;
+
+struct TamperReport;
+struct ScanScratch;
+
+/**
+ * Optional chunked (Merkle tree) hashing for large regions. Regions of at
+ * least `min_region_size` bytes protected while chunking is enabled keep a
+ * digest per `chunk_size` bytes, so a scan can report which offsets changed.
+ */
+struct ChunkingConfig {
+    // Chunk size in bytes; 0 disables chunked hashing.
+    size_t chunk_size = 0;
+    size_t min_region_size = 64 * 1024;
+    // Stop a scan at the first changed chunk instead of locating all of them.
+    bool stop_at_first_mismatch = true;
+};
+
+/**
+ * Regular files of at least `min_file_size` bytes are read in blocks of
+ * `block_size` bytes instead of being mapped whole, which bounds the memory
+ * a scan of a very large file needs to one block.
+ */
+struct StreamingConfig {
+    // 0 maps every file regardless of size.
+    size_t min_file_size = 32 * 1024 * 1024;
+    // Rounded down to whole chunks for chunked regions.
+    size_t block_size = 1024 * 1024;
+};
+
+/**
+ * Controls what the native scan scheduler does on every tick.
+ */
+struct ScanPolicy {
+    // Only scan protected regions that are also registered as critical.
+    bool critical_regions_only = false;
+    // Skip rehashing files whose device, inode, size, mtime and ctime are
+    // unchanged since their last verified hash.
+    bool skip_unchanged_files = false;
+    // With skip_unchanged_files, still rehash such a file on every Nth scan;
+    // 0 never forces a rehash.
+    uint32_t deep_scan_interval = 16;
+    // Randomize each file's deep-scan cadence between N/2 and 3N/2 scans.
+    bool jitter_deep_scans = true;
+    // Check in-process memory regions against a fast non-cryptographic hash
+    // and only fall back to SHA-256 on a mismatch or every Nth scan.
+    bool fast_hash_memory = false;
+    // With fast_hash_memory, run the SHA-256 check on every Nth scan; 0 or 1
+    // runs it on every scan.
+    uint32_t full_hash_interval = 8;
+    // Regions armed for write trapping report writes as they happen, so
+    // scans only rehash them every Nth pass to catch writes that got around
+    // the trap; 0 or 1 rehashes on every scan.
+    uint32_t trapped_rehash_interval = 16;
+    // Soft-dirty bits can be cleared by anyone in the process, so regions
+    // scanned incrementally still rehash every page on every Nth scan; 0 or
+    // 1 rehashes them in full on every scan.
+    uint32_t incremental_full_scan_interval = 16;
+    // Files and library text verified by another MemoryMonitor in this
+    // process within this many milliseconds, against the same baseline and
+    // file metadata, are not hashed again; 0 hashes them regardless.
+    uint32_t shared_result_max_age_ms = 1000;
+};
+
+/**
+ * Outcome of one region in a batched scan.
+ */
+enum RegionScanStatus {
+    REGION_SCAN_INTACT = 0,
+    REGION_SCAN_TAMPERED = 1,
+    REGION_SCAN_NOT_FOUND = 2,
+    REGION_SCAN_NOT_MONITORING = 3
+};
+
+// Difference offsets reported by compareMemoryRegions().
+static const int64_t kRegionsIdentical = -1;
+static const int64_t kRegionsNotComparable = -2;
+
+struct RegionScanResult {
+    int status = REGION_SCAN_NOT_FOUND;
+    int64_t elapsed_ns = 0;
+    // Changed chunks located in a chunked region; 0 for whole-region hashes.
+    size_t changed_chunks = 0;
+};
+
+/**
+ * Scan-path configuration, replaced as a whole whenever a setter changes it.
+ */
+struct ScanSettings {
+    ScanPolicy policy;
+    ChunkingConfig chunking;
+    StreamingConfig streaming;
+};
 
 class MemoryMonitor {
 public:
     MemoryMonitor();
+    // Must not run on one of the monitor's own threads (see isOwnThread()),
+    // which would still be using it after it is freed.
     ~MemoryMonitor();
+    // True on the scan scheduler, file watcher, baseline worker or tamper
+    // event dispatcher of this monitor, e.g. inside a tampering callback.
+    bool isOwnThread() const;
 
     bool startMonitoring();
     void stopMonitoring();
     bool isMonitoring() const;
     
     bool scanMemoryRegion(const std::string& region);
-    bool compareMemoryRegions(const std::string& region1, const std::string& region2);
+    // Id-based variant for hot paths; ids come from getRegionId().
+    bool scanMemoryRegion(RegionId id);
+    RegionId getRegionId(const std::string& region) const;
+    // Scans each region in order against one snapshot of the region table.
+    void scanMemoryRegions(const std::vector<RegionId>& ids, std::vector<RegionScanResult>& results);
+    // Compares the stored baseline digests, chunk by chunk where both are
+    // chunked alike. `deep` compares the current bytes instead. When given,
+    // `firstDifference` receives the offset where the regions diverge (the
+    // differing chunk for digests, 0 for whole-region digests) or one of
+    // kRegionsIdentical / kRegionsNotComparable.
+    bool compareMemoryRegions(const std::string& region1, const std::string& region2, bool deep = false,
+                              int64_t* firstDifference = nullptr);
+    // Members must be protected with identical baselines. A group scan
+    // rehashes one member in full, rotating through them, and checks the
+    // others by baseline digest and, for files, unchanged metadata.
+    bool createRegionGroup(const std::string& group, const std::vector<std::string>& members);
+    void removeRegionGroup(const std::string& group);
+    bool scanRegionGroup(const std::string& group);
     bool scanAllProtectedRegions();
+
+    bool startScanScheduler(long interval_ms, const ScanPolicy& policy);
+    void stopScanScheduler();
+    bool isScanSchedulerRunning() const;
+    // Event-driven mode: protected files get an inotify watch and are
+    // rescanned as soon as they change. Polling can stay on as a backstop.
+    bool startFileWatching();
+    void stopFileWatching();
+    bool isFileWatching() const;
+    // Adaptive mode: every scheduler tick scans the time slice of regions
+    // ScanRateController picks, and the interval follows the device state
+    // and recent tampering. Disabling it restores the scheduler's interval.
+    void setAdaptiveScanning(bool enabled, const AdaptiveScanConfig& config);
+    void setDeviceState(const DeviceState& state);
+
+    // The policy is shared by scheduled and on-demand scans.
+    void setScanPolicy(const ScanPolicy& policy);
+    ScanPolicy getScanPolicy() const;
     
     void addCriticalRegion(const std::string& region);
     void removeCriticalRegion(const std::string& region);
-    const std::vector<std::string>& getCriticalRegions() const;
+    std::vector<std::string> getCriticalRegions() const;
     
     bool protectMemoryRegion(const std::string& region);
+    // Queues the baseline capture on a native worker and returns at once;
+    // false means nothing was queued and `completion` will not run. The
+    // region stays pending, and is skipped by scans, until it completes.
+    bool protectMemoryRegionAsync(const std::string& region, ProtectCompletion completion);
+    bool isRegionPending(const std::string& region) const;
     bool unprotectMemoryRegion(const std::string& region);
-    const std::vector<std::string>& getProtectedRegions() const;
+    // Protects each region in order; ids[i] is kInvalidRegionId if regions[i] failed.
+    void protectMemoryRegions(const std::vector<std::string>& regions, bool critical, std::vector<RegionId>& ids);
+    // Protects files and "elf:" regions with the baselines their golden
+    // manifest entries record (see manifestNameOf()), without hashing them,
+    // then verifies them once against those baselines on the baseline
+    // worker. ids[i] is kInvalidRegionId if regions[i] has no usable entry.
+    void protectFromManifest(const std::vector<std::string>& regions, std::vector<RegionId>& ids);
+    // Replaces the embedded manifest; its data must stay mapped while the
+    // monitor uses it.
+    void setGoldenManifest(const GoldenManifest& manifest);
+    std::vector<std::string> getProtectedRegions() const;
+    
+    // Packed metrics snapshot, see nativeGetScanMetrics for the layout.
+    void getScanMetrics(std::vector<int64_t>& packed) const;
+    
+    // Warm start: snapshot the baselines of protected files, and later
+    // restore those whose stat metadata still matches instead of rehashing
+    // them. Restored files are fully rehashed by their next scan.
+    bool saveBaseline(const std::string& path, const std::vector<uint8_t>& key) const;
+    bool loadBaseline(const std::string& path, const std::vector<uint8_t>& key, size_t* restored = nullptr);
     
     bool isSystemFile(const std::string& path) const;
     bool scanSystemFile(const std::string& path);
     
     bool simulateMemoryTampering(const std::string& region);
     
+    void setChunkingConfig(const ChunkingConfig& config);
+    void setStreamingConfig(const StreamingConfig& config);
+    // Anonymous regions protected while enabled are rescanned page by page,
+    // only rehashing pages the kernel reports as soft-dirty.
+    void setIncrementalScanning(bool enabled);
+    // Spreads scanAllProtectedRegions() across a pool sized to the big cores,
+    // splitting large chunked regions into sub-ranges.
+    void setParallelScanning(bool enabled);
+    // Anonymous regions protected while enabled trap write attempts through
+    // SIGSEGV and are rescanned right away; see WriteTrap.
+    bool setWriteTrapping(bool enabled);
+
+    // Called synchronously on the scanning thread for every event.
     void setTamperingCallback(TamperingCallback callback);
+    // Called on a dedicated dispatcher thread with the events of one
+    // coalescing window; scans only enqueue. `hooks` run on that thread
+    // when it starts and exits.
+    void setTamperingBatchCallback(TamperingBatchCallback callback,
+                                   const DispatcherHooks& hooks = DispatcherHooks());
     
     void notifyTampering(const std::string& region, const std::string& details);
 
 private:
-    bool is_monitoring_;
-    std::vector<std::string> critical_regions_;
-    std::vector<std::string> protected_regions_;
-    TamperingCallback tampering_callback_;
-    std::map<std::string, std::set<std::string>> system_file_critical_lines_;
+    std::atomic<bool> is_monitoring_;
+    // The published region table. Writers (protect, unprotect, critical
+    // regions) change a copy under state_mutex_ and publish it with
+    // std::atomic_store; scans load whichever table is current and work on
+    // it without ever taking state_mutex_, locking only the regions they
+    // verify. Registrations therefore never wait for a scan to finish.
+    std::shared_ptr<const RegionTable> regions_;
+    // While a batch registration runs, the one copy all its writers change
+    // in place; it is published once when the batch ends.
+    std::shared_ptr<RegionTable> batch_regions_;
+    std::shared_ptr<const TamperingCallback> tampering_callback_;
+    // Policy and chunking, published the same way as the region table.
+    std::shared_ptr<const ScanSettings> settings_;
+
+    // Serializes writers. Recursive because batch calls and stopMonitoring
+    // are built from the single-region calls.
+    mutable std::recursive_mutex state_mutex_;
+    ScanScheduler scan_scheduler_;
+    std::atomic<bool> incremental_scanning_;
+    std::atomic<bool> parallel_scanning_;
+    std::atomic<bool> write_trapping_;
+    std::atomic<bool> adaptive_scanning_;
+    // Interval the scheduler was started with.
+    std::atomic<long> scan_interval_ms_;
+    ScanRateController scan_rate_;
+    // Guarded by state_mutex_.
+    GoldenManifest manifest_;
+    // Guards scan_pool_; parallel scans already use every big core, so
+    // concurrent ones take turns.
+    std::mutex pool_mutex_;
+    std::unique_ptr<ScanThreadPool> scan_pool_;
+    // Reusable per-scan buffers; see ScanScratch in memory_monitor.cpp.
+    ScanArena<ScanScratch> scan_arena_;
+    FileWatcher file_watcher_;
+    WorkQueue baseline_queue_;
+    TamperEventQueue tamper_events_;
+    std::set<RegionId> pending_regions_;
+
+    LatencyHistogram scan_latency_;
+    LatencyHistogram protect_latency_;
+    LatencyHistogram scan_all_latency_;
+    std::atomic<uint64_t> bytes_hashed_;
+    std::atomic<uint64_t> syscalls_;
+    std::atomic<uint64_t> mismatches_;
+
+    std::shared_ptr<const RegionTable> loadRegions() const;
+    std::shared_ptr<const ScanSettings> loadSettings() const;
+    // Copy of the current table for a writer to change; state_mutex_ held.
+    std::shared_ptr<RegionTable> copyRegions() const;
+    void publishRegions(const std::shared_ptr<RegionTable>& table);
+    // State of `region` as writers see it, including an unpublished batch;
+    // state_mutex_ held.
+    RegionState* writerState(const std::string& region) const;
+
+    void runScheduledScan();
+    void runAdaptiveScan(const ScanSettings& settings);
+    void onWatchedFileChanged(const std::string& path);
+    void onWriteTrapped(RegionId id);
+    // Takes the region's lock; must not be called with it held.
+    void disarmWriteTrap(RegionState& state);
+    bool isWatchableFile(const std::string& region, const MemoryRegionInfo& info) const;
+    // Callers hold the region's lock. `digest`, when given, is the SHA-256
+    // of an unchunked memory region's current contents, already computed by
+    // hashMemoryRegionsBatch.
+    bool verifyRegion(const std::string& region, MemoryRegionInfo& info, const ScanSettings& settings,
+                      std::vector<TamperReport>& reports, VerifyStats* stats = nullptr,
+                      const uint8_t* digest = nullptr);
+    // verifyRegion() without the ScanCoordinator bookkeeping.
+    bool verifyRegionContents(const std::string& region, MemoryRegionInfo& info, const ScanSettings& settings,
+                              std::vector<TamperReport>& reports, VerifyStats& stats, const uint8_t* digest);
+    bool verifyCriticalLines(const std::string& region, ProcFileKind kind, MemoryRegionInfo& info,
+                             std::vector<TamperReport>& reports, VerifyStats& stats);
+    bool scanRegion(const RegionTable& table, RegionId id, const ScanSettings& settings, const uint8_t* digest);
+    void hashMemoryRegionsBatch(const RegionTable& table, const ScanSettings& settings, ScanScratch& work);
+    void recordScan(RegionId id, MemoryRegionInfo& info, uint64_t startNs, uint64_t durationNs,
+                    const VerifyStats& stats, bool intact);
+    bool protectRegion(const std::string& region);
+    bool protectCodeRegion(const std::shared_ptr<RegionTable>& table, RegionId id, const std::string& region);
+    void installFileRegion(RegionId id, const MemoryRegionInfo& info);
+    bool protectManifestRegion(const std::shared_ptr<RegionTable>& table, RegionId id, const std::string& region,
+                               const ManifestEntry& entry);
+    void verifyManifestRegions(const std::vector<RegionId>& ids);
+    bool completeAsyncProtect(const std::string& region, RegionId id);
+    void scanRegionsInParallel(const RegionTable& table, const ScanSettings& settings,
+                               std::vector<RegionId>& compromised);
+    // Appends the changed chunks to scratch.changed.
+    bool scanDirtyChunks(const MemoryRegionInfo& info, bool stopAtFirst, ScanScratch& scratch,
+                         VerifyStats& stats);
     
     bool readMemoryRegion(const std::string& region, void* buffer, size_t size);
     bool writeMemoryRegion(const std::string& region, const void* buffer, size_t size);
     bool getMemoryRegionInfo(const std::string& region, void* info);
     
-    bool extractCriticalLines(const std::string& path, std::string& content);
+    // Canonical text of the security-relevant fields of a proc file, one
+    // per line, as parsed by parseProcFile().
+    bool extractCriticalLines(const std::string& path, std::string& content, uint32_t* syscalls = nullptr);
 };
 
 #endif
\ No newline at end of file
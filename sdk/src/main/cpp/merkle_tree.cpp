@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "merkle_tree.h"
+#include <openssl/sha.h>
+#include <cstring>
+
+static const uint8_t kMerkleNodePrefix = 0x01;
+
+size_t merkleChunkCount(size_t size, size_t chunk_size) {
+    if (chunk_size == 0) {
+        return 0;
+    }
+    return size == 0 ? 1 : (size + chunk_size - 1) / chunk_size;
+}
+
+static void hashChunk(const uint8_t* data, size_t size, size_t chunk_size, size_t index, uint8_t* digest) {
+    size_t offset = index * chunk_size;
+    size_t length = offset < size ? size - offset : 0;
+    if (length > chunk_size) {
+        length = chunk_size;
+    }
+
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    if (length > 0) {
+        SHA256_Update(&sha256, data + offset, length);
+    }
+    SHA256_Final(digest, &sha256);
+}
+
+void merkleHashChunks(const uint8_t* data, size_t size, size_t chunk_size,
+                      size_t first_chunk, size_t count, uint8_t* digests) {
+    for (size_t i = 0; i < count; i++) {
+        hashChunk(data, size, chunk_size, first_chunk + i, digests + i * SHA256_DIGEST_LENGTH);
+    }
+}
+
+void merkleRoot(const uint8_t* digests, size_t count, uint8_t* root) {
+    if (count == 0) {
+        SHA256_CTX sha256;
+        SHA256_Init(&sha256);
+        SHA256_Final(root, &sha256);
+        return;
+    }
+
+    std::vector<uint8_t> level(digests, digests + count * SHA256_DIGEST_LENGTH);
+
+    // A single chunk still goes through one node hash so the root of a
+    // one-chunk region differs from the plain SHA-256 of its contents.
+    do {
+        size_t parents = (count + 1) / 2;
+        for (size_t i = 0; i < parents; i++) {
+            const uint8_t* left = &level[2 * i * SHA256_DIGEST_LENGTH];
+            uint8_t* out = &level[i * SHA256_DIGEST_LENGTH];
+
+            if (2 * i + 1 < count || count == 1) {
+                SHA256_CTX sha256;
+                SHA256_Init(&sha256);
+                SHA256_Update(&sha256, &kMerkleNodePrefix, 1);
+                SHA256_Update(&sha256, left, SHA256_DIGEST_LENGTH);
+                if (2 * i + 1 < count) {
+                    SHA256_Update(&sha256, left + SHA256_DIGEST_LENGTH, SHA256_DIGEST_LENGTH);
+                }
+                SHA256_Final(out, &sha256);
+            } else {
+                // Odd node out is promoted to the next level unchanged.
+                memmove(out, left, SHA256_DIGEST_LENGTH);
+            }
+        }
+        count = parents;
+    } while (count > 1);
+
+    memcpy(root, level.data(), SHA256_DIGEST_LENGTH);
+}
+
+size_t merkleFindChangedChunks(const uint8_t* data, size_t size, size_t chunk_size,
+                               const uint8_t* baseline, size_t first_chunk, size_t count,
+                               bool stop_at_first, std::vector<size_t>& changed) {
+    size_t found = 0;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    for (size_t i = first_chunk; i < first_chunk + count; i++) {
+        hashChunk(data, size, chunk_size, i, digest);
+        if (memcmp(digest, baseline + i * SHA256_DIGEST_LENGTH, SHA256_DIGEST_LENGTH) != 0) {
+            changed.push_back(i);
+            found++;
+            if (stop_at_first) {
+                break;
+            }
+        }
+    }
+
+    return found;
+}
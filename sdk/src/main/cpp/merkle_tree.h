@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_MERKLE_TREE_H
+#define APP_PROTECTION_MERKLE_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Chunked hashing for large regions. A region is split into fixed-size
+ * chunks, each chunk gets its own SHA-256 digest, and the digests are folded
+ * into a binary Merkle tree whose root stands in for the whole-region hash.
+ * Keeping the per-chunk digests lets a scan localize a change to a chunk
+ * offset instead of only reporting that the region differs.
+ */
+
+size_t merkleChunkCount(size_t size, size_t chunk_size);
+
+// Hashes chunks [first_chunk, first_chunk + count) of `data` into `digests`,
+// which receives SHA256_DIGEST_LENGTH bytes per chunk.
+void merkleHashChunks(const uint8_t* data, size_t size, size_t chunk_size,
+                      size_t first_chunk, size_t count, uint8_t* digests);
+
+// Folds `count` chunk digests into the tree root. Interior nodes are hashed
+// with a one-byte prefix so they cannot collide with a chunk digest.
+void merkleRoot(const uint8_t* digests, size_t count, uint8_t* root);
+
+// Rehashes chunks [first_chunk, first_chunk + count) and compares them with
+// `baseline`, the full per-chunk digest array. Indexes of chunks that differ
+// are appended to `changed`. Returns the number of changed chunks found,
+// stopping after the first one when `stop_at_first` is set.
+size_t merkleFindChangedChunks(const uint8_t* data, size_t size, size_t chunk_size,
+                               const uint8_t* baseline, size_t first_chunk, size_t count,
+                               bool stop_at_first, std::vector<size_t>& changed);
+
+#endif
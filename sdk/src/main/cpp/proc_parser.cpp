@@ -0,0 +1,267 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "proc_parser.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t kReadBlockSize = 4096;
+// Fits maps lines with any realistic path. Longer lines are cut, which
+// still yields the same field on every scan.
+const size_t kMaxLineLength = 512;
+const uint64_t kTcpStateListen = 0x0A;
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+const char* skipToken(const char* p, const char* end) {
+    while (p < end && *p != ' ' && *p != '\t') {
+        p++;
+    }
+    return p;
+}
+
+// Returns the position after the hex digits, or nullptr if there are none.
+const char* parseHex(const char* p, const char* end, uint64_t* value) {
+    uint64_t v = 0;
+    const char* start = p;
+    for (; p < end; p++) {
+        char c = *p;
+        if (c >= '0' && c <= '9') {
+            v = (v << 4) | (uint64_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            v = (v << 4) | (uint64_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            v = (v << 4) | (uint64_t)(c - 'A' + 10);
+        } else {
+            break;
+        }
+    }
+    *value = v;
+    return p == start ? nullptr : p;
+}
+
+void initField(ProcField& field, ProcFieldType type) {
+    memset(&field, 0, sizeof(field));
+    field.type = type;
+}
+
+// "TracerPid:\t1234"
+void parseStatusLine(const char* line, const char* end, ProcFieldFn fn, void* context) {
+    static const char kKey[] = "TracerPid:";
+    const size_t keyLength = sizeof(kKey) - 1;
+    if ((size_t)(end - line) < keyLength || memcmp(line, kKey, keyLength) != 0) {
+        return;
+    }
+
+    const char* p = skipSpaces(line + keyLength, end);
+    long pid = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        pid = pid * 10 + (*p - '0');
+    }
+
+    ProcField field;
+    initField(field, PROC_FIELD_TRACER_PID);
+    field.tracer_pid = pid;
+    fn(field, context);
+}
+
+// "7f0000-7f8000 r-xp 00000000 fd:00 1234    /system/lib64/libc.so"
+void parseMapsLine(const char* line, const char* end, ProcFieldFn fn, void* context) {
+    uint64_t start, stop;
+    const char* p = parseHex(line, end, &start);
+    if (!p || p >= end || *p != '-') {
+        return;
+    }
+    p = parseHex(p + 1, end, &stop);
+    if (!p) {
+        return;
+    }
+
+    p = skipSpaces(p, end);
+    if (end - p < 4 || p[2] != 'x') {
+        return;
+    }
+
+    ProcField field;
+    initField(field, PROC_FIELD_EXEC_MAPPING);
+    field.start = start;
+    field.end = stop;
+    memcpy(field.perms, p, 4);
+
+    // Offset, device and inode precede the optional path.
+    p = skipToken(p, end);
+    for (int i = 0; i < 3; i++) {
+        p = skipToken(skipSpaces(p, end), end);
+    }
+    p = skipSpaces(p, end);
+    field.text = p;
+    field.text_len = (size_t)(end - p);
+    fn(field, context);
+}
+
+// "   0: 0100007F:1F90 00000000:0000 0A ..."; the header line has no
+// slot number and is skipped by the first check.
+void parseTcpLine(const char* line, const char* end, ProcFieldFn fn, void* context) {
+    const char* p = skipSpaces(line, end);
+    const char* slotEnd = skipToken(p, end);
+    if (slotEnd == p || slotEnd[-1] != ':') {
+        return;
+    }
+
+    const char* local = skipSpaces(slotEnd, end);
+    const char* localEnd = skipToken(local, end);
+    const char* colon = (const char*)memchr(local, ':', (size_t)(localEnd - local));
+    if (!colon) {
+        return;
+    }
+    uint64_t port;
+    if (!parseHex(colon + 1, localEnd, &port)) {
+        return;
+    }
+
+    const char* remote = skipSpaces(localEnd, end);
+    uint64_t state;
+    if (!parseHex(skipSpaces(skipToken(remote, end), end), end, &state) || state != kTcpStateListen) {
+        return;
+    }
+
+    ProcField field;
+    initField(field, PROC_FIELD_LISTEN_SOCKET);
+    field.port = (unsigned)port;
+    field.text = local;
+    field.text_len = (size_t)(colon - local);
+    fn(field, context);
+}
+
+void parseLine(ProcFileKind kind, const char* line, size_t length, ProcFieldFn fn, void* context) {
+    const char* end = line + length;
+    switch (kind) {
+        case PROC_FILE_STATUS:
+            parseStatusLine(line, end, fn, context);
+            break;
+        case PROC_FILE_MAPS:
+            parseMapsLine(line, end, fn, context);
+            break;
+        case PROC_FILE_TCP:
+            parseTcpLine(line, end, fn, context);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace
+
+ProcFileKind procFileKindOf(const char* path) {
+    if (strcmp(path, "/proc/self/status") == 0) {
+        return PROC_FILE_STATUS;
+    }
+    if (strcmp(path, "/proc/self/maps") == 0) {
+        return PROC_FILE_MAPS;
+    }
+    if (strcmp(path, "/proc/net/tcp") == 0 || strcmp(path, "/proc/net/tcp6") == 0 ||
+        strcmp(path, "/proc/self/net/tcp") == 0 || strcmp(path, "/proc/self/net/tcp6") == 0) {
+        return PROC_FILE_TCP;
+    }
+    return PROC_FILE_OTHER;
+}
+
+bool parseProcFile(const char* path, ProcFileKind kind, ProcFieldFn fn, void* context,
+                   uint32_t* syscalls) {
+    if (kind == PROC_FILE_OTHER) {
+        return false;
+    }
+
+    uint32_t calls = 1;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        if (syscalls) *syscalls += calls;
+        return false;
+    }
+
+    char block[kReadBlockSize];
+    char line[kMaxLineLength];
+    size_t lineLength = 0;
+    bool ok = true;
+    for (;;) {
+        ssize_t n = read(fd, block, sizeof(block));
+        calls++;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = false;
+            break;
+        }
+        if (n == 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < n; i++) {
+            if (block[i] == '\n') {
+                parseLine(kind, line, lineLength, fn, context);
+                lineLength = 0;
+            } else if (lineLength < sizeof(line)) {
+                line[lineLength++] = block[i];
+            }
+        }
+    }
+    if (ok && lineLength > 0) {
+        parseLine(kind, line, lineLength, fn, context);
+    }
+
+    close(fd);
+    calls++;
+    if (syscalls) *syscalls += calls;
+    return ok;
+}
+
+size_t formatProcField(const ProcField& field, char* out, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    int written = 0;
+    switch (field.type) {
+        case PROC_FIELD_TRACER_PID:
+            written = snprintf(out, size, "TracerPid: %ld", field.tracer_pid);
+            break;
+        case PROC_FIELD_EXEC_MAPPING:
+            written = snprintf(out, size, "exec %llx-%llx %s %.*s",
+                               (unsigned long long)field.start, (unsigned long long)field.end,
+                               field.perms, (int)field.text_len, field.text);
+            break;
+        case PROC_FIELD_LISTEN_SOCKET:
+            written = snprintf(out, size, "listen %.*s:%u", (int)field.text_len, field.text, field.port);
+            break;
+    }
+    if (written < 0) {
+        out[0] = '\0';
+        return 0;
+    }
+    return (size_t)written < size ? (size_t)written : size - 1;
+}
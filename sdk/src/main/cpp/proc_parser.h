@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_PROC_PARSER_H
+#define APP_PROTECTION_PROC_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum ProcFileKind {
+    PROC_FILE_OTHER = 0,
+    PROC_FILE_STATUS,   // /proc/self/status
+    PROC_FILE_MAPS,     // /proc/self/maps
+    PROC_FILE_TCP       // /proc/net/tcp and tcp6
+};
+
+enum ProcFieldType {
+    PROC_FIELD_TRACER_PID,
+    PROC_FIELD_EXEC_MAPPING,
+    PROC_FIELD_LISTEN_SOCKET
+};
+
+/**
+ * One security-relevant field of a proc file. `text` points into the
+ * parser's line buffer and is only valid during the callback: the mapping
+ * path for PROC_FIELD_EXEC_MAPPING, the local address in the kernel's hex
+ * notation for PROC_FIELD_LISTEN_SOCKET.
+ */
+struct ProcField {
+    ProcFieldType type;
+    long tracer_pid;
+    uint64_t start;
+    uint64_t end;
+    char perms[5];
+    unsigned port;
+    const char* text;
+    size_t text_len;
+};
+
+typedef void (*ProcFieldFn)(const ProcField& field, void* context);
+
+ProcFileKind procFileKindOf(const char* path);
+
+// Reads `path` through fixed stack buffers and reports each relevant field
+// to `fn`, in file order. Does not allocate; lines longer than the line
+// buffer are truncated. Returns false if the file cannot be read or `kind`
+// is PROC_FILE_OTHER. Syscalls issued are added to `syscalls` when given.
+bool parseProcFile(const char* path, ProcFileKind kind, ProcFieldFn fn, void* context,
+                   uint32_t* syscalls = nullptr);
+
+// Writes the canonical one-line form of `field` ("exec 7f00-7f80 r-xp
+// /system/lib64/libc.so", "listen 00000000:8080", "TracerPid: 1234") and
+// returns its length, truncated to fit `size`.
+size_t formatProcField(const ProcField& field, char* out, size_t size);
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "region_table.h"
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "dirty_page_tracker.h"
+#include "log.h"
+
+#define TAG "RegionTable"
+
+RegionState::~RegionState() {
+    if (info.incremental) {
+        DirtyPageTracker::instance().unregisterRange(info.address);
+    }
+    if (info.address && !info.code && munmap(info.address, info.size) != 0) {
+        LOGE("Failed to unmap memory region at %p: %s", info.address, strerror(errno));
+    }
+}
+
+RegionTable::Names::Names() : count_(0) {
+    std::fill(chunks_, chunks_ + kMaxChunks, nullptr);
+}
+
+RegionTable::Names::~Names() {
+    for (std::string* chunk : chunks_) {
+        delete[] chunk;
+    }
+}
+
+RegionId RegionTable::Names::find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : kInvalidRegionId;
+}
+
+// Chunk k holds ids [(2^k - 1) << kFirstChunkBits, (2^(k+1) - 1) << kFirstChunkBits).
+RegionId RegionTable::Names::append(const std::string& name) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    size_t slot = (count_ >> kFirstChunkBits) + 1;
+    size_t chunk = 0;
+    while (slot >>= 1) {
+        chunk++;
+    }
+    if (chunk >= kMaxChunks) {
+        return kInvalidRegionId;
+    }
+    if (!chunks_[chunk]) {
+        chunks_[chunk] = new std::string[static_cast<size_t>(1) << (chunk + kFirstChunkBits)];
+    }
+    size_t first = ((static_cast<size_t>(1) << chunk) - 1) << kFirstChunkBits;
+    chunks_[chunk][count_ - first] = name;
+
+    RegionId id = static_cast<RegionId>(count_++);
+    ids_.emplace(name, id);
+    return id;
+}
+
+const std::string& RegionTable::Names::at(RegionId id) const {
+    size_t index = static_cast<size_t>(id);
+    size_t slot = (index >> kFirstChunkBits) + 1;
+    size_t chunk = 0;
+    while (slot >>= 1) {
+        chunk++;
+    }
+    size_t first = ((static_cast<size_t>(1) << chunk) - 1) << kFirstChunkBits;
+    return chunks_[chunk][index - first];
+}
+
+RegionTable::RegionTable() : names_(std::make_shared<Names>()) {
+}
+
+RegionId RegionTable::intern(const std::string& name) {
+    // The name may have been interned by a copy that was later dropped, so
+    // its id can lie past this table's slots.
+    RegionId id = names_->append(name);
+    if (id != kInvalidRegionId && static_cast<size_t>(id) >= slots_.size()) {
+        slots_.resize(static_cast<size_t>(id) + 1);
+    }
+    return id;
+}
+
+RegionId RegionTable::find(const std::string& name) const {
+    RegionId id = names_->find(name);
+    return isValid(id) ? id : kInvalidRegionId;
+}
+
+bool RegionTable::isValid(RegionId id) const {
+    return id >= 0 && static_cast<size_t>(id) < slots_.size();
+}
+
+const std::string& RegionTable::name(RegionId id) const {
+    static const std::string empty;
+    return isValid(id) ? names_->at(id) : empty;
+}
+
+RegionState* RegionTable::state(RegionId id) const {
+    return isValid(id) ? slots_[id].state.get() : nullptr;
+}
+
+RegionState& RegionTable::put(RegionId id, const MemoryRegionInfo& info) {
+    Slot& slot = slots_[id];
+    if (!slot.state) {
+        protected_.push_back(id);
+    }
+    slot.state = std::make_shared<RegionState>(info);
+    return *slot.state;
+}
+
+void RegionTable::remove(RegionId id) {
+    if (!isValid(id) || !slots_[id].state) {
+        return;
+    }
+    slots_[id].state.reset();
+    protected_.erase(std::find(protected_.begin(), protected_.end(), id));
+}
+
+void RegionTable::clear() {
+    for (auto& slot : slots_) {
+        slot.state.reset();
+    }
+    protected_.clear();
+    groups_.clear();
+}
+
+bool RegionTable::isCritical(RegionId id) const {
+    return isValid(id) && slots_[id].critical;
+}
+
+void RegionTable::setCritical(RegionId id, bool critical) {
+    if (!isValid(id) || slots_[id].critical == critical) {
+        return;
+    }
+    slots_[id].critical = critical;
+    if (critical) {
+        critical_.push_back(id);
+    } else {
+        critical_.erase(std::find(critical_.begin(), critical_.end(), id));
+    }
+}
+
+RegionGroup* RegionTable::group(const std::string& name) const {
+    auto it = groups_.find(name);
+    return it != groups_.end() ? it->second.get() : nullptr;
+}
+
+void RegionTable::putGroup(const std::string& name, const std::shared_ptr<RegionGroup>& group) {
+    groups_[name] = group;
+}
+
+void RegionTable::removeGroup(const std::string& name) {
+    groups_.erase(name);
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_REGION_TABLE_H
+#define APP_PROTECTION_REGION_TABLE_H
+
+#include <openssl/sha.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mapped_file.h"
+#include "scan_metrics.h"
+
+typedef int32_t RegionId;
+
+static const RegionId kInvalidRegionId = -1;
+
+struct MemoryRegionInfo {
+    void* address = nullptr;
+    size_t size = 0;
+    // Whole-region SHA-256, or the Merkle root when the region is chunked.
+    uint8_t hash[SHA256_DIGEST_LENGTH] = {};
+    bool is_protected = false;
+    // Non-zero when the region is hashed in chunks of this many bytes.
+    size_t chunk_size = 0;
+    std::vector<uint8_t> chunk_hashes;
+    // Page-sized chunks whose rescans are limited to soft-dirty pages.
+    bool incremental = false;
+    // Dirty-page scans left before the next full rehash of an incremental
+    // region.
+    uint32_t scans_until_sweep = 0;
+    // Loaded library text ("elf:" regions). The loader owns the mapping, so
+    // it is executable and is never unmapped by the monitor.
+    bool code = false;
+    // File whose st_size is not its content length (sysfs and the like);
+    // size changes then show up as a hash mismatch instead.
+    bool streamed = false;
+    // Metadata of a file region as of its last verified hash.
+    FileStamp stamp;
+    bool has_stamp = false;
+    // Stamp-matching scans left before the next forced rehash.
+    uint32_t scans_until_deep = 0;
+    // fastHash64 of the baseline contents, and the fast-tier scans left
+    // before the next SHA-256 check.
+    uint64_t fast_hash = 0;
+    uint32_t scans_until_full = 0;
+    // Writes to the region fault into WriteTrap, so scans only rehash it
+    // every few passes; scans_until_rehash counts down to the next one.
+    bool write_trapped = false;
+    uint32_t scans_until_rehash = 0;
+    // Canonical security-relevant fields of a proc file region, see
+    // MemoryMonitor::extractCriticalLines().
+    std::set<std::string> critical_lines;
+    RegionMetrics metrics;
+};
+
+/**
+ * State of one protected region. Scans hold `lock` while they read or
+ * update `info`. Table snapshots share the state, so it can outlive its
+ * unprotection: a region mapping allocated by the monitor is only unmapped
+ * once the last snapshot that can reach it is gone.
+ */
+struct RegionState {
+    std::mutex lock;
+    MemoryRegionInfo info;
+
+    explicit RegionState(const MemoryRegionInfo& initial) : info(initial) {}
+    ~RegionState();
+
+    RegionState(const RegionState&) = delete;
+    RegionState& operator=(const RegionState&) = delete;
+};
+
+/**
+ * Regions expected to hold identical contents, such as the same asset
+ * shipped in several split APKs. All members were protected with the same
+ * baseline digest, so a group scan rehashes one member in full and checks
+ * the others against it by digest and file metadata.
+ */
+struct RegionGroup {
+    std::vector<RegionId> members;
+    uint8_t digest[SHA256_DIGEST_LENGTH] = {};
+    // Rotates the member the next group scan rehashes in full.
+    std::atomic<size_t> next_deep{0};
+};
+
+/**
+ * Region registry for one MemoryMonitor. Every region name is interned once
+ * and mapped to a compact RegionId; region state lives in a contiguous
+ * table indexed by that id, so hot paths work on integers instead of
+ * string-keyed lookups. Ids stay valid for the lifetime of the monitor,
+ * also across unprotect/protect cycles of the same name.
+ *
+ * Tables are values: the monitor publishes an immutable table and changes
+ * a copy of it, which is cheap because names and region states are shared
+ * between copies rather than duplicated. The name index is append-only and
+ * shared by all copies; a table only resolves the ids it has slots for, so
+ * names interned by later copies stay invisible to earlier ones.
+ */
+class RegionTable {
+public:
+    RegionTable();
+
+    // Returns the id for `name`, assigning a new one on first use.
+    RegionId intern(const std::string& name);
+    // Returns the id for `name`, or kInvalidRegionId if it was never interned.
+    RegionId find(const std::string& name) const;
+    bool isValid(RegionId id) const;
+    const std::string& name(RegionId id) const;
+
+    // State of a protected region, or nullptr if `id` is not protected. The
+    // pointer stays valid for as long as this table is.
+    RegionState* state(RegionId id) const;
+    // Installs fresh state for `id` and appends it to the protected regions.
+    RegionState& put(RegionId id, const MemoryRegionInfo& info);
+    void remove(RegionId id);
+    // Drops all region state and groups; interned names and ids are kept.
+    void clear();
+    // Protected regions, in the order they were protected.
+    const std::vector<RegionId>& protectedIds() const { return protected_; }
+
+    bool isCritical(RegionId id) const;
+    void setCritical(RegionId id, bool critical);
+    // Critical regions, in the order they were added.
+    const std::vector<RegionId>& criticalIds() const { return critical_; }
+
+    // Group registered under `name`, or nullptr. Valid as long as this table is.
+    RegionGroup* group(const std::string& name) const;
+    void putGroup(const std::string& name, const std::shared_ptr<RegionGroup>& group);
+    void removeGroup(const std::string& name);
+
+private:
+    /**
+     * Interned names, stored in chunks that double in size and never move, so
+     * a name appended by one copy leaves the strings earlier copies refer to
+     * in place. `lock` guards `ids` and appends; reading a name a table has a
+     * slot for needs no lock, since it was written before the table was.
+     */
+    class Names {
+    public:
+        Names();
+        ~Names();
+
+        RegionId find(const std::string& name);
+        RegionId append(const std::string& name);
+        const std::string& at(RegionId id) const;
+
+    private:
+        static const size_t kFirstChunkBits = 6;
+        static const size_t kMaxChunks = 26;
+
+        std::mutex lock_;
+        std::unordered_map<std::string, RegionId> ids_;
+        std::string* chunks_[kMaxChunks];
+        size_t count_;
+    };
+
+    struct Slot {
+        std::shared_ptr<RegionState> state;
+        bool critical = false;
+    };
+
+    std::shared_ptr<Names> names_;
+    std::vector<Slot> slots_;
+    std::vector<RegionId> protected_;
+    std::vector<RegionId> critical_;
+    std::map<std::string, std::shared_ptr<RegionGroup>> groups_;
+};
+
+#endif
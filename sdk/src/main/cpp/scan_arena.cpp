@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "scan_arena.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const char kTruncationMarker[] = "...";
+
+PageBuffer::PageBuffer() : data_(nullptr), capacity_(0) {
+}
+
+PageBuffer::~PageBuffer() {
+    if (data_) {
+        munmap(data_, capacity_);
+    }
+}
+
+bool PageBuffer::reserve(size_t size) {
+    if (size <= capacity_) {
+        return true;
+    }
+
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t capacity = (size + pageSize - 1) / pageSize * pageSize;
+    void* mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    if (data_) {
+        munmap(data_, capacity_);
+    }
+    data_ = static_cast<uint8_t*>(mapping);
+    capacity_ = capacity;
+    return true;
+}
+
+void DetailBuffer::clear() {
+    length_ = 0;
+    truncated_ = false;
+    text_[0] = '\0';
+}
+
+void DetailBuffer::appendRaw(const char* text, size_t length) {
+    if (truncated_) {
+        return;
+    }
+
+    // One byte is kept for the terminator.
+    size_t room = kCapacity - 1 - length_;
+    if (length <= room) {
+        memcpy(text_ + length_, text, length);
+        length_ += length;
+    } else {
+        size_t marker = sizeof(kTruncationMarker) - 1;
+        length_ = kCapacity - 1 - marker;
+        memcpy(text_ + length_, kTruncationMarker, marker);
+        length_ += marker;
+        truncated_ = true;
+    }
+    text_[length_] = '\0';
+}
+
+DetailBuffer& DetailBuffer::append(const char* text) {
+    appendRaw(text, strlen(text));
+    return *this;
+}
+
+DetailBuffer& DetailBuffer::appendNumber(uint64_t value) {
+    char digits[21];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    appendRaw(digits + pos, sizeof(digits) - pos);
+    return *this;
+}
+
+DetailBuffer& DetailBuffer::appendHexOffset(uint64_t value) {
+    static const char kHex[] = "0123456789abcdef";
+    char digits[18];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = kHex[value & 0xf];
+        value >>= 4;
+    } while (value != 0);
+    digits[--pos] = 'x';
+    digits[--pos] = '0';
+    appendRaw(digits + pos, sizeof(digits) - pos);
+    return *this;
+}
+
+DetailBuffer& DetailBuffer::appendHex(const uint8_t* bytes, size_t count) {
+    static const char kHex[] = "0123456789abcdef";
+    char pair[2];
+    for (size_t i = 0; i < count; i++) {
+        pair[0] = kHex[bytes[i] >> 4];
+        pair[1] = kHex[bytes[i] & 0xf];
+        appendRaw(pair, sizeof(pair));
+    }
+    return *this;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_SCAN_ARENA_H
+#define APP_PROTECTION_SCAN_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Page-aligned scratch buffer backed by an anonymous mapping, so large
+ * read windows never go through the native heap. reserve() only ever grows
+ * it; after the first scan of the largest region it is not remapped again.
+ */
+class PageBuffer {
+public:
+    PageBuffer();
+    ~PageBuffer();
+
+    // Ensures room for `size` bytes. Contents are not preserved on growth.
+    bool reserve(size_t size);
+
+    uint8_t* data() { return data_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    PageBuffer(const PageBuffer&) = delete;
+    PageBuffer& operator=(const PageBuffer&) = delete;
+
+    uint8_t* data_;
+    size_t capacity_;
+};
+
+/**
+ * Fixed-capacity text buffer for tamper report details. Appends past the
+ * capacity are cut off and the text is terminated with "...", so building
+ * a report never allocates until str() hands it out.
+ */
+class DetailBuffer {
+public:
+    static const size_t kCapacity = 512;
+
+    DetailBuffer() { clear(); }
+
+    void clear();
+    DetailBuffer& append(const char* text);
+    DetailBuffer& append(const std::string& text) { return append(text.c_str()); }
+    DetailBuffer& appendNumber(uint64_t value);
+    DetailBuffer& appendHexOffset(uint64_t value);
+    // Lowercase hex of the first `count` bytes.
+    DetailBuffer& appendHex(const uint8_t* bytes, size_t count);
+
+    const char* c_str() const { return text_; }
+    size_t size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+    std::string str() const { return std::string(text_, length_); }
+
+private:
+    void appendRaw(const char* text, size_t length);
+
+    char text_[kCapacity];
+    size_t length_;
+    bool truncated_;
+};
+
+/**
+ * Pool of per-scan scratch state owned by one monitor. Every concurrent
+ * scan leases its own Scratch and returns it when done, so after the first
+ * passes have grown the buffers to their working size the scan loop runs
+ * without heap allocations. The pool holds as many Scratch objects as
+ * scans ever ran at once.
+ */
+template <typename Scratch>
+class ScanArena {
+public:
+    class Lease {
+    public:
+        explicit Lease(ScanArena& arena) : arena_(arena), scratch_(arena.acquire()) {}
+        ~Lease() { arena_.release(std::move(scratch_)); }
+
+        Scratch& operator*() { return *scratch_; }
+        Scratch* operator->() { return scratch_.get(); }
+
+    private:
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ScanArena& arena_;
+        std::unique_ptr<Scratch> scratch_;
+    };
+
+private:
+    std::unique_ptr<Scratch> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                std::unique_ptr<Scratch> scratch = std::move(free_.back());
+                free_.pop_back();
+                return scratch;
+            }
+        }
+        return std::unique_ptr<Scratch>(new Scratch());
+    }
+
+    void release(std::unique_ptr<Scratch> scratch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(scratch));
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Scratch>> free_;
+};
+
+#endif
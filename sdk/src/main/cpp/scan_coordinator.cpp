@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "scan_coordinator.h"
+#include <string.h>
+#include <functional>
+
+ScanCoordinator& ScanCoordinator::instance() {
+    static ScanCoordinator coordinator;
+    return coordinator;
+}
+
+ScanCoordinator::ScanCoordinator() : reused_(0) {
+}
+
+ScanCoordinator::Shard& ScanCoordinator::shardFor(const std::string& region) {
+    return shards_[std::hash<std::string>()(region) % kShardCount];
+}
+
+void ScanCoordinator::publish(const void* owner, const std::string& region, size_t chunkSize,
+                              const uint8_t* digest, const FileStamp* stamp, uint64_t nowNs) {
+    Shard& shard = shardFor(region);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    Entry& entry = shard.entries[region];
+    entry.owner = owner;
+    entry.chunk_size = chunkSize;
+    memcpy(entry.digest, digest, SHA256_DIGEST_LENGTH);
+    entry.has_stamp = stamp != nullptr;
+    entry.stamp = stamp ? *stamp : FileStamp();
+    entry.verified_ns = nowNs;
+}
+
+bool ScanCoordinator::verifiedRecently(const void* owner, const std::string& region, size_t chunkSize,
+                                       const uint8_t* digest, const FileStamp* stamp, uint64_t nowNs,
+                                       uint64_t maxAgeNs) {
+    Shard& shard = shardFor(region);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.entries.find(region);
+    if (it == shard.entries.end()) {
+        return false;
+    }
+
+    const Entry& entry = it->second;
+    if (entry.owner == owner || entry.chunk_size != chunkSize || nowNs - entry.verified_ns > maxAgeNs ||
+        memcmp(entry.digest, digest, SHA256_DIGEST_LENGTH) != 0) {
+        return false;
+    }
+    // Files always carry a stamp; a missing or differing one means the file
+    // may have changed since it was hashed.
+    if ((stamp != nullptr) != entry.has_stamp || (stamp && !(*stamp == entry.stamp))) {
+        return false;
+    }
+    reused_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ScanCoordinator::invalidate(const std::string& region) {
+    Shard& shard = shardFor(region);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.entries.erase(region);
+}
+
+void ScanCoordinator::release(const void* owner, const std::string& region) {
+    Shard& shard = shardFor(region);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto it = shard.entries.find(region);
+    if (it != shard.entries.end() && it->second.owner == owner) {
+        shard.entries.erase(it);
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_SCAN_COORDINATOR_H
+#define APP_PROTECTION_SCAN_COORDINATOR_H
+
+#include <openssl/sha.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "mapped_file.h"
+
+/**
+ * Process-wide record of recent verifications, shared by all MemoryMonitor
+ * instances. Files and loaded library text are the same bytes whichever
+ * monitor protects them, so once one monitor has hashed such a region and
+ * found it matching its baseline, a monitor with the same baseline can take
+ * the region as verified for a while instead of hashing it again. Anonymous
+ * memory regions are allocated per monitor and never go through here.
+ *
+ * A monitor never reuses its own results, so a single monitor scans exactly
+ * as it would without the coordinator. Entries are spread over shards by
+ * region name, each with its own lock, so monitors scanning different
+ * regions do not contend.
+ */
+class ScanCoordinator {
+public:
+    static ScanCoordinator& instance();
+
+    // Records that `owner` just hashed `region` and it matched `digest`, a
+    // baseline of `chunkSize` chunks (0 for a whole-region hash). `stamp`
+    // is the file metadata the hash was taken at, nullptr for memory.
+    void publish(const void* owner, const std::string& region, size_t chunkSize, const uint8_t* digest,
+                 const FileStamp* stamp, uint64_t nowNs);
+
+    // True if another monitor published the same `digest` for `region` at
+    // most `maxAgeNs` ago and, for files, with metadata equal to `stamp`.
+    bool verifiedRecently(const void* owner, const std::string& region, size_t chunkSize, const uint8_t* digest,
+                          const FileStamp* stamp, uint64_t nowNs, uint64_t maxAgeNs);
+
+    // Drops what is known about `region` after a monitor found it changed.
+    void invalidate(const std::string& region);
+    // Drops the entry for `region` if `owner` published it, once that
+    // monitor goes away.
+    void release(const void* owner, const std::string& region);
+
+    // Scans answered from another monitor's result.
+    uint64_t reuseCount() const { return reused_.load(std::memory_order_relaxed); }
+
+private:
+    ScanCoordinator();
+
+    static const size_t kShardCount = 16;
+
+    struct Entry {
+        const void* owner = nullptr;
+        size_t chunk_size = 0;
+        uint8_t digest[SHA256_DIGEST_LENGTH] = {};
+        FileStamp stamp;
+        bool has_stamp = false;
+        uint64_t verified_ns = 0;
+    };
+
+    struct Shard {
+        std::mutex lock;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    Shard& shardFor(const std::string& region);
+
+    Shard shards_[kShardCount];
+    std::atomic<uint64_t> reused_;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scan_metrics.h"
+
+LatencyHistogram::LatencyHistogram() : count_(0), total_ns_(0), max_ns_(0) {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    buckets_[latencyBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t max = max_ns_.load(std::memory_order_relaxed);
+    while (ns > max && !max_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::append(std::vector<int64_t>& packed) const {
+    packed.push_back(static_cast<int64_t>(count_.load(std::memory_order_relaxed)));
+    packed.push_back(static_cast<int64_t>(total_ns_.load(std::memory_order_relaxed)));
+    packed.push_back(static_cast<int64_t>(max_ns_.load(std::memory_order_relaxed)));
+    for (const auto& bucket : buckets_) {
+        packed.push_back(static_cast<int64_t>(bucket.load(std::memory_order_relaxed)));
+    }
+}
+
+void RegionMetrics::record(uint64_t startNs, uint64_t durationNs, const VerifyStats& stats, bool intact) {
+    scan_count++;
+    if (!intact) {
+        mismatch_count++;
+    }
+    last_scan_ns = startNs;
+    last_duration_ns = durationNs;
+    bytes_hashed += stats.bytes_hashed;
+    latency[latencyBucket(durationNs)]++;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_SCAN_METRICS_H
+#define APP_PROTECTION_SCAN_METRICS_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Log2 latency buckets: bucket 0 holds samples under 1 us, bucket i holds
+// [2^(i+9), 2^(i+10)) ns and the last bucket everything from 2^40 ns up.
+static const size_t kLatencyBuckets = 32;
+
+inline size_t latencyBucket(uint64_t ns) {
+    if (ns < 1024) {
+        return 0;
+    }
+    size_t bucket = static_cast<size_t>(63 - __builtin_clzll(ns)) - 9;
+    return bucket < kLatencyBuckets ? bucket : kLatencyBuckets - 1;
+}
+
+/**
+ * Latency histogram updated with relaxed atomics, so scan pool threads can
+ * record into it without taking a lock.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t ns);
+    // Appends count, total ns, max ns and the bucket counts.
+    void append(std::vector<int64_t>& packed) const;
+
+private:
+    std::atomic<uint64_t> buckets_[kLatencyBuckets];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> total_ns_;
+    std::atomic<uint64_t> max_ns_;
+};
+
+// Work done by a single verification, filled in by the scan paths.
+struct VerifyStats {
+    size_t changed_chunks = 0;
+    uint64_t bytes_hashed = 0;
+    uint32_t syscalls = 0;
+};
+
+// Per-region history, owned by the region's MemoryRegionInfo and only
+// updated with the region's lock held.
+struct RegionMetrics {
+    uint64_t scan_count = 0;
+    uint64_t mismatch_count = 0;
+    uint64_t last_scan_ns = 0;
+    uint64_t last_duration_ns = 0;
+    uint64_t bytes_hashed = 0;
+    uint32_t latency[kLatencyBuckets] = {};
+
+    void record(uint64_t startNs, uint64_t durationNs, const VerifyStats& stats, bool intact);
+};
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "scan_rate_controller.h"
+#include <algorithm>
+#include <cmath>
+
+// Thermal statuses at which the interval is stretched further.
+static const int kThermalModerate = 2;
+static const int kThermalSevere = 3;
+static const int kThermalCritical = 4;
+
+ScanRateController::ScanRateController() : credit_(0), tick_(0), last_tamper_tick_(0), tampered_(false) {
+}
+
+void ScanRateController::configure(const AdaptiveScanConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    config_.base_interval_ms = std::max<uint32_t>(config_.base_interval_ms, 1);
+    config_.max_interval_ms = std::max(config_.max_interval_ms, config_.base_interval_ms);
+    config_.time_slices = std::max<uint32_t>(config_.time_slices, 1);
+}
+
+AdaptiveScanConfig ScanRateController::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void ScanRateController::setDeviceState(const DeviceState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    device_ = state;
+}
+
+bool ScanRateController::recentlyTampered(const History& history) const {
+    return history.tampered && tick_ - history.last_tamper_tick < config_.time_slices;
+}
+
+uint32_t ScanRateController::periodOf(const Candidate& candidate, const History& history) const {
+    if (recentlyTampered(history)) {
+        return 1;
+    }
+    if (candidate.critical) {
+        return std::max<uint32_t>(config_.time_slices / 4, 1);
+    }
+    return config_.time_slices;
+}
+
+void ScanRateController::plan(const std::vector<Candidate>& candidates, std::vector<RegionId>& selected) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tick_++;
+    selected.clear();
+    due_.clear();
+
+    double budget = 0;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const Candidate& candidate = candidates[i];
+        if (candidate.id < 0) {
+            continue;
+        }
+        if (static_cast<size_t>(candidate.id) >= history_.size()) {
+            history_.resize(candidate.id + 1);
+        }
+        History& history = history_[candidate.id];
+        if (!history.known) {
+            history.known = true;
+            history.last_scan_tick = tick_;
+        }
+        uint32_t period = periodOf(candidate, history);
+        budget += static_cast<double>(candidate.size) / period;
+
+        // A region never scanned here is due at once.
+        uint64_t age = tick_ - history.last_scan_tick + (history.scanned ? 0 : period);
+        if (age >= period) {
+            due_.push_back(Due{i, static_cast<double>(age) / period});
+        }
+    }
+    budget = std::ceil(budget);
+    if (config_.max_tick_bytes > 0) {
+        budget = std::min(budget, static_cast<double>(config_.max_tick_bytes));
+    }
+
+    std::stable_sort(due_.begin(), due_.end(), [&candidates](const Due& a, const Due& b) {
+        if (a.urgency != b.urgency) {
+            return a.urgency > b.urgency;
+        }
+        return candidates[a.candidate].critical && !candidates[b.candidate].critical;
+    });
+
+    // Unspent budget is not saved up, so a quiet stretch cannot turn into
+    // a burst. Regions left over wait for a later tick, where they are more
+    // overdue and so sort first.
+    credit_ = std::min(credit_ + budget, budget);
+    for (const Due& due : due_) {
+        const Candidate& candidate = candidates[due.candidate];
+        if (!selected.empty() && credit_ <= 0) {
+            break;
+        }
+        selected.push_back(candidate.id);
+        credit_ -= candidate.size;
+        history_[candidate.id].last_scan_tick = tick_;
+        history_[candidate.id].scanned = true;
+    }
+}
+
+void ScanRateController::recordTamper(RegionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id < 0) {
+        return;
+    }
+    if (static_cast<size_t>(id) >= history_.size()) {
+        history_.resize(id + 1);
+    }
+    history_[id].tampered = true;
+    history_[id].last_tamper_tick = tick_;
+    tampered_ = true;
+    last_tamper_tick_ = tick_;
+}
+
+std::chrono::milliseconds ScanRateController::interval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // A tamper is followed up at full rate whatever the device state.
+    if (tampered_ && tick_ - last_tamper_tick_ < config_.time_slices) {
+        return std::chrono::milliseconds(config_.base_interval_ms);
+    }
+
+    uint64_t factor = 1;
+    if (!device_.foreground) {
+        factor *= 4;
+    }
+    if (device_.battery_saver) {
+        factor *= 2;
+    }
+    if (device_.thermal_status >= kThermalCritical) {
+        factor *= 8;
+    } else if (device_.thermal_status >= kThermalSevere) {
+        factor *= 4;
+    } else if (device_.thermal_status >= kThermalModerate) {
+        factor *= 2;
+    }
+
+    uint64_t interval = std::min<uint64_t>(config_.base_interval_ms * factor, config_.max_interval_ms);
+    return std::chrono::milliseconds(interval);
+}
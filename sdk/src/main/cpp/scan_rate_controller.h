@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_SCAN_RATE_CONTROLLER_H
+#define APP_PROTECTION_SCAN_RATE_CONTROLLER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "region_table.h"
+
+/**
+ * Device conditions pushed in from the app layer.
+ */
+struct DeviceState {
+    bool foreground = true;
+    bool battery_saver = false;
+    // PowerManager.THERMAL_STATUS_*: 0 (none) up to 6 (shutdown).
+    int thermal_status = 0;
+};
+
+/**
+ * Adaptive scheduling for the native scan scheduler.
+ */
+struct AdaptiveScanConfig {
+    // Tick interval in the foreground with no throttling.
+    uint32_t base_interval_ms = 1000;
+    // Longest interval throttling may stretch a tick to.
+    uint32_t max_interval_ms = 30000;
+    // Ticks over which every protected byte is scanned once; 1 scans
+    // everything on every tick.
+    uint32_t time_slices = 8;
+    // Upper bound on the bytes scanned per tick; 0 leaves it to the slice
+    // budget. A tick always scans at least its most overdue region.
+    uint64_t max_tick_bytes = 0;
+};
+
+/**
+ * Decides what each scheduler tick scans and how long to wait for the next.
+ *
+ * Every region has a period in ticks: `time_slices` normally, a quarter of
+ * that for critical regions, and 1 for regions tampered with during the
+ * last `time_slices` ticks. Each tick gets a byte budget equal to the
+ * average load those periods put on a tick and takes due regions, most
+ * overdue first, until it is spent. An overrun is paid back by the next
+ * tick, so a tick costs at most its budget plus one region and the whole
+ * set is still covered about every `time_slices` ticks.
+ *
+ * The interval grows in the background, in battery saver and with thermal
+ * pressure, and snaps back to the base interval while a recent tamper is
+ * being followed up.
+ */
+class ScanRateController {
+public:
+    struct Candidate {
+        RegionId id;
+        uint64_t size;
+        bool critical;
+    };
+
+    ScanRateController();
+
+    void configure(const AdaptiveScanConfig& config);
+    AdaptiveScanConfig config() const;
+    void setDeviceState(const DeviceState& state);
+
+    // Starts the next tick and fills `selected` with the regions to scan.
+    void plan(const std::vector<Candidate>& candidates, std::vector<RegionId>& selected);
+    void recordTamper(RegionId id);
+    std::chrono::milliseconds interval() const;
+
+private:
+    struct History {
+        // Tick of the last scan, or of the first plan that saw the region.
+        uint64_t last_scan_tick = 0;
+        uint64_t last_tamper_tick = 0;
+        bool known = false;
+        bool scanned = false;
+        bool tampered = false;
+    };
+
+    struct Due {
+        size_t candidate;
+        double urgency;
+    };
+
+    bool recentlyTampered(const History& history) const;
+    uint32_t periodOf(const Candidate& candidate, const History& history) const;
+
+    mutable std::mutex mutex_;
+    AdaptiveScanConfig config_;
+    DeviceState device_;
+    // Indexed by RegionId.
+    std::vector<History> history_;
+    std::vector<Due> due_;
+    // Byte budget left over from earlier ticks; negative after a tick
+    // overran it.
+    double credit_;
+    uint64_t tick_;
+    uint64_t last_tamper_tick_;
+    bool tampered_;
+};
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scan_scheduler.h"
+#include <stdlib.h>
+#include "log.h"
+
+#define TAG "ScanScheduler"
+
+ScanScheduler::ScanScheduler()
+    : interval_(0), generation_(0), running_(false), wake_requested_(false) {
+}
+
+ScanScheduler::~ScanScheduler() {
+    stop();
+    if (worker_.joinable() || retired_.joinable()) {
+        // Destroyed from inside a tick, which run() returns to afterwards.
+        LOGE("Scan scheduler destroyed from its own worker thread");
+        abort();
+    }
+}
+
+bool ScanScheduler::start(std::chrono::milliseconds interval, Tick tick) {
+    if (interval.count() <= 0 || !tick) {
+        LOGE("Invalid scheduler parameters (interval: %lld ms)",
+                            (long long)interval.count());
+        return false;
+    }
+
+    stop();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker_.joinable()) {
+        // Restarted from inside a tick: this thread is the old worker, which
+        // exits after the tick now that its generation is out of date.
+        retired_ = std::move(worker_);
+    }
+    tick_ = tick;
+    interval_ = interval;
+    running_ = true;
+    wake_requested_ = false;
+    worker_ = std::thread(&ScanScheduler::run, this, ++generation_);
+
+    LOGI("Scan scheduler started with interval: %lld ms",
+                        (long long)interval.count());
+    return true;
+}
+
+void ScanScheduler::stop() {
+    bool wasRunning;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wasRunning = running_;
+        running_ = false;
+    }
+    cv_.notify_all();
+
+    // Stopped from inside a tick, the loop exits on its own; that thread is
+    // joined by a later start() or stop() from another thread.
+    std::thread::id self = std::this_thread::get_id();
+    if (worker_.joinable() && worker_.get_id() != self) {
+        worker_.join();
+    }
+    if (retired_.joinable() && retired_.get_id() != self) {
+        retired_.join();
+    }
+
+    if (wasRunning) {
+        LOGI("Scan scheduler stopped");
+    }
+}
+
+bool ScanScheduler::isWorkerThread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::thread::id self = std::this_thread::get_id();
+    return worker_.get_id() == self || retired_.get_id() == self;
+}
+
+bool ScanScheduler::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+void ScanScheduler::setInterval(std::chrono::milliseconds interval) {
+    if (interval.count() <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        interval_ = interval;
+    }
+    cv_.notify_all();
+}
+
+void ScanScheduler::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_requested_ = true;
+    }
+    cv_.notify_all();
+}
+
+void ScanScheduler::run(uint64_t generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Tick tick = tick_;
+
+    // A worker retired by an earlier start() must not keep ticking once a
+    // newer worker has taken over.
+    while (running_ && generation_ == generation) {
+        lock.unlock();
+        tick();
+        lock.lock();
+
+        std::chrono::milliseconds interval = interval_;
+        cv_.wait_for(lock, interval, [this, generation]() {
+            return !running_ || generation_ != generation || wake_requested_;
+        });
+        wake_requested_ = false;
+    }
+}
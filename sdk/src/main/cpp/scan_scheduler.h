@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_SCAN_SCHEDULER_H
+#define APP_PROTECTION_SCAN_SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Owns a native worker thread that runs a tick callback at a fixed interval.
+ * The worker sleeps on a condition variable between ticks, so stopping or
+ * waking it does not have to wait out the remaining interval.
+ */
+class ScanScheduler {
+public:
+    typedef std::function<void()> Tick;
+
+    ScanScheduler();
+    ~ScanScheduler();
+
+    bool start(std::chrono::milliseconds interval, Tick tick);
+    // From inside a tick it only signals; the scheduler must then not be
+    // destroyed on that thread.
+    void stop();
+    bool isRunning() const;
+    bool isWorkerThread() const;
+
+    void setInterval(std::chrono::milliseconds interval);
+    void wake();
+
+private:
+    void run(uint64_t generation);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    // A worker replaced by start() from inside its own tick, joined later.
+    std::thread retired_;
+    Tick tick_;
+    std::chrono::milliseconds interval_;
+    uint64_t generation_;
+    bool running_;
+    bool wake_requested_;
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scan_thread_pool.h"
+#include "log.h"
+#include <cstdio>
+#include <unistd.h>
+
+#define TAG "ScanThreadPool"
+
+ScanThreadPool::ScanThreadPool(size_t threads)
+    : task_(nullptr), count_(0), next_(0), active_(0), generation_(0), shutdown_(false) {
+    for (size_t i = 0; i < threads; i++) {
+        workers_.emplace_back(&ScanThreadPool::workerLoop, this);
+    }
+    LOGI("Scan pool started with %zu worker threads", threads);
+}
+
+ScanThreadPool::~ScanThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ScanThreadPool::run(size_t count, const Task& task) {
+    if (count == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_.store(0);
+        active_ = workers_.size();
+        generation_++;
+    }
+    work_cv_.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return active_ == 0; });
+    task_ = nullptr;
+}
+
+void ScanThreadPool::drain() {
+    const Task& task = *task_;
+    for (size_t index = next_.fetch_add(1); index < count_; index = next_.fetch_add(1)) {
+        task(index);
+    }
+}
+
+void ScanThreadPool::workerLoop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        work_cv_.wait(lock, [this, seen]() { return shutdown_ || generation_ != seen; });
+        if (shutdown_) {
+            return;
+        }
+        seen = generation_;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        if (--active_ == 0) {
+            done_cv_.notify_all();
+        }
+    }
+}
+
+static long readMaxFrequency(long cpu) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/cpufreq/cpuinfo_max_freq", cpu);
+
+    FILE* file = fopen(path, "re");
+    if (!file) {
+        return -1;
+    }
+    long frequency = -1;
+    if (fscanf(file, "%ld", &frequency) != 1) {
+        frequency = -1;
+    }
+    fclose(file);
+    return frequency;
+}
+
+size_t ScanThreadPool::bigCoreCount() {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus <= 1) {
+        return 1;
+    }
+
+    std::vector<long> frequencies;
+    long slowest = -1;
+    for (long cpu = 0; cpu < cpus; cpu++) {
+        long frequency = readMaxFrequency(cpu);
+        if (frequency <= 0) {
+            // No cpufreq (emulators, some containers): treat as symmetric.
+            return static_cast<size_t>(cpus);
+        }
+        frequencies.push_back(frequency);
+        if (slowest < 0 || frequency < slowest) {
+            slowest = frequency;
+        }
+    }
+
+    size_t big = 0;
+    for (long frequency : frequencies) {
+        if (frequency > slowest) {
+            big++;
+        }
+    }
+    return big > 0 ? big : static_cast<size_t>(cpus);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_SCAN_THREAD_POOL_H
+#define APP_PROTECTION_SCAN_THREAD_POOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small fixed pool used to spread a scan pass across cores. Work is handed
+ * out as a range of task indexes that every thread, including the caller,
+ * claims from a shared atomic counter, so threads that finish early keep
+ * pulling the remaining tasks instead of idling.
+ */
+class ScanThreadPool {
+public:
+    typedef std::function<void(size_t)> Task;
+
+    // `threads` extra worker threads are started; 0 means the caller runs
+    // every task itself.
+    explicit ScanThreadPool(size_t threads);
+    ~ScanThreadPool();
+
+    // Runs task(0) .. task(count - 1) and returns once all have finished.
+    void run(size_t count, const Task& task);
+
+    size_t workerCount() const { return workers_.size(); }
+
+    // Number of "big" cores: CPUs whose maximum frequency is above that of
+    // the slowest cluster, or every online CPU on symmetric systems.
+    static size_t bigCoreCount();
+
+private:
+    void workerLoop();
+    void drain();
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::vector<std::thread> workers_;
+
+    // Serializes run() calls; a pass owns the pool until it completes.
+    std::mutex run_mutex_;
+    const Task* task_;
+    size_t count_;
+    std::atomic<size_t> next_;
+    size_t active_;
+    uint64_t generation_;
+    bool shutdown_;
+};
+
+#endif
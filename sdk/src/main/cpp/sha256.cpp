@@ -16,9 +16,10 @@
 
 #include <openssl/sha.h>
 #include <string.h>
+#include "sha256_internal.h"
 
 // Simple SHA-256 implementation
-static const unsigned int K[] = {
+const unsigned int SHA256_K[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
     0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
@@ -64,7 +65,7 @@ int SHA256_Init(SHA256_CTX *c) {
     return 1;
 }
 
-static void SHA256_Transform(SHA256_CTX *c, const unsigned char *data) {
+static void SHA256_Transform(unsigned int *state, const unsigned char *data) {
     unsigned int a, b, d, e, f, g, h, i, j, t1, t2, m[64];
     
     for (i = 0, j = 0; i < 16; ++i, j += 4) {
@@ -75,17 +76,17 @@ static void SHA256_Transform(SHA256_CTX *c, const unsigned char *data) {
         m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
     }
     
-    a = c->h[0];
-    b = c->h[1];
-    unsigned int c_temp = c->h[2];
-    d = c->h[3];
-    e = c->h[4];
-    f = c->h[5];
-    g = c->h[6];
-    h = c->h[7];
+    a = state[0];
+    b = state[1];
+    unsigned int c_temp = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
     
     for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e, f, g) + K[i] + m[i];
+        t1 = h + EP1(e) + CH(e, f, g) + SHA256_K[i] + m[i];
         t2 = EP0(a) + MAJ(a, b, c_temp);
         h = g;
         g = f;
@@ -97,28 +98,93 @@ static void SHA256_Transform(SHA256_CTX *c, const unsigned char *data) {
         a = t1 + t2;
     }
     
-    c->h[0] += a;
-    c->h[1] += b;
-    c->h[2] += c_temp;
-    c->h[3] += d;
-    c->h[4] += e;
-    c->h[5] += f;
-    c->h[6] += g;
-    c->h[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c_temp;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void sha256_blocks_scalar(unsigned int *state, const unsigned char *data, size_t blocks) {
+    while (blocks--) {
+        SHA256_Transform(state, data);
+        data += 64;
+    }
+}
+
+// Block function used by SHA256_Update/Final. Starts out as the portable
+// implementation so hashing is valid even before the load-time selection
+// below has run, then gets upgraded to a hardware backend when available.
+static sha256_block_fn sha256_blocks = sha256_blocks_scalar;
+static const char *sha256_backend = "scalar";
+static sha256_multi_block_fn sha256_multi_blocks = sha256_multi_blocks_x4;
+static size_t sha256_lanes = 4;
+
+__attribute__((constructor))
+static void sha256_select_backend() {
+    sha256_block_fn fn = sha256_blocks_armv8_backend();
+    if (fn != NULL) {
+        sha256_blocks = fn;
+        sha256_backend = "armv8-ce";
+        sha256_lanes = 1;
+        return;
+    }
+
+    fn = sha256_blocks_shani_backend();
+    if (fn != NULL) {
+        sha256_blocks = fn;
+        sha256_backend = "sha-ni";
+        sha256_lanes = 1;
+        return;
+    }
+
+    sha256_multi_block_fn multi = sha256_multi_blocks_avx2_backend();
+    if (multi != NULL) {
+        sha256_multi_blocks = multi;
+        sha256_lanes = 8;
+    }
+}
+
+const char *sha256_backend_name() {
+    return sha256_backend;
+}
+
+size_t sha256_multi_lanes() {
+    return sha256_lanes;
+}
+
+#ifdef APP_PROTECTION_TESTING
+int sha256_set_backend(const char *name, sha256_block_fn blocks, sha256_multi_block_fn multi, size_t lanes) {
+    if (name == NULL || blocks == NULL || lanes < 1 || lanes > 8 || (lanes > 1 && multi == NULL)) return 0;
+
+    sha256_blocks = blocks;
+    sha256_backend = name;
+    if (multi != NULL) {
+        sha256_multi_blocks = multi;
+    }
+    sha256_lanes = lanes;
+    return 1;
+}
+#endif
+
+static void sha256_add_length(SHA256_CTX *c, size_t len) {
+    unsigned int l = (c->Nl + (((unsigned int)len) << 3)) & 0xffffffffUL;
+    if (l < c->Nl) c->Nh++;
+    c->Nh += (unsigned int)(len >> 29);
+    c->Nl = l;
 }
 
 int SHA256_Update(SHA256_CTX *c, const void *data, size_t len) {
     if (c == NULL || data == NULL) return 0;
     
     const unsigned char *p = (const unsigned char *)data;
-    unsigned int l;
     
     if (len == 0) return 1;
     
-    l = (c->Nl + (((unsigned int)len) << 3)) & 0xffffffffUL;
-    if (l < c->Nl) c->Nh++;
-    c->Nh += (unsigned int)(len >> 29);
-    c->Nl = l;
+    sha256_add_length(c, len);
     
     if (c->num != 0) {
         unsigned int n = 64 - c->num;
@@ -129,17 +195,18 @@ int SHA256_Update(SHA256_CTX *c, const void *data, size_t len) {
             return 1;
         } else {
             memcpy(c->data + c->num, p, n);
-            SHA256_Transform(c, c->data);
+            sha256_blocks(c->h, c->data, 1);
             p += n;
             len -= n;
             c->num = 0;
         }
     }
     
-    while (len >= 64) {
-        SHA256_Transform(c, p);
-        p += 64;
-        len -= 64;
+    if (len >= 64) {
+        size_t blocks = len / 64;
+        sha256_blocks(c->h, p, blocks);
+        p += blocks * 64;
+        len -= blocks * 64;
     }
     
     if (len != 0) {
@@ -150,6 +217,109 @@ int SHA256_Update(SHA256_CTX *c, const void *data, size_t len) {
     return 1;
 }
 
+// Messages hashed together per group; the per-message bookkeeping lives on
+// the stack, so batching never allocates.
+static const size_t kMultiGroupSize = 64;
+
+// Lanes are refilled as messages run out of whole blocks, so messages of
+// different lengths keep the vector busy until fewer than two remain.
+static int sha256_multi_update_group(SHA256_CTX *const *c, const void *const *data, const size_t *len, size_t n) {
+    // Complete any partially filled context block first, then account for the
+    // whole blocks up front; only the tails go through SHA256_Update after.
+    const unsigned char *next[kMultiGroupSize];
+    size_t blocks[kMultiGroupSize];
+    size_t pending[kMultiGroupSize];
+    size_t pendingCount = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (c[i] == NULL || (data[i] == NULL && len[i] != 0)) return 0;
+
+        const unsigned char *p = (const unsigned char *)data[i];
+        size_t remaining = len[i];
+        if (c[i]->num != 0) {
+            size_t head = 64 - c[i]->num;
+            if (head > remaining) head = remaining;
+            SHA256_Update(c[i], p, head);
+            p += head;
+            remaining -= head;
+        }
+
+        next[i] = p;
+        blocks[i] = remaining / 64;
+        if (blocks[i] > 0) {
+            sha256_add_length(c[i], blocks[i] * 64);
+            pending[pendingCount++] = i;
+        }
+    }
+
+    size_t lanes = sha256_lanes;
+    size_t active[8];
+    size_t activeCount = 0;
+    size_t queued = 0;
+    for (;;) {
+        while (activeCount < lanes && queued < pendingCount) {
+            active[activeCount++] = pending[queued++];
+        }
+        if (activeCount < lanes) {
+            break;
+        }
+
+        size_t step = blocks[active[0]];
+        unsigned int *states[8];
+        const unsigned char *ptrs[8];
+        for (size_t l = 0; l < lanes; l++) {
+            size_t i = active[l];
+            if (blocks[i] < step) step = blocks[i];
+            states[l] = c[i]->h;
+            ptrs[l] = next[i];
+        }
+        sha256_multi_blocks(states, ptrs, step);
+
+        for (size_t l = 0; l < activeCount;) {
+            size_t i = active[l];
+            next[i] += step * 64;
+            blocks[i] -= step;
+            if (blocks[i] == 0) {
+                memmove(&active[l], &active[l + 1], (activeCount - l - 1) * sizeof(active[0]));
+                activeCount--;
+            } else {
+                l++;
+            }
+        }
+    }
+
+    // Too few messages left to fill the lanes.
+    for (size_t l = 0; l < activeCount; l++) {
+        size_t i = active[l];
+        sha256_blocks(c[i]->h, next[i], blocks[i]);
+        next[i] += blocks[i] * 64;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        size_t consumed = (size_t)(next[i] - (const unsigned char *)data[i]);
+        if (consumed < len[i]) {
+            SHA256_Update(c[i], next[i], len[i] - consumed);
+        }
+    }
+    return 1;
+}
+
+int SHA256_MultiUpdate(SHA256_CTX *const *c, const void *const *data, const size_t *len, size_t n) {
+    if (c == NULL || data == NULL || len == NULL) return 0;
+
+    if (sha256_lanes < 2 || n < 2) {
+        for (size_t i = 0; i < n; i++) {
+            if (!SHA256_Update(c[i], data[i], len[i])) return 0;
+        }
+        return 1;
+    }
+
+    for (size_t first = 0; first < n; first += kMultiGroupSize) {
+        size_t count = n - first < kMultiGroupSize ? n - first : kMultiGroupSize;
+        if (!sha256_multi_update_group(c + first, data + first, len + first, count)) return 0;
+    }
+    return 1;
+}
+
 int SHA256_Final(unsigned char *md, SHA256_CTX *c) {
     if (c == NULL || md == NULL) return 0;
     
@@ -161,7 +331,7 @@ int SHA256_Final(unsigned char *md, SHA256_CTX *c) {
     
     if (n > 56) {
         memset(p + n, 0, 64 - n);
-        SHA256_Transform(c, p);
+        sha256_blocks(c->h, p, 1);
         n = 0;
     }
     
@@ -176,7 +346,7 @@ int SHA256_Final(unsigned char *md, SHA256_CTX *c) {
     p[62] = (unsigned char)(c->Nl >> 8);
     p[63] = (unsigned char)(c->Nl);
     
-    SHA256_Transform(c, p);
+    sha256_blocks(c->h, p, 1);
     
     for (n = 0; n < 8; n++) {
         md[4 * n] = (unsigned char)(c->h[n] >> 24);
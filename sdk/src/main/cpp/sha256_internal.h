@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_SHA256_INTERNAL_H
+#define APP_PROTECTION_SHA256_INTERNAL_H
+
+#include <stddef.h>
+
+// Processes `blocks` consecutive 64-byte blocks, updating the eight
+// big-endian-order working words in `state` (SHA256_CTX::h layout).
+typedef void (*sha256_block_fn)(unsigned int *state, const unsigned char *data, size_t blocks);
+
+extern const unsigned int SHA256_K[64];
+
+void sha256_blocks_scalar(unsigned int *state, const unsigned char *data, size_t blocks);
+
+// Hardware backends. Each returns NULL when the library was built without
+// support for it or when the running CPU does not advertise the extension.
+sha256_block_fn sha256_blocks_armv8_backend();
+sha256_block_fn sha256_blocks_shani_backend();
+
+// Name of the backend picked at load time, for diagnostics.
+const char *sha256_backend_name();
+
+// Multi-buffer block functions: processes `blocks` blocks of each of the
+// backend's lanes, where states[l] and data[l] belong to lane l.
+typedef void (*sha256_multi_block_fn)(unsigned int *const *states, const unsigned char *const *data,
+                                      size_t blocks);
+
+void sha256_multi_blocks_x4(unsigned int *const *states, const unsigned char *const *data, size_t blocks);
+
+// Eight lanes; NULL unless built for and running on a CPU with AVX2.
+sha256_multi_block_fn sha256_multi_blocks_avx2_backend();
+
+// Messages SHA256_MultiUpdate hashes side by side. 1 when a single-buffer
+// hardware backend is active, which outruns the SIMD lanes on its own.
+size_t sha256_multi_lanes();
+
+#ifdef APP_PROTECTION_TESTING
+// Replaces the load-time selection, so tests can run every backend and the
+// multi-buffer path on any CPU. `lanes` is 1 to disable multi-buffer hashing
+// or the lane count of `multi`, at most 8. Returns 0 on invalid arguments.
+// Only built into the test copy of the core; not thread-safe: nothing may be
+// hashing while the backend changes.
+int sha256_set_backend(const char *name, sha256_block_fn blocks, sha256_multi_block_fn multi, size_t lanes);
+#endif
+
+#endif
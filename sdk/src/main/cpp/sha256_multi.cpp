@@ -0,0 +1,27 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "sha256_multi_kernel.h"
+
+// Four-lane multi-buffer SHA-256. 128-bit vectors are baseline on every
+// supported ABI (NEON on arm64 and armeabi-v7a, SSE2 on x86 and x86_64), so
+// this needs no special flags or runtime check.
+typedef uint32_t sha256_v4u32 __attribute__((vector_size(16)));
+
+void sha256_multi_blocks_x4(unsigned int *const *states, const unsigned char *const *data, size_t blocks) {
+    sha256MultiBlocks<sha256_v4u32, 4>(states, data, blocks);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "sha256_internal.h"
+
+#if defined(__x86_64__) && defined(__AVX2__)
+
+#include <cpuid.h>
+#include "sha256_multi_kernel.h"
+
+// Eight-lane multi-buffer SHA-256 on 256-bit AVX2 vectors.
+typedef uint32_t sha256_v8u32 __attribute__((vector_size(32)));
+
+static void sha256_multi_blocks_avx2(unsigned int *const *states, const unsigned char *const *data, size_t blocks) {
+    sha256MultiBlocks<sha256_v8u32, 8>(states, data, blocks);
+}
+
+sha256_multi_block_fn sha256_multi_blocks_avx2_backend() {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return NULL;
+    }
+    // The OS must save the upper halves of the YMM registers.
+    if ((ecx & (bit_AVX | bit_OSXSAVE)) != (bit_AVX | bit_OSXSAVE)) {
+        return NULL;
+    }
+    unsigned int xcr0Low, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 0x6) != 0x6) {
+        return NULL;
+    }
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return NULL;
+    }
+    if (ebx & bit_AVX2) {
+        return sha256_multi_blocks_avx2;
+    }
+    return NULL;
+}
+
+#else
+
+sha256_multi_block_fn sha256_multi_blocks_avx2_backend() {
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_SHA256_MULTI_KERNEL_H
+#define APP_PROTECTION_SHA256_MULTI_KERNEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sha256_internal.h"
+
+// Multi-buffer SHA-256 compression over `Lanes` independent messages. Lane l
+// of every vector belongs to message l, so each SIMD instruction advances
+// all messages by the same step of their own round function. Written with
+// compiler vector extensions: V is a vector of `Lanes` uint32_t, which the
+// compiler lowers to NEON, SSE2 or AVX2 depending on the translation unit's
+// target flags. Only included by the sha256_multi*.cpp backends.
+
+template <typename V>
+static inline V sha256MultiRotr(V x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+template <typename V, size_t Lanes>
+static inline V sha256MultiLoad(const unsigned char* const* data, size_t offset) {
+    V v;
+    for (size_t l = 0; l < Lanes; l++) {
+        const unsigned char* p = data[l] + offset;
+        v[l] = (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+    return v;
+}
+
+template <typename V, size_t Lanes>
+static void sha256MultiBlocks(unsigned int* const* states, const unsigned char* const* data, size_t blocks) {
+    V s[8];
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t l = 0; l < Lanes; l++) {
+            s[i][l] = states[l][i];
+        }
+    }
+
+    const unsigned char* p[Lanes];
+    for (size_t l = 0; l < Lanes; l++) {
+        p[l] = data[l];
+    }
+
+    while (blocks--) {
+        // Rolling 16-word message schedule.
+        V m[16];
+        for (size_t j = 0; j < 16; j++) {
+            m[j] = sha256MultiLoad<V, Lanes>(p, 4 * j);
+        }
+
+        V a = s[0], b = s[1], c = s[2], d = s[3];
+        V e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (size_t i = 0; i < 64; i++) {
+            if (i >= 16) {
+                V w2 = m[(i - 2) & 15];
+                V w15 = m[(i - 15) & 15];
+                V sig1 = sha256MultiRotr(w2, 17) ^ sha256MultiRotr(w2, 19) ^ (w2 >> 10);
+                V sig0 = sha256MultiRotr(w15, 7) ^ sha256MultiRotr(w15, 18) ^ (w15 >> 3);
+                m[i & 15] += sig1 + m[(i - 7) & 15] + sig0;
+            }
+
+            V ep1 = sha256MultiRotr(e, 6) ^ sha256MultiRotr(e, 11) ^ sha256MultiRotr(e, 25);
+            V ch = (e & f) ^ (~e & g);
+            V t1 = h + ep1 + ch + SHA256_K[i] + m[i & 15];
+            V ep0 = sha256MultiRotr(a, 2) ^ sha256MultiRotr(a, 13) ^ sha256MultiRotr(a, 22);
+            V maj = (a & b) ^ (a & c) ^ (b & c);
+            V t2 = ep0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        s[0] += a; s[1] += b; s[2] += c; s[3] += d;
+        s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+
+        for (size_t l = 0; l < Lanes; l++) {
+            p[l] += 64;
+        }
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t l = 0; l < Lanes; l++) {
+            states[l][i] = s[i][l];
+        }
+    }
+}
+
+#endif
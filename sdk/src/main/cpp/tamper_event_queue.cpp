@@ -0,0 +1,184 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "tamper_event_queue.h"
+#include <stdlib.h>
+#include <chrono>
+#include "log.h"
+
+#define TAG "TamperEventQueue"
+
+TamperEventQueue::TamperEventQueue(size_t capacity, uint32_t windowMs)
+    : mask_(0), enqueue_pos_(0), dequeue_pos_(0), dropped_(0), reported_dropped_(0),
+      window_ms_(windowMs), waiting_(false), started_(false), stopping_(false) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots_.reset(new Slot[size]);
+    mask_ = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+TamperEventQueue::~TamperEventQueue() {
+    stop();
+    if (dispatcher_.joinable()) {
+        // Destroyed from inside a handler: run() still uses the ring, mutex
+        // and condition variable, so they cannot be freed underneath it.
+        LOGE("Tamper event queue destroyed from its own dispatcher thread");
+        abort();
+    }
+}
+
+void TamperEventQueue::setHandler(TamperingBatchCallback handler, const DispatcherHooks& hooks) {
+    std::atomic_store(&handler_, std::shared_ptr<const TamperingBatchCallback>(
+        handler ? std::make_shared<TamperingBatchCallback>(std::move(handler)) : nullptr));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_ && !stopping_ && std::atomic_load(&handler_)) {
+        started_ = true;
+        dispatcher_ = std::thread(&TamperEventQueue::run, this, hooks);
+    }
+}
+
+bool TamperEventQueue::isActive() const {
+    return std::atomic_load(&handler_) != nullptr;
+}
+
+// Bounded MPSC ring after Vyukov: a slot's sequence equals the position
+// that may claim it next, and becomes position + 1 once it holds an event.
+bool TamperEventQueue::push(const std::string& region, const std::string& details) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->region = region;
+    slot->details = details;
+    // Sequentially consistent together with waiting_, so either the
+    // dispatcher sees this event before it sleeps or we see it asleep.
+    slot->sequence.store(pos + 1);
+    if (waiting_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+    return true;
+}
+
+void TamperEventQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    // Stopped from inside a handler, the loop drains and exits on its own;
+    // the thread is joined by a later stop() from another thread.
+    if (dispatcher_.joinable() && dispatcher_.get_id() != std::this_thread::get_id()) {
+        dispatcher_.join();
+    }
+}
+
+bool TamperEventQueue::isDispatcherThread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dispatcher_.get_id() == std::this_thread::get_id();
+}
+
+bool TamperEventQueue::hasEvent() const {
+    return slots_[dequeue_pos_ & mask_].sequence.load() == dequeue_pos_ + 1;
+}
+
+void TamperEventQueue::drainInto(std::vector<TamperEvent>& batch) {
+    while (hasEvent()) {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+        bool merged = false;
+        for (auto& event : batch) {
+            if (event.region == slot.region && event.details == slot.details) {
+                event.count++;
+                merged = true;
+                break;
+            }
+        }
+        if (!merged) {
+            batch.push_back(TamperEvent{std::move(slot.region), std::move(slot.details), 1});
+        }
+        slot.region.clear();
+        slot.details.clear();
+        slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        dequeue_pos_++;
+    }
+}
+
+void TamperEventQueue::run(DispatcherHooks hooks) {
+    if (hooks.on_start) {
+        hooks.on_start();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        waiting_.store(true);
+        cv_.wait(lock, [this]() { return stopping_ || hasEvent(); });
+        waiting_.store(false);
+        if (!hasEvent()) {
+            break;
+        }
+
+        // Whatever a scan reports within the window goes into this batch.
+        if (!stopping_) {
+            cv_.wait_for(lock, std::chrono::milliseconds(window_ms_), [this]() { return stopping_; });
+        }
+        lock.unlock();
+
+        std::vector<TamperEvent> batch;
+        drainInto(batch);
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reported_dropped_) {
+            LOGW("Dropped %llu tamper events, queue full", (unsigned long long)(dropped - reported_dropped_));
+            batch.push_back(TamperEvent{"tamper_event_queue", "Tamper events dropped: queue full",
+                                        (uint32_t)(dropped - reported_dropped_)});
+            reported_dropped_ = dropped;
+        }
+
+        std::shared_ptr<const TamperingBatchCallback> handler = std::atomic_load(&handler_);
+        if (handler) {
+            LOGD("Delivering %zu tamper events", batch.size());
+            (*handler)(batch);
+        }
+        lock.lock();
+    }
+    lock.unlock();
+    LOGD("Tamper event queue drained");
+
+    if (hooks.on_exit) {
+        hooks.on_exit();
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_TAMPER_EVENT_QUEUE_H
+#define APP_PROTECTION_TAMPER_EVENT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * One tampering event as delivered to a batch handler. `count` is the
+ * number of identical events coalesced into it.
+ */
+struct TamperEvent {
+    std::string region;
+    std::string details;
+    uint32_t count;
+};
+
+typedef std::function<void(const std::vector<TamperEvent>&)> TamperingBatchCallback;
+
+/**
+ * Callbacks run on the dispatcher thread when it starts and right before it
+ * exits, e.g. to attach it to and detach it from the JVM once.
+ */
+struct DispatcherHooks {
+    std::function<void()> on_start;
+    std::function<void()> on_exit;
+};
+
+/**
+ * Moves tampering events off the scanning threads. Producers push into a
+ * bounded lock-free ring and return immediately; a single dispatcher thread
+ * waits for the first event, lets the coalescing window pass, then hands
+ * everything queued meanwhile to the handler in one call, with identical
+ * events merged. Events pushed while the ring is full are dropped and
+ * reported in the next batch.
+ */
+class TamperEventQueue {
+public:
+    // `capacity` is rounded up to a power of two.
+    explicit TamperEventQueue(size_t capacity = 256, uint32_t windowMs = 50);
+    ~TamperEventQueue();
+
+    // Starts the dispatcher on first use; `hooks` only apply to that start.
+    // A null handler discards further batches but keeps the thread.
+    void setHandler(TamperingBatchCallback handler, const DispatcherHooks& hooks = DispatcherHooks());
+    bool isActive() const;
+    // Lock-free; returns false if the event was dropped.
+    bool push(const std::string& region, const std::string& details);
+    // Delivers what is still queued, then joins the dispatcher. From the
+    // dispatcher itself it only signals; the queue must then not be
+    // destroyed on that thread.
+    void stop();
+    bool isDispatcherThread() const;
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::string region;
+        std::string details;
+    };
+
+    bool hasEvent() const;
+    void drainInto(std::vector<TamperEvent>& batch);
+    void run(DispatcherHooks hooks);
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    std::atomic<size_t> enqueue_pos_;
+    // Only touched by the dispatcher thread.
+    size_t dequeue_pos_;
+    std::atomic<uint64_t> dropped_;
+    uint64_t reported_dropped_;
+    uint32_t window_ms_;
+
+    std::shared_ptr<const TamperingBatchCallback> handler_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> waiting_;
+    std::thread dispatcher_;
+    bool started_;
+    bool stopping_;
+};
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Baseline snapshots: HMAC known answers, write/read round trips, and
+// rejection of truncated, bit-flipped and resealed out-of-bounds files.
+
+#include <functional>
+
+#include "baseline_store.h"
+#include "test_support.h"
+
+namespace {
+
+const std::vector<uint8_t> kKey = {0x41, 0x50, 0x42, 0x4c, 0x5f, 0x6b, 0x65, 0x79,
+                                   0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+
+std::string hmacHex(const std::vector<uint8_t>& key, const std::string& message) {
+    uint8_t mac[SHA256_DIGEST_LENGTH];
+    hmacSha256(key.data(), key.size(), reinterpret_cast<const uint8_t*>(message.data()), message.size(), mac);
+    return toHex(mac, sizeof(mac));
+}
+
+// RFC 4231 test cases 1, 2 and 6.
+void testHmacKnownAnswers() {
+    CHECK_EQ(hmacHex(std::vector<uint8_t>(20, 0x0b), "Hi There"),
+             std::string("b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"));
+    CHECK_EQ(hmacHex(std::vector<uint8_t>({'J', 'e', 'f', 'e'}), "what do ya want for nothing?"),
+             std::string("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+    CHECK_EQ(hmacHex(std::vector<uint8_t>(131, 0xaa), "Test Using Larger Than Block-Size Key - Hash Key First"),
+             std::string("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+}
+
+std::vector<BaselineEntry> sampleEntries() {
+    std::vector<BaselineEntry> entries(3);
+
+    entries[0].path = "/data/app/base.apk";
+    entries[0].stamp.dev = 0xfd00;
+    entries[0].stamp.ino = 123456789;
+    entries[0].stamp.size = 3 * 65536 + 10;
+    entries[0].stamp.mtime = {1700000000, 123456789};
+    entries[0].stamp.ctime = {1700000001, 987654321};
+    entries[0].size = 3 * 65536 + 10;
+    entries[0].chunk_size = 65536;
+    fillPattern(entries[0].hash, SHA256_DIGEST_LENGTH, 1);
+    entries[0].chunk_hashes.resize(4 * SHA256_DIGEST_LENGTH);
+    fillPattern(entries[0].chunk_hashes.data(), entries[0].chunk_hashes.size(), 2);
+
+    entries[1].path = "/sys/kernel/some_attribute";
+    entries[1].stamp.size = 4096;
+    entries[1].size = 37;
+    entries[1].streamed = true;
+    fillPattern(entries[1].hash, SHA256_DIGEST_LENGTH, 3);
+
+    entries[2].path = "/data/data/app/files/odd-length-name";
+    entries[2].stamp.size = 0;
+    fillPattern(entries[2].hash, SHA256_DIGEST_LENGTH, 4);
+    return entries;
+}
+
+bool sameEntry(const BaselineEntry& a, const BaselineEntry& b) {
+    return a.path == b.path && a.stamp == b.stamp && a.size == b.size && a.chunk_size == b.chunk_size &&
+           a.streamed == b.streamed && memcmp(a.hash, b.hash, SHA256_DIGEST_LENGTH) == 0 &&
+           a.chunk_hashes == b.chunk_hashes;
+}
+
+void testRoundTrip() {
+    TempFile file("baseline");
+    std::vector<BaselineEntry> written = sampleEntries();
+    CHECK(writeBaselineFile(file.path(), written, kKey));
+    CHECK_EQ(file.read().size() % 8, 0u);
+
+    std::vector<BaselineEntry> read;
+    CHECK(readBaselineFile(file.path(), kKey, read));
+    CHECK_EQ(read.size(), written.size());
+    for (size_t i = 0; i < read.size() && i < written.size(); i++) {
+        CHECK(sameEntry(read[i], written[i]));
+    }
+
+    CHECK(writeBaselineFile(file.path(), std::vector<BaselineEntry>(), kKey));
+    CHECK(readBaselineFile(file.path(), kKey, read));
+    CHECK(read.empty());
+}
+
+void testRejectsWrongKeyAndMissingFile() {
+    TempFile file("baseline");
+    CHECK(writeBaselineFile(file.path(), sampleEntries(), kKey));
+
+    std::vector<uint8_t> otherKey = kKey;
+    otherKey[0] ^= 1;
+    std::vector<BaselineEntry> read;
+    CHECK(!readBaselineFile(file.path(), otherKey, read));
+    CHECK(!readBaselineFile(file.path() + ".missing", kKey, read));
+    CHECK(read.empty());
+}
+
+// A rejected file leaves the caller's entries alone.
+bool rejects(const TempFile& file, const std::vector<uint8_t>& bytes) {
+    std::vector<BaselineEntry> read(1);
+    read[0].path = "untouched";
+    bool loaded = file.write(bytes.data(), bytes.size()) && readBaselineFile(file.path(), kKey, read);
+    return !loaded && read.size() == 1 && read[0].path == "untouched";
+}
+
+void testRejectsTruncatedAndBitFlipped() {
+    TempFile file("baseline");
+    CHECK(writeBaselineFile(file.path(), sampleEntries(), kKey));
+    std::vector<uint8_t> original = file.read();
+
+    for (size_t size = 0; size < original.size(); size++) {
+        CHECK(rejects(file, std::vector<uint8_t>(original.begin(), original.begin() + size)));
+    }
+    for (size_t bit = 0; bit < original.size() * 8; bit++) {
+        std::vector<uint8_t> flipped = original;
+        flipped[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        CHECK(rejects(file, flipped));
+    }
+}
+
+// Edits the header or a record, then reseals the file with the right key so
+// only the bounds checks stand between the edit and the decoder.
+std::vector<uint8_t> resealed(const std::vector<uint8_t>& original,
+                              const std::function<void(BaselineHeader&, BaselineRecord*)>& edit) {
+    std::vector<uint8_t> bytes = original;
+    BaselineHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    std::vector<BaselineRecord> records(header.region_count);
+    memcpy(records.data(), bytes.data() + header.records_offset, records.size() * sizeof(BaselineRecord));
+
+    edit(header, records.data());
+
+    memcpy(bytes.data(), &header, sizeof(header));
+    memcpy(bytes.data() + sizeof(BaselineHeader), records.data(), records.size() * sizeof(BaselineRecord));
+    size_t sealedSize = bytes.size() - SHA256_DIGEST_LENGTH;
+    hmacSha256(kKey.data(), kKey.size(), bytes.data(), sealedSize, bytes.data() + sealedSize);
+    return bytes;
+}
+
+void testRejectsOutOfBoundsFields() {
+    TempFile file("baseline");
+    CHECK(writeBaselineFile(file.path(), sampleEntries(), kKey));
+    std::vector<uint8_t> original = file.read();
+
+    // Resealing without an edit must still load, or the cases below prove nothing.
+    std::vector<uint8_t> unchanged = resealed(original, [](BaselineHeader&, BaselineRecord*) {});
+    std::vector<BaselineEntry> read;
+    CHECK(file.write(unchanged.data(), unchanged.size()) && readBaselineFile(file.path(), kKey, read));
+
+    const std::vector<std::function<void(BaselineHeader&, BaselineRecord*)>> edits = {
+        [](BaselineHeader& h, BaselineRecord*) { h.magic ^= 1; },
+        [](BaselineHeader& h, BaselineRecord*) { h.version++; },
+        [](BaselineHeader& h, BaselineRecord*) { h.header_size = 40; },
+        [](BaselineHeader& h, BaselineRecord*) { h.record_size = 64; },
+        [](BaselineHeader& h, BaselineRecord*) { h.region_count = 4; },
+        [](BaselineHeader& h, BaselineRecord*) { h.region_count = 0xffffffffu; },
+        [](BaselineHeader& h, BaselineRecord*) { h.records_offset = 0; },
+        [](BaselineHeader& h, BaselineRecord*) { h.records_offset = 0xffffffffffffff00ULL; },
+        [](BaselineHeader& h, BaselineRecord*) { h.data_offset = 1u << 20; },
+        [](BaselineHeader& h, BaselineRecord*) { h.data_offset = ~0ULL; },
+        [](BaselineHeader& h, BaselineRecord*) { h.data_size += 1; },
+        [](BaselineHeader& h, BaselineRecord*) { h.data_size = ~0ULL; },
+        [](BaselineHeader& h, BaselineRecord* r) { r[1].path_offset = h.data_size + 1; },
+        [](BaselineHeader&, BaselineRecord* r) { r[1].path_offset = ~0ULL; },
+        [](BaselineHeader& h, BaselineRecord* r) { r[2].path_length = static_cast<uint32_t>(h.data_size); },
+        [](BaselineHeader&, BaselineRecord* r) { r[0].path_length = 0xffffffffu; },
+        [](BaselineHeader& h, BaselineRecord* r) { r[2].digest_offset = h.data_size - SHA256_DIGEST_LENGTH + 1; },
+        [](BaselineHeader&, BaselineRecord* r) { r[0].digest_offset = ~0ULL; },
+        [](BaselineHeader&, BaselineRecord* r) { r[2].chunk_count = 1; },
+        [](BaselineHeader&, BaselineRecord* r) { r[1].chunk_count = 0xffffffffu; },
+    };
+    for (size_t i = 0; i < edits.size(); i++) {
+        if (!rejects(file, resealed(original, edits[i]))) {
+            fprintf(stderr, "out-of-bounds edit %zu was accepted\n", i);
+            testFailureCount()++;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    testHmacKnownAnswers();
+    testRoundTrip();
+    testRejectsWrongKeyAndMissingFile();
+    testRejectsTruncatedAndBitFlipped();
+    testRejectsOutOfBoundsFields();
+    return testResult("baseline_store_test");
+}
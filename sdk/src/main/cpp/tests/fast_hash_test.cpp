@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fast_hash.h"
+#include "test_support.h"
+
+namespace {
+
+// Published XXH64 values.
+void testReferenceVectors() {
+    CHECK_EQ(fastHash64("", 0, 0), 0xef46db3751d8e999ULL);
+    CHECK_EQ(fastHash64("a", 1, 0), 0xd24ec4f1a98c6e5bULL);
+    CHECK_EQ(fastHash64("abc", 3, 0), 0x44bc2cf5ad770999ULL);
+    const char* spam = "Nobody inspects the spammish repetition";
+    CHECK_EQ(fastHash64(spam, strlen(spam), 0), 0xfbcea83c8a378bf1ULL);
+}
+
+struct PatternVector {
+    size_t size;
+    uint64_t seed;
+    uint64_t hash;
+};
+
+// Prefixes of fillPattern(0x5eed) that reach every tail path (bytes, a
+// 4-byte word, 8-byte words) with and without the 32-byte stripe loop,
+// from an independent XXH64 implementation.
+const PatternVector kPatternVectors[] = {
+    {0, 0x0000000000000000ULL, 0xef46db3751d8e999ULL},
+    {0, 0x9e3779b97f4a7c15ULL, 0xc4349fc93c010000ULL},
+    {1, 0x0000000000000000ULL, 0xa3dad144c40657edULL},
+    {1, 0x9e3779b97f4a7c15ULL, 0xe701116e21d712f0ULL},
+    {3, 0x0000000000000000ULL, 0xaa4184f0793409b6ULL},
+    {3, 0x9e3779b97f4a7c15ULL, 0x33c742bf1d23bc31ULL},
+    {4, 0x0000000000000000ULL, 0xb09804a5eee08996ULL},
+    {4, 0x9e3779b97f4a7c15ULL, 0x93d5fcc04f83e411ULL},
+    {7, 0x0000000000000000ULL, 0xd9c3ba927cab7332ULL},
+    {7, 0x9e3779b97f4a7c15ULL, 0x8e63f5237a64782cULL},
+    {8, 0x0000000000000000ULL, 0xd50d33793f2a9511ULL},
+    {8, 0x9e3779b97f4a7c15ULL, 0x5f3e8bb3846d1f86ULL},
+    {12, 0x0000000000000000ULL, 0x0c179dcc65a810b5ULL},
+    {12, 0x9e3779b97f4a7c15ULL, 0x53c6d0adb35fb6d9ULL},
+    {31, 0x0000000000000000ULL, 0x7893c4499bde41feULL},
+    {31, 0x9e3779b97f4a7c15ULL, 0x0688ea2a864e94beULL},
+    {32, 0x0000000000000000ULL, 0x91a6611d9a630abeULL},
+    {32, 0x9e3779b97f4a7c15ULL, 0x8eba92957310cd21ULL},
+    {33, 0x0000000000000000ULL, 0xbe98438ea9b8c89eULL},
+    {33, 0x9e3779b97f4a7c15ULL, 0x8fbe66fc147109e6ULL},
+    {63, 0x0000000000000000ULL, 0xd497d02c4cb9659aULL},
+    {63, 0x9e3779b97f4a7c15ULL, 0xa8611a3a2d432018ULL},
+    {64, 0x0000000000000000ULL, 0x41c4ede325480661ULL},
+    {64, 0x9e3779b97f4a7c15ULL, 0x20a23428194616f6ULL},
+    {100, 0x0000000000000000ULL, 0x50f3d75e563b1f3bULL},
+    {100, 0x9e3779b97f4a7c15ULL, 0x767d88d622c86b7eULL},
+    {1031, 0x0000000000000000ULL, 0x8e1c4e87a44e265cULL},
+    {1031, 0x9e3779b97f4a7c15ULL, 0xe075e46c7b0d2c80ULL},
+};
+
+void testPatternVectors() {
+    std::vector<uint8_t> data(1031);
+    fillPattern(data.data(), data.size(), 0x5eed);
+    for (const PatternVector& vector : kPatternVectors) {
+        if (fastHash64(data.data(), vector.size, vector.seed) != vector.hash) {
+            fprintf(stderr, "size %zu seed %016llx mismatched\n", vector.size, (unsigned long long)vector.seed);
+            CHECK(false);
+        }
+    }
+}
+
+void testAlignmentDoesNotMatter() {
+    std::vector<uint8_t> data(1031 + 8);
+    fillPattern(data.data(), 1031, 0x5eed);
+    uint64_t aligned = fastHash64(data.data(), 1031, 0);
+    for (size_t offset = 1; offset < 8; offset++) {
+        std::vector<uint8_t> shifted(data.size());
+        memcpy(shifted.data() + offset, data.data(), 1031);
+        CHECK_EQ(fastHash64(shifted.data() + offset, 1031, 0), aligned);
+    }
+}
+
+void testEveryBitFlipChangesHash() {
+    std::vector<uint8_t> data(4096);
+    fillPattern(data.data(), data.size(), 3);
+    uint64_t seed = 0x0123456789abcdefULL;
+    uint64_t baseline = fastHash64(data.data(), data.size(), seed);
+    size_t unchanged = 0;
+    for (size_t bit = 0; bit < data.size() * 8; bit++) {
+        data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        if (fastHash64(data.data(), data.size(), seed) == baseline) {
+            unchanged++;
+        }
+        data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+    }
+    CHECK_EQ(unchanged, 0u);
+    // Appending a zero byte changes the length, and so the hash.
+    data.push_back(0);
+    CHECK(fastHash64(data.data(), data.size(), seed) != baseline);
+}
+
+void testSeed() {
+    uint8_t data[64];
+    fillPattern(data, sizeof(data), 11);
+    CHECK(fastHash64(data, sizeof(data), 1) != fastHash64(data, sizeof(data), 2));
+    CHECK_EQ(fastHashSeed(), fastHashSeed());
+}
+
+} // namespace
+
+int main() {
+    testReferenceVectors();
+    testPatternVectors();
+    testAlignmentDoesNotMatter();
+    testEveryBitFlipChangesHash();
+    testSeed();
+    return testResult("fast_hash_test");
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Golden manifest views: lookups in a well-formed manifest, and rejection
+// of truncated, misaligned, bit-flipped and out-of-bounds manifests.
+
+#include <algorithm>
+#include <functional>
+
+#include "golden_manifest.h"
+#include "merkle_tree.h"
+#include "test_support.h"
+
+namespace {
+
+struct SampleEntry {
+    std::string name;
+    uint64_t size;
+    uint32_t chunk_size;
+};
+
+// Lays the manifest out the way tools/golden_manifest_tool.cpp does: header,
+// entries sorted by name, digests, then names. Storage is 8-byte aligned.
+class ManifestImage {
+public:
+    ManifestImage() {
+        std::vector<SampleEntry> samples = {
+            {"asset.bin", 300000, 65536},
+            {"config.json", 517, 0},
+            {"elf:libnative.so", 3 * 4096, 4096},
+            {"elf:libnative.so.1", 4096, 4096},
+        };
+        std::sort(samples.begin(), samples.end(),
+                  [](const SampleEntry& a, const SampleEntry& b) { return a.name < b.name; });
+
+        std::vector<ManifestEntry> entries(samples.size());
+        std::string names;
+        uint32_t digestCount = 0;
+        for (size_t i = 0; i < samples.size(); i++) {
+            ManifestEntry& entry = entries[i];
+            memset(&entry, 0, sizeof(entry));
+            entry.name_offset = static_cast<uint32_t>(names.size());
+            entry.name_length = static_cast<uint32_t>(samples[i].name.size());
+            entry.size = samples[i].size;
+            entry.chunk_size = samples[i].chunk_size;
+            entry.first_digest = digestCount;
+            entry.digest_count = static_cast<uint32_t>(merkleChunkCount(entry.size, entry.chunk_size));
+            fillPattern(entry.root, SHA256_DIGEST_LENGTH, static_cast<uint32_t>(i + 1));
+            names += samples[i].name;
+            digestCount += entry.digest_count;
+        }
+
+        ManifestHeader header;
+        header.magic = kManifestMagic;
+        header.version = kManifestVersion;
+        header.entry_count = static_cast<uint32_t>(entries.size());
+        header.digest_count = digestCount;
+        header.names_offset = static_cast<uint32_t>(sizeof(header) + entries.size() * sizeof(ManifestEntry) +
+                                                    digestCount * SHA256_DIGEST_LENGTH);
+        header.names_size = static_cast<uint32_t>(names.size());
+
+        bytes_.resize(header.names_offset + names.size());
+        memcpy(&bytes_[0], &header, sizeof(header));
+        memcpy(&bytes_[sizeof(header)], entries.data(), entries.size() * sizeof(ManifestEntry));
+        fillPattern(&bytes_[sizeof(header) + entries.size() * sizeof(ManifestEntry)],
+                    digestCount * SHA256_DIGEST_LENGTH, 99);
+        memcpy(&bytes_[header.names_offset], names.data(), names.size());
+        names_ = samples;
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+    const std::vector<SampleEntry>& samples() const { return names_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    std::vector<SampleEntry> names_;
+};
+
+// Copies `bytes` into 8-byte aligned storage, at `shift` bytes past the
+// alignment, and builds a view over it.
+class AlignedView {
+public:
+    AlignedView(const std::vector<uint8_t>& bytes, size_t shift = 0)
+        : storage_((bytes.size() + shift) / 8 + 1) {
+        data_ = reinterpret_cast<uint8_t*>(storage_.data()) + shift;
+        if (!bytes.empty()) {
+            memcpy(data_, bytes.data(), bytes.size());
+        }
+        size_ = bytes.size();
+        manifest_ = GoldenManifest(data_, size_);
+    }
+
+    const GoldenManifest& manifest() const { return manifest_; }
+
+    bool contains(const void* begin, size_t length) const {
+        const uint8_t* p = static_cast<const uint8_t*>(begin);
+        return p >= data_ && length <= size_ && static_cast<size_t>(p - data_) <= size_ - length;
+    }
+
+private:
+    std::vector<uint64_t> storage_;
+    uint8_t* data_;
+    size_t size_;
+    GoldenManifest manifest_;
+};
+
+void testLookups() {
+    ManifestImage image;
+    AlignedView view(image.bytes());
+    const GoldenManifest& manifest = view.manifest();
+    CHECK(!manifest.empty());
+    CHECK_EQ(manifest.entryCount(), image.samples().size());
+
+    for (const SampleEntry& sample : image.samples()) {
+        const ManifestEntry* entry = manifest.find(sample.name);
+        CHECK(entry != nullptr);
+        if (!entry) {
+            continue;
+        }
+        CHECK_EQ(entry->size, sample.size);
+        CHECK_EQ(entry->chunk_size, sample.chunk_size);
+        CHECK(view.contains(manifest.digests(*entry), entry->digest_count * SHA256_DIGEST_LENGTH));
+    }
+
+    CHECK(manifest.find("") == nullptr);
+    CHECK(manifest.find("asset") == nullptr);
+    CHECK(manifest.find("asset.bin2") == nullptr);
+    CHECK(manifest.find("elf:libnative") == nullptr);
+    CHECK(manifest.find("zzz") == nullptr);
+
+    // Consecutive entries own consecutive digest ranges.
+    const ManifestEntry* first = manifest.find(image.samples()[0].name);
+    const ManifestEntry* second = manifest.find(image.samples()[1].name);
+    CHECK(first && second &&
+          manifest.digests(*second) == manifest.digests(*first) + first->digest_count * SHA256_DIGEST_LENGTH);
+
+    CHECK(GoldenManifest().empty());
+    CHECK(GoldenManifest(nullptr, 100).empty());
+}
+
+void testManifestNames() {
+    CHECK_EQ(manifestNameOf("/data/app/~~x/base/assets/asset.bin"), std::string("asset.bin"));
+    CHECK_EQ(manifestNameOf("asset.bin"), std::string("asset.bin"));
+    CHECK_EQ(manifestNameOf("elf:libnative.so"), std::string("elf:libnative.so"));
+}
+
+void testRejectsTruncatedAndMisaligned() {
+    ManifestImage image;
+    const std::vector<uint8_t>& bytes = image.bytes();
+    for (size_t size = 0; size < bytes.size(); size++) {
+        AlignedView view(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size));
+        CHECK(view.manifest().empty());
+    }
+    for (size_t shift = 1; shift < 8; shift++) {
+        CHECK(AlignedView(bytes, shift).manifest().empty());
+    }
+}
+
+// A flipped bit may still leave a well-formed manifest, just with other
+// contents; whatever the view then returns has to lie inside the buffer.
+void testBitFlipsStayInBounds() {
+    ManifestImage image;
+    const std::vector<uint8_t>& bytes = image.bytes();
+    for (size_t bit = 0; bit < bytes.size() * 8; bit++) {
+        std::vector<uint8_t> flipped = bytes;
+        flipped[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        AlignedView view(flipped);
+        const GoldenManifest& manifest = view.manifest();
+        for (const SampleEntry& sample : image.samples()) {
+            const ManifestEntry* entry = manifest.find(sample.name);
+            if (!entry) {
+                continue;
+            }
+            CHECK(view.contains(entry, sizeof(*entry)));
+            CHECK(view.contains(manifest.digests(*entry), entry->digest_count * SHA256_DIGEST_LENGTH));
+        }
+    }
+}
+
+void testRejectsOutOfBoundsFields() {
+    ManifestImage image;
+    const std::vector<std::function<void(ManifestHeader&, ManifestEntry*)>> edits = {
+        [](ManifestHeader& h, ManifestEntry*) { h.magic ^= 1; },
+        [](ManifestHeader& h, ManifestEntry*) { h.version++; },
+        [](ManifestHeader& h, ManifestEntry*) { h.entry_count++; },
+        [](ManifestHeader& h, ManifestEntry*) { h.entry_count = 0xffffffffu; },
+        [](ManifestHeader& h, ManifestEntry*) { h.digest_count++; },
+        [](ManifestHeader& h, ManifestEntry*) { h.digest_count = 0xffffffffu; },
+        [](ManifestHeader& h, ManifestEntry*) { h.names_offset -= 1; },
+        [](ManifestHeader& h, ManifestEntry*) { h.names_offset = 0xffffffffu; },
+        [](ManifestHeader& h, ManifestEntry*) { h.names_size++; },
+        [](ManifestHeader& h, ManifestEntry*) { h.names_size = 0xffffffffu; },
+        [](ManifestHeader& h, ManifestEntry* e) { e[3].name_offset = h.names_size; },
+        [](ManifestHeader&, ManifestEntry* e) { e[0].name_offset = 0xffffffffu; },
+        [](ManifestHeader&, ManifestEntry* e) { e[1].name_length = 0xffffffffu; },
+        [](ManifestHeader& h, ManifestEntry* e) { e[3].first_digest = h.digest_count; },
+        [](ManifestHeader&, ManifestEntry* e) { e[0].first_digest = 0xffffffffu; },
+        [](ManifestHeader&, ManifestEntry* e) { e[0].digest_count--; },
+        [](ManifestHeader&, ManifestEntry* e) { e[1].digest_count = 1; },
+        [](ManifestHeader&, ManifestEntry* e) { e[2].size *= 2; },
+        [](ManifestHeader&, ManifestEntry* e) { e[2].chunk_size = 1; },
+    };
+    for (size_t i = 0; i < edits.size(); i++) {
+        std::vector<uint8_t> bytes = image.bytes();
+        ManifestHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        std::vector<ManifestEntry> entries(image.samples().size());
+        memcpy(entries.data(), &bytes[sizeof(header)], entries.size() * sizeof(ManifestEntry));
+        edits[i](header, entries.data());
+        memcpy(bytes.data(), &header, sizeof(header));
+        memcpy(&bytes[sizeof(header)], entries.data(), entries.size() * sizeof(ManifestEntry));
+
+        if (!AlignedView(bytes).manifest().empty()) {
+            fprintf(stderr, "out-of-bounds edit %zu was accepted\n", i);
+            testFailureCount()++;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    testLookups();
+    testManifestNames();
+    testRejectsTruncatedAndMisaligned();
+    testBitFlipsStayInBounds();
+    testRejectsOutOfBoundsFields();
+    return testResult("golden_manifest_test");
+}
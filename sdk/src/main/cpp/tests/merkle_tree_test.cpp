@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Merkle chunking: chunk counts, chunk digests, tree roots against an
+// independent reference fold, and locating changed chunks.
+
+#include <algorithm>
+
+#include <openssl/sha.h>
+#include "merkle_tree.h"
+#include "test_support.h"
+
+namespace {
+
+typedef std::vector<uint8_t> Digest;
+
+Digest sha256Of(const uint8_t* data, size_t size, const uint8_t* prefix = nullptr) {
+    Digest digest(SHA256_DIGEST_LENGTH);
+    SHA256_CTX ctx;
+    SHA256_Init(&ctx);
+    if (prefix) {
+        SHA256_Update(&ctx, prefix, 1);
+    }
+    SHA256_Update(&ctx, data, size);
+    SHA256_Final(digest.data(), &ctx);
+    return digest;
+}
+
+// Straightforward recursive form of the tree merkleRoot() builds level by
+// level: interior nodes are SHA-256(0x01 || left || right), an odd node is
+// promoted unchanged, and a lone chunk is still hashed once as a node.
+Digest referenceRoot(const std::vector<Digest>& leaves) {
+    static const uint8_t kNodePrefix = 0x01;
+    std::vector<Digest> level = leaves;
+    do {
+        std::vector<Digest> parents;
+        for (size_t i = 0; i < level.size(); i += 2) {
+            if (i + 1 < level.size() || level.size() == 1) {
+                Digest pair = level[i];
+                if (i + 1 < level.size()) {
+                    pair.insert(pair.end(), level[i + 1].begin(), level[i + 1].end());
+                }
+                parents.push_back(sha256Of(pair.data(), pair.size(), &kNodePrefix));
+            } else {
+                parents.push_back(level[i]);
+            }
+        }
+        level.swap(parents);
+    } while (level.size() > 1);
+    return level[0];
+}
+
+void testChunkCount() {
+    CHECK_EQ(merkleChunkCount(100, 0), 0u);
+    CHECK_EQ(merkleChunkCount(0, 4096), 1u);
+    CHECK_EQ(merkleChunkCount(1, 4096), 1u);
+    CHECK_EQ(merkleChunkCount(4096, 4096), 1u);
+    CHECK_EQ(merkleChunkCount(4097, 4096), 2u);
+    CHECK_EQ(merkleChunkCount(10 * 4096, 4096), 10u);
+}
+
+void testChunkDigestsAndRoot() {
+    const size_t chunkSize = 256;
+    std::vector<uint8_t> data(chunkSize * 9 + 17);
+    fillPattern(data.data(), data.size(), 3);
+
+    for (size_t size : {size_t(1), chunkSize, chunkSize + 1, chunkSize * 2, chunkSize * 5 - 3, data.size()}) {
+        size_t count = merkleChunkCount(size, chunkSize);
+        std::vector<uint8_t> digests(count * SHA256_DIGEST_LENGTH);
+        merkleHashChunks(data.data(), size, chunkSize, 0, count, digests.data());
+
+        std::vector<Digest> leaves;
+        for (size_t i = 0; i < count; i++) {
+            size_t offset = i * chunkSize;
+            size_t length = std::min(chunkSize, size - offset);
+            Digest expected = sha256Of(data.data() + offset, length);
+            CHECK(memcmp(&digests[i * SHA256_DIGEST_LENGTH], expected.data(), SHA256_DIGEST_LENGTH) == 0);
+            leaves.push_back(expected);
+        }
+
+        uint8_t root[SHA256_DIGEST_LENGTH];
+        merkleRoot(digests.data(), count, root);
+        CHECK(Digest(root, root + SHA256_DIGEST_LENGTH) == referenceRoot(leaves));
+
+        // Hashing a sub-range lands on the same digests.
+        if (count > 2) {
+            std::vector<uint8_t> middle((count - 2) * SHA256_DIGEST_LENGTH);
+            merkleHashChunks(data.data(), size, chunkSize, 1, count - 2, middle.data());
+            CHECK(memcmp(middle.data(), &digests[SHA256_DIGEST_LENGTH], middle.size()) == 0);
+        }
+    }
+
+    // A one-chunk root is a node hash, not the plain digest of the data.
+    uint8_t digest[SHA256_DIGEST_LENGTH], root[SHA256_DIGEST_LENGTH];
+    merkleHashChunks(data.data(), 100, chunkSize, 0, 1, digest);
+    merkleRoot(digest, 1, root);
+    CHECK(memcmp(root, digest, SHA256_DIGEST_LENGTH) != 0);
+}
+
+void testChangedChunks() {
+    const size_t chunkSize = 512;
+    std::vector<uint8_t> data(chunkSize * 12 + 100);
+    fillPattern(data.data(), data.size(), 11);
+    size_t count = merkleChunkCount(data.size(), chunkSize);
+    std::vector<uint8_t> baseline(count * SHA256_DIGEST_LENGTH);
+    merkleHashChunks(data.data(), data.size(), chunkSize, 0, count, baseline.data());
+    uint8_t baselineRoot[SHA256_DIGEST_LENGTH];
+    merkleRoot(baseline.data(), count, baselineRoot);
+
+    std::vector<size_t> changed;
+    CHECK_EQ(merkleFindChangedChunks(data.data(), data.size(), chunkSize, baseline.data(), 0, count, false,
+                                     changed), 0u);
+    CHECK(changed.empty());
+
+    // Every single-chunk edit is found at its chunk and changes the root.
+    for (size_t chunk = 0; chunk < count; chunk++) {
+        std::vector<uint8_t> edited = data;
+        edited[std::min(chunk * chunkSize + 7, edited.size() - 1)] ^= 0x80;
+        changed.clear();
+        CHECK_EQ(merkleFindChangedChunks(edited.data(), edited.size(), chunkSize, baseline.data(), 0, count,
+                                         false, changed), 1u);
+        CHECK(changed.size() == 1 && changed[0] == chunk);
+
+        std::vector<uint8_t> digests(count * SHA256_DIGEST_LENGTH);
+        merkleHashChunks(edited.data(), edited.size(), chunkSize, 0, count, digests.data());
+        uint8_t root[SHA256_DIGEST_LENGTH];
+        merkleRoot(digests.data(), count, root);
+        CHECK(memcmp(root, baselineRoot, SHA256_DIGEST_LENGTH) != 0);
+    }
+
+    std::vector<uint8_t> edited = data;
+    edited[2 * chunkSize] ^= 1;
+    edited[5 * chunkSize] ^= 1;
+    edited[9 * chunkSize] ^= 1;
+    changed.clear();
+    CHECK_EQ(merkleFindChangedChunks(edited.data(), edited.size(), chunkSize, baseline.data(), 0, count, false,
+                                     changed), 3u);
+    CHECK(changed == std::vector<size_t>({2, 5, 9}));
+
+    changed.clear();
+    CHECK_EQ(merkleFindChangedChunks(edited.data(), edited.size(), chunkSize, baseline.data(), 0, count, true,
+                                     changed), 1u);
+    CHECK(changed == std::vector<size_t>({2}));
+
+    // A range only looks at its own chunks.
+    changed.clear();
+    CHECK_EQ(merkleFindChangedChunks(edited.data(), edited.size(), chunkSize, baseline.data(), 3, 4, false,
+                                     changed), 1u);
+    CHECK(changed == std::vector<size_t>({5}));
+}
+
+} // namespace
+
+int main() {
+    testChunkCount();
+    testChunkDigestsAndRoot();
+    testChangedChunks();
+    return testResult("merkle_tree_test");
+}
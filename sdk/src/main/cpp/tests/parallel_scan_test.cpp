@@ -0,0 +1,198 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The parallel scan has to reach the same verdicts and reports as the
+// serial one, for whole regions and for regions split into chunk ranges
+// across the pool.
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+#include "memory_monitor.h"
+#include "test_support.h"
+
+namespace {
+
+// 32-byte chunks split every 4 KiB memory region and the large file into
+// more than one pool task; the small file stays a whole-region hash.
+const size_t kChunkSize = 32;
+const size_t kLargeFileSize = kChunkSize * 200;
+const size_t kSmallFileSize = 100;
+
+typedef std::vector<std::pair<std::string, std::string>> Reports;
+
+struct Outcome {
+    std::vector<bool> intact;
+    Reports reports;
+    int64_t syscalls = 0;
+    int64_t mismatches = 0;
+};
+
+// Packed layout from nativeGetScanMetrics: version, bucket count, three
+// histograms, bytes hashed, syscalls, mismatches, region count, regions.
+void readCounters(const MemoryMonitor& monitor, size_t regions, Outcome& outcome) {
+    std::vector<int64_t> packed;
+    monitor.getScanMetrics(packed);
+    size_t buckets = static_cast<size_t>(packed[1]);
+    size_t count = packed.size() - regions * (6 + buckets) - 1;
+    CHECK_EQ(packed[count], static_cast<int64_t>(regions));
+    outcome.mismatches = packed[count - 1];
+    outcome.syscalls = packed[count - 2];
+}
+
+void configure(MemoryMonitor& monitor, bool parallel) {
+    ChunkingConfig chunking;
+    chunking.chunk_size = kChunkSize;
+    chunking.min_region_size = 4096;
+    chunking.stop_at_first_mismatch = false;
+    monitor.setChunkingConfig(chunking);
+    // Each monitor hashes its own files instead of reusing the other's verdicts.
+    ScanPolicy policy;
+    policy.shared_result_max_age_ms = 0;
+    monitor.setScanPolicy(policy);
+    monitor.setParallelScanning(parallel);
+}
+
+// Protects two memory regions and, with `withFiles`, two files, then scans
+// them intact, with a memory region and the large file tampered, and once
+// more after that. File paths are reported as "file:large" and
+// "file:small" so the runs of both monitors compare equal.
+Outcome runScenario(bool parallel, bool withFiles) {
+    TempFile large("parallel_large");
+    TempFile small("parallel_small");
+    std::vector<uint8_t> content(kLargeFileSize);
+    fillPattern(content.data(), content.size(), 21);
+    CHECK(large.write(content.data(), content.size()));
+    std::vector<uint8_t> smallContent(kSmallFileSize);
+    fillPattern(smallContent.data(), smallContent.size(), 22);
+    CHECK(small.write(smallContent.data(), smallContent.size()));
+
+    Outcome outcome;
+    MemoryMonitor monitor;
+    configure(monitor, parallel);
+    std::string largePath = large.path();
+    std::string smallPath = small.path();
+    monitor.setTamperingCallback([&outcome, largePath, smallPath](const std::string& region,
+                                                                  const std::string& details) {
+        std::string text = details;
+        for (const auto& path : {std::make_pair(largePath, std::string("file:large")),
+                                 std::make_pair(smallPath, std::string("file:small"))}) {
+            for (size_t at = text.find(path.first); at != std::string::npos; at = text.find(path.first)) {
+                text.replace(at, path.first.size(), path.second);
+            }
+        }
+        std::string name = region == largePath ? "file:large" : region == smallPath ? "file:small" : region;
+        outcome.reports.emplace_back(name, text);
+    });
+    CHECK(monitor.startMonitoring());
+    CHECK(monitor.protectMemoryRegion("split_a"));
+    CHECK(monitor.protectMemoryRegion("split_b"));
+    if (withFiles) {
+        CHECK(monitor.protectMemoryRegion(largePath));
+        CHECK(monitor.protectMemoryRegion(smallPath));
+    }
+
+    outcome.intact.push_back(monitor.scanAllProtectedRegions());
+
+    // Flips the first byte of split_b, which is read-only again afterwards.
+    CHECK(monitor.simulateMemoryTampering("split_b"));
+    content[kChunkSize * 70 + 3] ^= 0x40;
+    content[kChunkSize * 150] ^= 0x01;
+    CHECK(large.write(content.data(), content.size()));
+    outcome.intact.push_back(monitor.scanAllProtectedRegions());
+    outcome.intact.push_back(monitor.scanAllProtectedRegions());
+
+    readCounters(monitor, withFiles ? 4 : 2, outcome);
+    monitor.stopMonitoring();
+    return outcome;
+}
+
+void testParallelMatchesSerial() {
+    Outcome serial = runScenario(false, true);
+    Outcome parallel = runScenario(true, true);
+
+    CHECK_EQ(serial.intact.size(), 3u);
+    CHECK(serial.intact[0]);
+    CHECK(!serial.intact[1]);
+    CHECK(!serial.reports.empty());
+    CHECK(serial.mismatches > 0);
+
+    CHECK(parallel.intact == serial.intact);
+    CHECK_EQ(parallel.reports.size(), serial.reports.size());
+    for (size_t i = 0; i < serial.reports.size() && i < parallel.reports.size(); i++) {
+        if (parallel.reports[i] != serial.reports[i]) {
+            fprintf(stderr, "report %zu differs:\n  serial   %s: %s\n  parallel %s: %s\n", i,
+                    serial.reports[i].first.c_str(), serial.reports[i].second.c_str(),
+                    parallel.reports[i].first.c_str(), parallel.reports[i].second.c_str());
+            CHECK(false);
+        }
+    }
+    CHECK_EQ(parallel.mismatches, serial.mismatches);
+}
+
+// Memory scans make no syscalls other than the mprotect that puts a
+// tampered region back to read-only, so equal counts mean the parallel
+// merge restored split_b after each mismatch like the serial scan did.
+// Files are left out: their chunk-range tasks each read the file on
+// their own.
+void testParallelRestoresProtection() {
+    Outcome serial = runScenario(false, false);
+    Outcome parallel = runScenario(true, false);
+    CHECK_EQ(serial.syscalls, 2);
+    CHECK_EQ(parallel.syscalls, serial.syscalls);
+    CHECK_EQ(parallel.mismatches, serial.mismatches);
+}
+
+// compareMemoryRegions locks two regions in address order while the
+// parallel pass holds split regions locked; both have to keep going.
+void testCompareDuringParallelScans() {
+    MemoryMonitor monitor;
+    configure(monitor, true);
+    CHECK(monitor.startMonitoring());
+    std::vector<std::string> regions;
+    for (int i = 0; i < 8; i++) {
+        regions.push_back("concurrent_" + std::to_string(i));
+        CHECK(monitor.protectMemoryRegion(regions.back()));
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<int> compares(0);
+    std::thread comparer([&]() {
+        for (size_t i = 0; !done.load(); i++) {
+            const std::string& first = regions[i % regions.size()];
+            const std::string& second = regions[(i * 5 + 3) % regions.size()];
+            monitor.compareMemoryRegions(first, second, i % 2 == 0);
+            compares++;
+        }
+    });
+    for (int pass = 0; pass < 200; pass++) {
+        CHECK(monitor.scanAllProtectedRegions());
+    }
+    done = true;
+    comparer.join();
+    CHECK(compares.load() > 0);
+    monitor.stopMonitoring();
+}
+
+} // namespace
+
+int main() {
+    testParallelMatchesSerial();
+    testParallelRestoresProtection();
+    testCompareDuringParallelScans();
+    return testResult("parallel_scan_test");
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Proc parsers against fixture files in the kernel's formats for
+// /proc/self/status, /proc/self/maps and /proc/net/tcp.
+
+#include "proc_parser.h"
+#include "test_support.h"
+
+namespace {
+
+void collectLine(const ProcField& field, void* context) {
+    char line[640];
+    size_t length = formatProcField(field, line, sizeof(line));
+    static_cast<std::vector<std::string>*>(context)->push_back(std::string(line, length));
+}
+
+std::vector<std::string> parse(const std::string& contents, ProcFileKind kind) {
+    TempFile file("proc");
+    std::vector<std::string> lines;
+    CHECK(file.write(contents));
+    CHECK(parseProcFile(file.path().c_str(), kind, collectLine, &lines));
+    return lines;
+}
+
+void testFileKinds() {
+    CHECK_EQ(procFileKindOf("/proc/self/status"), PROC_FILE_STATUS);
+    CHECK_EQ(procFileKindOf("/proc/self/maps"), PROC_FILE_MAPS);
+    CHECK_EQ(procFileKindOf("/proc/net/tcp"), PROC_FILE_TCP);
+    CHECK_EQ(procFileKindOf("/proc/net/tcp6"), PROC_FILE_TCP);
+    CHECK_EQ(procFileKindOf("/proc/self/net/tcp6"), PROC_FILE_TCP);
+    CHECK_EQ(procFileKindOf("/proc/self/cmdline"), PROC_FILE_OTHER);
+    CHECK_EQ(procFileKindOf("/proc/self/status2"), PROC_FILE_OTHER);
+
+    std::vector<std::string> lines;
+    CHECK(!parseProcFile("/proc/self/status", PROC_FILE_OTHER, collectLine, &lines));
+    CHECK(!parseProcFile("/nonexistent/status", PROC_FILE_STATUS, collectLine, &lines));
+    CHECK(lines.empty());
+}
+
+void testStatus() {
+    std::vector<std::string> lines = parse(
+        "Name:\tapp\n"
+        "State:\tS (sleeping)\n"
+        "Tgid:\t4321\n"
+        "TracerPid:\t1234\n"
+        "Uid:\t10123\t10123\t10123\t10123\n"
+        "TracerPidX: 5\n",
+        PROC_FILE_STATUS);
+    CHECK(lines == std::vector<std::string>({"TracerPid: 1234"}));
+
+    CHECK(parse("Name:\tapp\nTracerPid:\t0", PROC_FILE_STATUS) == std::vector<std::string>({"TracerPid: 0"}));
+    CHECK(parse("", PROC_FILE_STATUS).empty());
+}
+
+void testMaps() {
+    std::vector<std::string> lines = parse(
+        "5d1c2a4000-5d1c2a6000 r--p 00000000 fd:05 1234                       /system/bin/app_process64\n"
+        "5d1c2a6000-5d1c2a9000 r-xp 00002000 fd:05 1234                       /system/bin/app_process64\n"
+        "7f3c000000-7f3c100000 rw-p 00000000 00:00 0                          [anon:libc_malloc]\n"
+        "7f3d000000-7f3d080000 r-xp 00010000 fd:05 77   /system/lib64/libc.so\n"
+        "7f3e000000-7f3e001000 rwxp 00000000 00:00 0\n"
+        "7f3f000000-7f3f001000 --xp 00000000 00:00 0                          [vdso]\n"
+        "not-a-mapping\n"
+        "7f40000000 r-xp truncated\n",
+        PROC_FILE_MAPS);
+    CHECK(lines == std::vector<std::string>({
+        "exec 5d1c2a6000-5d1c2a9000 r-xp /system/bin/app_process64",
+        "exec 7f3d000000-7f3d080000 r-xp /system/lib64/libc.so",
+        "exec 7f3e000000-7f3e001000 rwxp ",
+        "exec 7f3f000000-7f3f001000 --xp [vdso]",
+    }));
+
+    // Overlong lines are cut at the line buffer, so they still parse the same
+    // way on every read.
+    std::string longPath(2000, 'p');
+    std::vector<std::string> cut = parse("1000-2000 r-xp 00000000 fd:05 1 /" + longPath + "\n", PROC_FILE_MAPS);
+    CHECK_EQ(cut.size(), 1u);
+    CHECK(!cut.empty() && cut[0].compare(0, 26, "exec 1000-2000 r-xp /ppppp") == 0 && cut[0].size() < 600);
+}
+
+void testTcp() {
+    std::vector<std::string> lines = parse(
+        "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n"
+        "   0: 0100007F:5D8A 00000000:0000 0A 00000000:00000000 00:00000000 00000000  2000        0 81234 1\n"
+        "   1: 00000000:1F90 00000000:0000 0A 00000000:00000000 00:00000000 00000000 10123        0 81235 1\n"
+        "   2: 0100007F:A2C4 0100007F:5D8A 01 00000000:00000000 00:00000000 00000000 10123        0 81236 1\n"
+        "   3: 0100007F:ZZZZ 00000000:0000 0A 00000000:00000000 00:00000000 00000000 10123        0 81237 1\n",
+        PROC_FILE_TCP);
+    CHECK(lines == std::vector<std::string>({"listen 0100007F:23946", "listen 00000000:8080"}));
+
+    std::vector<std::string> tcp6 = parse(
+        "  sl  local_address                         remote_address                        st\n"
+        "   0: 00000000000000000000000000000000:5D8B 00000000000000000000000000000000:0000 0A\n",
+        PROC_FILE_TCP);
+    CHECK(tcp6 == std::vector<std::string>({"listen 00000000000000000000000000000000:23947"}));
+}
+
+void testFormatTruncates() {
+    ProcField field;
+    memset(&field, 0, sizeof(field));
+    field.type = PROC_FIELD_TRACER_PID;
+    field.tracer_pid = 123456;
+    char out[8];
+    CHECK_EQ(formatProcField(field, out, sizeof(out)), 7u);
+    CHECK_EQ(std::string(out), std::string("TracerP"));
+    CHECK_EQ(formatProcField(field, out, 0), 0u);
+}
+
+} // namespace
+
+int main() {
+    testFileKinds();
+    testStatus();
+    testMaps();
+    testTcp();
+    testFormatTruncates();
+    return testResult("proc_parser_test");
+}
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "memory_monitor.h"
+#include "region_table.h"
+#include "test_support.h"
+
+namespace {
+
+// Region state without a mapping, so dropping it unmaps nothing.
+MemoryRegionInfo emptyInfo(size_t size) {
+    MemoryRegionInfo info;
+    info.size = size;
+    return info;
+}
+
+void testInterning() {
+    RegionTable table;
+    CHECK_EQ(table.find("a"), kInvalidRegionId);
+    RegionId a = table.intern("a");
+    RegionId b = table.intern("b");
+    CHECK(a != kInvalidRegionId);
+    CHECK(a != b);
+    CHECK_EQ(table.intern("a"), a);
+    CHECK_EQ(table.find("b"), b);
+    CHECK_EQ(table.name(a), std::string("a"));
+    CHECK(table.isValid(b));
+    CHECK(!table.isValid(b + 1));
+    CHECK(!table.isValid(kInvalidRegionId));
+    CHECK(table.name(b + 1).empty());
+    CHECK(table.state(a) == nullptr);
+}
+
+void testProtectedOrder() {
+    RegionTable table;
+    RegionId a = table.intern("a");
+    RegionId b = table.intern("b");
+    RegionId c = table.intern("c");
+    table.put(c, emptyInfo(3));
+    table.put(a, emptyInfo(1));
+    table.put(b, emptyInfo(2));
+    CHECK((table.protectedIds() == std::vector<RegionId>{c, a, b}));
+    CHECK_EQ(table.state(a)->info.size, 1u);
+
+    // Replacing a region's state keeps its place.
+    table.put(a, emptyInfo(10));
+    CHECK((table.protectedIds() == std::vector<RegionId>{c, a, b}));
+    CHECK_EQ(table.state(a)->info.size, 10u);
+
+    table.remove(a);
+    table.remove(a);
+    CHECK((table.protectedIds() == std::vector<RegionId>{c, b}));
+    CHECK(table.state(a) == nullptr);
+
+    // Ids survive clear() and a later protect of the same name.
+    table.clear();
+    CHECK(table.protectedIds().empty());
+    CHECK_EQ(table.find("a"), a);
+    table.put(a, emptyInfo(4));
+    CHECK_EQ(table.intern("a"), a);
+    CHECK((table.protectedIds() == std::vector<RegionId>{a}));
+}
+
+void testCriticalAndGroups() {
+    RegionTable table;
+    RegionId a = table.intern("a");
+    RegionId b = table.intern("b");
+    table.setCritical(b, true);
+    table.setCritical(a, true);
+    table.setCritical(a, true);
+    CHECK((table.criticalIds() == std::vector<RegionId>{b, a}));
+    table.setCritical(b, false);
+    CHECK((table.criticalIds() == std::vector<RegionId>{a}));
+    CHECK(!table.isCritical(b));
+    table.setCritical(kInvalidRegionId, true);
+    CHECK_EQ(table.criticalIds().size(), 1u);
+
+    std::shared_ptr<RegionGroup> group = std::make_shared<RegionGroup>();
+    group->members = {a, b};
+    table.putGroup("g", group);
+    CHECK(table.group("g") == group.get());
+    CHECK(table.group("h") == nullptr);
+    table.removeGroup("g");
+    CHECK(table.group("g") == nullptr);
+}
+
+// A copy is changed and published while readers still hold the original.
+void testCopiesAreSnapshots() {
+    RegionTable original;
+    RegionId a = original.intern("a");
+    original.put(a, emptyInfo(1));
+    original.setCritical(a, true);
+
+    RegionTable copy = original;
+    // Region state is shared, not duplicated.
+    CHECK(copy.state(a) == original.state(a));
+
+    RegionId b = copy.intern("b");
+    copy.put(b, emptyInfo(2));
+    copy.remove(a);
+    copy.setCritical(a, false);
+
+    CHECK((original.protectedIds() == std::vector<RegionId>{a}));
+    CHECK(original.state(a) != nullptr);
+    CHECK_EQ(original.state(a)->info.size, 1u);
+    CHECK(original.isCritical(a));
+    // Names interned by a later copy are invisible to the original.
+    CHECK_EQ(original.find("b"), kInvalidRegionId);
+    CHECK(original.name(b).empty());
+    CHECK((copy.protectedIds() == std::vector<RegionId>{b}));
+    CHECK_EQ(copy.find("b"), b);
+
+    // Interning that name on the original, as a writer does when the copy
+    // that first interned it was dropped, reuses the id.
+    CHECK_EQ(original.intern("b"), b);
+    CHECK_EQ(original.name(b), std::string("b"));
+    CHECK(original.state(b) == nullptr);
+}
+
+// State released by a newer table stays usable through an older one.
+void testStateOutlivesUnprotect() {
+    std::shared_ptr<RegionTable> first = std::make_shared<RegionTable>();
+    RegionId a = first->intern("a");
+    first->put(a, emptyInfo(7));
+    std::shared_ptr<const RegionTable> reader = first;
+
+    std::shared_ptr<RegionTable> second = std::make_shared<RegionTable>(*first);
+    second->remove(a);
+    first.reset();
+
+    RegionState* state = reader->state(a);
+    CHECK(state != nullptr);
+    if (state) {
+        std::lock_guard<std::mutex> lock(state->lock);
+        CHECK_EQ(state->info.size, 7u);
+    }
+    CHECK(second->state(a) == nullptr);
+}
+
+// Scans run against whichever table is published while writers keep
+// protecting and unprotecting other regions.
+void testScansDuringRegistration() {
+    MemoryMonitor monitor;
+    monitor.startMonitoring();
+    CHECK(monitor.protectMemoryRegion("stable"));
+    RegionId stable = monitor.getRegionId("stable");
+    CHECK(stable != kInvalidRegionId);
+
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::atomic<int> scans(0);
+    std::thread scanner([&]() {
+        while (!done) {
+            if (!monitor.scanMemoryRegion(stable)) {
+                failures++;
+            }
+            if (!monitor.scanMemoryRegion("stable")) {
+                failures++;
+            }
+            scans++;
+        }
+    });
+
+    for (int round = 0; round < 200; round++) {
+        std::string name = "churn" + std::to_string(round % 8);
+        CHECK(monitor.protectMemoryRegion(name));
+        CHECK(monitor.unprotectMemoryRegion(name));
+    }
+    while (scans < 10) {
+        std::this_thread::yield();
+    }
+    done = true;
+    scanner.join();
+    CHECK_EQ(failures.load(), 0);
+
+    // The churned names kept their ids across protect cycles.
+    RegionId churn = monitor.getRegionId("churn0");
+    CHECK(monitor.protectMemoryRegion("churn0"));
+    CHECK_EQ(monitor.getRegionId("churn0"), churn);
+    CHECK(monitor.scanAllProtectedRegions());
+    monitor.stopMonitoring();
+}
+
+// Names live in chunks of 64, 128, 256, ... entries; ids on both sides of
+// every boundary must resolve to the name they were assigned.
+void testNameChunkBoundaries() {
+    const size_t kCount = 64 * ((1 << 11) - 1) + 5;
+    RegionTable table;
+    std::vector<RegionId> ids;
+    ids.reserve(kCount);
+    for (size_t i = 0; i < kCount; i++) {
+        ids.push_back(table.intern("region" + std::to_string(i)));
+    }
+
+    bool sequential = true;
+    bool resolved = true;
+    for (size_t i = 0; i < kCount; i++) {
+        sequential = sequential && ids[i] == static_cast<RegionId>(i);
+        resolved = resolved && table.name(ids[i]) == "region" + std::to_string(i);
+    }
+    CHECK(sequential);
+    CHECK(resolved);
+
+    for (size_t chunk = 1; chunk < 11; chunk++) {
+        size_t first = ((static_cast<size_t>(1) << chunk) - 1) * 64;
+        for (size_t i = first - 1; i <= first; i++) {
+            CHECK_EQ(table.find("region" + std::to_string(i)), static_cast<RegionId>(i));
+            CHECK_EQ(table.name(static_cast<RegionId>(i)), "region" + std::to_string(i));
+        }
+    }
+}
+
+// A table's names stay in place while copies keep appending, so readers of
+// an older snapshot never see them move or change.
+void testNamesStableWhileAppending() {
+    RegionTable snapshot;
+    std::vector<const std::string*> names;
+    for (int i = 0; i < 100; i++) {
+        names.push_back(&snapshot.name(snapshot.intern("early" + std::to_string(i))));
+    }
+
+    std::atomic<bool> done(false);
+    std::thread writer([&snapshot, &done]() {
+        RegionTable copy = snapshot;
+        for (int i = 0; i < 20000; i++) {
+            copy.intern("late" + std::to_string(i));
+        }
+        done = true;
+    });
+
+    bool stable = true;
+    while (!done) {
+        for (int i = 0; i < 100; i++) {
+            stable = stable && &snapshot.name(i) == names[i] && *names[i] == "early" + std::to_string(i);
+        }
+    }
+    writer.join();
+    CHECK(stable);
+    CHECK_EQ(snapshot.find("late0"), kInvalidRegionId);
+}
+
+// Batch registration fills one copy and publishes it once; the result must
+// match protecting the regions one by one.
+void testBatchRegistration() {
+    MemoryMonitor monitor;
+    monitor.startMonitoring();
+    std::vector<std::string> regions;
+    for (int i = 0; i < 300; i++) {
+        regions.push_back("batch" + std::to_string(i));
+    }
+    regions.push_back("batch7");
+    std::vector<RegionId> ids;
+    monitor.protectMemoryRegions(regions, true, ids);
+
+    CHECK_EQ(ids.size(), regions.size());
+    bool matching = true;
+    for (size_t i = 0; i < regions.size(); i++) {
+        matching = matching && ids[i] != kInvalidRegionId && monitor.getRegionId(regions[i]) == ids[i];
+    }
+    CHECK(matching);
+    CHECK_EQ(ids.back(), ids[7]);
+    CHECK_EQ(monitor.getProtectedRegions().size(), 300u);
+    CHECK_EQ(monitor.getCriticalRegions().size(), 300u);
+    CHECK(monitor.scanAllProtectedRegions());
+    monitor.stopMonitoring();
+}
+
+} // namespace
+
+int main() {
+    testInterning();
+    testProtectedOrder();
+    testCriticalAndGroups();
+    testCopiesAreSnapshots();
+    testStateOutlivesUnprotect();
+    testScansDuringRegistration();
+    testNameChunkBoundaries();
+    testNamesStableWhileAppending();
+    testBatchRegistration();
+    return testResult("region_table_test");
+}
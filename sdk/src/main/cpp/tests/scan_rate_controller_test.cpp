@@ -0,0 +1,251 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "scan_rate_controller.h"
+#include "test_support.h"
+
+namespace {
+
+typedef ScanRateController::Candidate Candidate;
+
+AdaptiveScanConfig configWith(uint32_t timeSlices, uint64_t maxTickBytes = 0) {
+    AdaptiveScanConfig config;
+    config.base_interval_ms = 1000;
+    config.max_interval_ms = 30000;
+    config.time_slices = timeSlices;
+    config.max_tick_bytes = maxTickBytes;
+    return config;
+}
+
+// Runs `ticks` plans and records, per region, the ticks it was selected on
+// and the bytes each tick scanned.
+struct Simulation {
+    std::vector<std::vector<uint64_t>> scanned_at;
+    std::vector<uint64_t> tick_bytes;
+
+    void run(ScanRateController& controller, const std::vector<Candidate>& candidates, int ticks) {
+        scanned_at.resize(candidates.size());
+        std::vector<RegionId> selected;
+        for (int tick = 0; tick < ticks; tick++) {
+            controller.plan(candidates, selected);
+            uint64_t bytes = 0;
+            for (RegionId id : selected) {
+                scanned_at[id].push_back(tick_bytes.size());
+                bytes += candidates[id].size;
+            }
+            tick_bytes.push_back(bytes);
+        }
+    }
+
+    // Longest stretch of ticks, from the first, without a scan of `id`.
+    uint64_t maxGap(RegionId id) const {
+        uint64_t previous = 0;
+        uint64_t gap = 0;
+        for (uint64_t tick : scanned_at[id]) {
+            gap = std::max(gap, tick - previous);
+            previous = tick;
+        }
+        return std::max<uint64_t>(gap, tick_bytes.size() - previous);
+    }
+};
+
+std::vector<Candidate> uniformCandidates(size_t count, uint64_t size) {
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < count; i++) {
+        candidates.push_back(Candidate{static_cast<RegionId>(i), size, false});
+    }
+    return candidates;
+}
+
+void testEqualRegionsSpreadEvenly() {
+    ScanRateController controller;
+    controller.configure(configWith(8));
+    std::vector<Candidate> candidates = uniformCandidates(16, 4096);
+    Simulation sim;
+    sim.run(controller, candidates, 80);
+
+    // Two regions per tick, each region once every eight ticks.
+    bool even = true;
+    for (uint64_t bytes : sim.tick_bytes) {
+        even = even && bytes == 2 * 4096;
+    }
+    CHECK(even);
+    bool fair = true;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        fair = fair && sim.scanned_at[i].size() == 10;
+    }
+    CHECK(fair);
+}
+
+void testMixedSizesStayCovered() {
+    ScanRateController controller;
+    controller.configure(configWith(8));
+    std::vector<Candidate> candidates;
+    uint8_t sizes[40];
+    fillPattern(sizes, sizeof(sizes), 7);
+    uint64_t largest = 0;
+    for (size_t i = 0; i < sizeof(sizes); i++) {
+        uint64_t size = (static_cast<uint64_t>(sizes[i]) + 1) * 1024;
+        largest = std::max(largest, size);
+        candidates.push_back(Candidate{static_cast<RegionId>(i), size, false});
+    }
+    uint64_t total = 0;
+    for (const Candidate& candidate : candidates) {
+        total += candidate.size;
+    }
+    Simulation sim;
+    sim.run(controller, candidates, 200);
+
+    // A tick spends its budget plus at most one region, and the whole set
+    // is still covered about every time_slices ticks.
+    uint64_t budget = (total + 7) / 8;
+    bool bounded = true;
+    for (uint64_t bytes : sim.tick_bytes) {
+        bounded = bounded && bytes <= budget + largest;
+    }
+    CHECK(bounded);
+    bool covered = true;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        covered = covered && sim.maxGap(static_cast<RegionId>(i)) <= 2 * 8;
+    }
+    CHECK(covered);
+}
+
+void testCriticalRegionsScanMoreOften() {
+    ScanRateController controller;
+    controller.configure(configWith(8));
+    std::vector<Candidate> candidates = uniformCandidates(12, 1000);
+    candidates[3].critical = true;
+    Simulation sim;
+    sim.run(controller, candidates, 160);
+
+    // A quarter of the period, so about four times the scans.
+    CHECK(sim.scanned_at[3].size() >= 3 * sim.scanned_at[0].size());
+    CHECK(sim.maxGap(3) <= 2 * 2);
+}
+
+void testTamperedRegionFollowedUp() {
+    ScanRateController controller;
+    controller.configure(configWith(8));
+    std::vector<Candidate> candidates = uniformCandidates(16, 1000);
+    Simulation warmup;
+    warmup.run(controller, candidates, 16);
+
+    controller.recordTamper(5);
+    Simulation followUp;
+    followUp.run(controller, candidates, 7);
+    // Scanned on every tick while the tamper is recent...
+    CHECK_EQ(followUp.scanned_at[5].size(), 7u);
+
+    // ...then back to the normal period.
+    Simulation later;
+    later.run(controller, candidates, 32);
+    CHECK(later.scanned_at[5].size() <= 6u);
+}
+
+void testTickByteCap() {
+    ScanRateController controller;
+    controller.configure(configWith(1, 3000));
+    std::vector<Candidate> candidates = uniformCandidates(10, 1000);
+    Simulation sim;
+    sim.run(controller, candidates, 20);
+
+    // The cap wins over time_slices = 1, but every tick still scans.
+    bool capped = true;
+    for (uint64_t bytes : sim.tick_bytes) {
+        capped = capped && bytes > 0 && bytes <= 3000 + 1000;
+    }
+    CHECK(capped);
+
+    // A region larger than the cap is still scanned, alone.
+    ScanRateController big;
+    big.configure(configWith(1, 100));
+    std::vector<Candidate> one = {Candidate{0, 1 << 20, false}};
+    std::vector<RegionId> selected;
+    big.plan(one, selected);
+    CHECK((selected == std::vector<RegionId>{0}));
+}
+
+void testEverythingEveryTick() {
+    ScanRateController controller;
+    AdaptiveScanConfig config = configWith(0);
+    controller.configure(config);
+    CHECK_EQ(controller.config().time_slices, 1u);
+
+    std::vector<Candidate> candidates = uniformCandidates(5, 1234);
+    // Invalid ids are ignored.
+    candidates.push_back(Candidate{kInvalidRegionId, 99, true});
+    std::vector<RegionId> selected;
+    for (int tick = 0; tick < 5; tick++) {
+        controller.plan(candidates, selected);
+        CHECK_EQ(selected.size(), 5u);
+    }
+    controller.plan(std::vector<Candidate>(), selected);
+    CHECK(selected.empty());
+}
+
+void testInterval() {
+    ScanRateController controller;
+    controller.configure(configWith(4));
+    CHECK_EQ(controller.interval().count(), 1000);
+
+    DeviceState state;
+    state.foreground = false;
+    controller.setDeviceState(state);
+    CHECK_EQ(controller.interval().count(), 4000);
+    state.battery_saver = true;
+    controller.setDeviceState(state);
+    CHECK_EQ(controller.interval().count(), 8000);
+    state.thermal_status = 2;
+    controller.setDeviceState(state);
+    CHECK_EQ(controller.interval().count(), 16000);
+    state.thermal_status = 4;
+    controller.setDeviceState(state);
+    CHECK_EQ(controller.interval().count(), 30000);
+
+    // A tamper snaps back to the base interval for time_slices ticks.
+    std::vector<Candidate> candidates = uniformCandidates(2, 10);
+    std::vector<RegionId> selected;
+    controller.plan(candidates, selected);
+    controller.recordTamper(1);
+    for (int tick = 0; tick < 3; tick++) {
+        controller.plan(candidates, selected);
+        CHECK_EQ(controller.interval().count(), 1000);
+    }
+    controller.plan(candidates, selected);
+    CHECK_EQ(controller.interval().count(), 30000);
+
+    AdaptiveScanConfig inverted = configWith(4);
+    inverted.base_interval_ms = 5000;
+    inverted.max_interval_ms = 100;
+    controller.configure(inverted);
+    CHECK_EQ(controller.config().max_interval_ms, 5000u);
+}
+
+} // namespace
+
+int main() {
+    testEqualRegionsSpreadEvenly();
+    testMixedSizesStayCovered();
+    testCriticalRegionsScanMoreOften();
+    testTamperedRegionFollowedUp();
+    testTickByteCap();
+    testEverythingEveryTick();
+    testInterval();
+    return testResult("scan_rate_controller_test");
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Known-answer tests for every SHA-256 backend available on this machine,
+// and SHA256_MultiUpdate against serial hashing on each multi-buffer kernel.
+
+#include <algorithm>
+
+#include <openssl/sha.h>
+#include "sha256_internal.h"
+#include "test_support.h"
+
+namespace {
+
+struct Backend {
+    const char* name;
+    sha256_block_fn blocks;
+};
+
+struct Kernel {
+    const char* name;
+    sha256_multi_block_fn blocks;
+    size_t lanes;
+};
+
+// FIPS 180-2 appendix B and the NIST CAVS long-message vector.
+struct KnownAnswer {
+    std::string message;
+    const char* digest;
+};
+
+std::vector<KnownAnswer> knownAnswers() {
+    return {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+         "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+        {std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+}
+
+std::vector<Backend> availableBackends() {
+    std::vector<Backend> backends = {{"scalar", sha256_blocks_scalar}};
+    if (sha256_block_fn armv8 = sha256_blocks_armv8_backend()) {
+        backends.push_back({"armv8-ce", armv8});
+    }
+    if (sha256_block_fn shani = sha256_blocks_shani_backend()) {
+        backends.push_back({"sha-ni", shani});
+    }
+    return backends;
+}
+
+std::vector<Kernel> availableKernels() {
+    std::vector<Kernel> kernels = {{"x4", sha256_multi_blocks_x4, 4}};
+    if (sha256_multi_block_fn avx2 = sha256_multi_blocks_avx2_backend()) {
+        kernels.push_back({"avx2", avx2, 8});
+    }
+    return kernels;
+}
+
+std::string digestOf(const void* data, size_t size) {
+    SHA256_CTX ctx;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, data, size);
+    SHA256_Final(digest, &ctx);
+    return toHex(digest, sizeof(digest));
+}
+
+// Feeds `data` in pieces of every length from 1 to 130 bytes in turn, so
+// partial blocks are buffered across every possible boundary.
+std::string digestInPieces(const uint8_t* data, size_t size) {
+    SHA256_CTX ctx;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256_Init(&ctx);
+    size_t piece = 1;
+    for (size_t offset = 0; offset < size;) {
+        size_t length = piece < size - offset ? piece : size - offset;
+        SHA256_Update(&ctx, data + offset, length);
+        offset += length;
+        piece = piece % 130 + 1;
+    }
+    SHA256_Final(digest, &ctx);
+    return toHex(digest, sizeof(digest));
+}
+
+void testKnownAnswers(const Backend& backend) {
+    CHECK(sha256_set_backend(backend.name, backend.blocks, NULL, 1));
+    for (const KnownAnswer& answer : knownAnswers()) {
+        CHECK_EQ(digestOf(answer.message.data(), answer.message.size()), std::string(answer.digest));
+        CHECK_EQ(digestInPieces(reinterpret_cast<const uint8_t*>(answer.message.data()), answer.message.size()),
+                 std::string(answer.digest));
+    }
+}
+
+// Every backend has to produce the scalar states block for block.
+void testBlocksMatchScalar(const Backend& backend) {
+    std::vector<uint8_t> data(64 * 33);
+    fillPattern(data.data(), data.size(), 7);
+    for (size_t blocks = 0; blocks <= 33; blocks++) {
+        SHA256_CTX expected, actual;
+        SHA256_Init(&expected);
+        SHA256_Init(&actual);
+        sha256_blocks_scalar(expected.h, data.data(), blocks);
+        backend.blocks(actual.h, data.data(), blocks);
+        CHECK(memcmp(expected.h, actual.h, sizeof(expected.h)) == 0);
+    }
+}
+
+// Random batches of mixed lengths, some contexts already holding a partial
+// block, hashed through the lanes and one by one with the scalar backend.
+void testMultiUpdate(const Kernel& kernel, uint32_t seed) {
+    CHECK(sha256_set_backend("scalar", sha256_blocks_scalar, kernel.blocks, kernel.lanes));
+    CHECK_EQ(sha256_multi_lanes(), kernel.lanes);
+
+    uint32_t rng = seed;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    for (int trial = 0; trial < 60; trial++) {
+        size_t count = next() % 150;
+        std::vector<std::vector<uint8_t>> messages(count);
+        std::vector<SHA256_CTX> serial(count), batched(count);
+        std::vector<SHA256_CTX*> contexts(count);
+        std::vector<const void*> data(count);
+        std::vector<size_t> lengths(count);
+        for (size_t i = 0; i < count; i++) {
+            size_t length = next() % 4 ? next() % 5000 : next() % 100000;
+            messages[i].resize(length);
+            fillPattern(messages[i].data(), length, next());
+
+            size_t prefix = std::min<size_t>(next() % 100, length);
+            SHA256_Init(&serial[i]);
+            SHA256_Init(&batched[i]);
+            SHA256_Update(&serial[i], messages[i].data(), length);
+            SHA256_Update(&batched[i], messages[i].data(), prefix);
+            contexts[i] = &batched[i];
+            data[i] = messages[i].data() + prefix;
+            lengths[i] = length - prefix;
+        }
+
+        CHECK(SHA256_MultiUpdate(contexts.data(), data.data(), lengths.data(), count));
+        for (size_t i = 0; i < count; i++) {
+            uint8_t expected[SHA256_DIGEST_LENGTH], actual[SHA256_DIGEST_LENGTH];
+            SHA256_Final(expected, &serial[i]);
+            SHA256_Final(actual, &batched[i]);
+            CHECK(memcmp(expected, actual, sizeof(expected)) == 0);
+        }
+    }
+}
+
+// Known answers through the lanes, eight copies of each message at once.
+void testMultiKnownAnswers(const Kernel& kernel) {
+    CHECK(sha256_set_backend("scalar", sha256_blocks_scalar, kernel.blocks, kernel.lanes));
+    for (const KnownAnswer& answer : knownAnswers()) {
+        SHA256_CTX ctx[8];
+        SHA256_CTX* contexts[8];
+        const void* data[8];
+        size_t lengths[8];
+        for (int i = 0; i < 8; i++) {
+            SHA256_Init(&ctx[i]);
+            contexts[i] = &ctx[i];
+            data[i] = answer.message.data();
+            lengths[i] = answer.message.size();
+        }
+        CHECK(SHA256_MultiUpdate(contexts, data, lengths, 8));
+        for (int i = 0; i < 8; i++) {
+            uint8_t digest[SHA256_DIGEST_LENGTH];
+            SHA256_Final(digest, &ctx[i]);
+            CHECK_EQ(toHex(digest, sizeof(digest)), std::string(answer.digest));
+        }
+    }
+}
+
+void testSetBackendRejectsInvalid() {
+    CHECK(!sha256_set_backend(NULL, sha256_blocks_scalar, NULL, 1));
+    CHECK(!sha256_set_backend("scalar", NULL, NULL, 1));
+    CHECK(!sha256_set_backend("scalar", sha256_blocks_scalar, NULL, 4));
+    CHECK(!sha256_set_backend("scalar", sha256_blocks_scalar, sha256_multi_blocks_x4, 9));
+    CHECK(!sha256_set_backend("scalar", sha256_blocks_scalar, sha256_multi_blocks_x4, 0));
+}
+
+} // namespace
+
+int main() {
+    for (const Backend& backend : availableBackends()) {
+        printf("backend %s\n", backend.name);
+        testKnownAnswers(backend);
+        testBlocksMatchScalar(backend);
+    }
+    for (const Kernel& kernel : availableKernels()) {
+        printf("multi-buffer kernel %s (%zu lanes)\n", kernel.name, kernel.lanes);
+        testMultiUpdate(kernel, 0x9e3779b9u);
+        testMultiKnownAnswers(kernel);
+    }
+    testSetBackendRejectsInvalid();
+    return testResult("sha256_test");
+}
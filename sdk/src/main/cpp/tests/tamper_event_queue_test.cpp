@@ -0,0 +1,233 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "tamper_event_queue.h"
+#include "test_support.h"
+
+namespace {
+
+// Collects every batch the dispatcher hands over.
+class Recorder {
+public:
+    TamperingBatchCallback handler() {
+        return [this](const std::vector<TamperEvent>& batch) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(batch);
+        };
+    }
+
+    std::vector<std::vector<TamperEvent>> batches() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+    // Events delivered so far, coalesced ones counted individually.
+    uint64_t total() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t total = 0;
+        for (const auto& batch : batches_) {
+            for (const auto& event : batch) {
+                total += event.count;
+            }
+        }
+        return total;
+    }
+
+    bool waitForTotal(uint64_t expected) {
+        for (int i = 0; i < 500; i++) {
+            if (total() >= expected) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::vector<TamperEvent>> batches_;
+};
+
+void testCoalescesIdenticalEvents() {
+    TamperEventQueue queue(16, 1);
+    CHECK(queue.push("a", "changed"));
+    CHECK(queue.push("b", "changed"));
+    CHECK(queue.push("a", "changed"));
+    CHECK(queue.push("a", "resized"));
+    CHECK(queue.push("a", "changed"));
+
+    Recorder recorder;
+    queue.setHandler(recorder.handler());
+    CHECK(recorder.waitForTotal(5));
+    queue.stop();
+
+    std::vector<std::vector<TamperEvent>> batches = recorder.batches();
+    CHECK_EQ(batches.size(), 1u);
+    if (batches.size() == 1 && batches[0].size() == 3) {
+        // Merged events keep the order they were first seen in.
+        CHECK_EQ(batches[0][0].region, std::string("a"));
+        CHECK_EQ(batches[0][0].details, std::string("changed"));
+        CHECK_EQ(batches[0][0].count, 3u);
+        CHECK_EQ(batches[0][1].region, std::string("b"));
+        CHECK_EQ(batches[0][1].count, 1u);
+        CHECK_EQ(batches[0][2].details, std::string("resized"));
+        CHECK_EQ(batches[0][2].count, 1u);
+    } else {
+        CHECK(false);
+    }
+}
+
+void testFullRingDropsAndReports() {
+    // Rounded up to four slots.
+    TamperEventQueue queue(3, 1);
+    for (int i = 0; i < 4; i++) {
+        CHECK(queue.push("region", std::to_string(i)));
+    }
+    CHECK(!queue.push("region", "4"));
+    CHECK(!queue.push("region", "5"));
+    CHECK_EQ(queue.dropped(), 2u);
+
+    Recorder recorder;
+    queue.setHandler(recorder.handler());
+    CHECK(recorder.waitForTotal(6));
+    queue.stop();
+
+    std::vector<std::vector<TamperEvent>> batches = recorder.batches();
+    CHECK(!batches.empty());
+    if (!batches.empty()) {
+        const TamperEvent& last = batches[0].back();
+        CHECK_EQ(last.region, std::string("tamper_event_queue"));
+        CHECK_EQ(last.count, 2u);
+    }
+
+    // Drained slots are reusable.
+    TamperEventQueue reused(4, 1);
+    Recorder second;
+    reused.setHandler(second.handler());
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 4; i++) {
+            reused.push("round", std::to_string(round * 4 + i));
+        }
+        CHECK(second.waitForTotal((round + 1) * 4));
+    }
+    reused.stop();
+    CHECK_EQ(reused.dropped(), 0u);
+}
+
+void testStopDeliversQueuedEvents() {
+    // The window is far longer than the test; stop() must cut it short.
+    TamperEventQueue queue(16, 60000);
+    Recorder recorder;
+    queue.setHandler(recorder.handler());
+    queue.push("a", "one");
+    queue.push("b", "two");
+
+    auto start = std::chrono::steady_clock::now();
+    queue.stop();
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+    CHECK_EQ(recorder.total(), 2u);
+    // A second stop() is harmless.
+    queue.stop();
+}
+
+void testStopFromHandler() {
+    std::atomic<bool> onDispatcher(false);
+    std::atomic<int> calls(0);
+    {
+        TamperEventQueue queue(16, 1);
+        queue.setHandler([&](const std::vector<TamperEvent>&) {
+            onDispatcher = queue.isDispatcherThread();
+            calls++;
+            queue.stop();
+        });
+        queue.push("a", "one");
+        for (int i = 0; i < 500 && calls == 0; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        CHECK(!queue.isDispatcherThread());
+        // The dispatcher stopped itself; destroying the queue here must
+        // join it rather than free it underneath the thread.
+    }
+    CHECK_EQ(calls.load(), 1);
+    CHECK(onDispatcher.load());
+}
+
+void testHandlerLifecycle() {
+    TamperEventQueue queue(16, 1);
+    queue.setHandler(nullptr);
+    CHECK(!queue.isActive());
+
+    std::atomic<int> starts(0);
+    std::atomic<int> exits(0);
+    DispatcherHooks hooks;
+    hooks.on_start = [&]() { starts++; };
+    hooks.on_exit = [&]() { exits++; };
+    Recorder recorder;
+    queue.setHandler(recorder.handler(), hooks);
+    CHECK(queue.isActive());
+    // Replacing the handler keeps the running dispatcher.
+    queue.setHandler(recorder.handler(), hooks);
+    queue.push("a", "one");
+    CHECK(recorder.waitForTotal(1));
+    queue.stop();
+    CHECK_EQ(starts.load(), 1);
+    CHECK_EQ(exits.load(), 1);
+}
+
+void testConcurrentProducers() {
+    const int kThreads = 4;
+    const int kEvents = 2000;
+    TamperEventQueue queue(64, 1);
+    Recorder recorder;
+    queue.setHandler(recorder.handler());
+
+    std::atomic<uint64_t> accepted(0);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; t++) {
+        producers.emplace_back([&queue, &accepted, t]() {
+            for (int i = 0; i < kEvents; i++) {
+                if (queue.push("thread" + std::to_string(t), std::to_string(i % 7))) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    queue.stop();
+
+    // Every push is either delivered or counted in a drop report.
+    CHECK_EQ(accepted.load() + queue.dropped(), static_cast<uint64_t>(kThreads) * kEvents);
+    CHECK_EQ(recorder.total(), static_cast<uint64_t>(kThreads) * kEvents);
+}
+
+} // namespace
+
+int main() {
+    testCoalescesIdenticalEvents();
+    testFullRingDropsAndReports();
+    testStopDeliversQueuedEvents();
+    testStopFromHandler();
+    testHandlerLifecycle();
+    testConcurrentProducers();
+    return testResult("tamper_event_queue_test");
+}
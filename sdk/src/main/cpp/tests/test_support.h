@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Minimal assertion helpers shared by the host tests. Every test binary is
+// one ctest case: it runs all of its checks, prints each failing one, and
+// exits non-zero if any failed.
+
+#ifndef APP_PROTECTION_TEST_SUPPORT_H
+#define APP_PROTECTION_TEST_SUPPORT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+inline int& testFailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,      \
+                    #condition);                                                  \
+            testFailureCount()++;                                                 \
+        }                                                                         \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CHECK((actual) == (expected))
+
+inline int testResult(const char* name) {
+    if (testFailureCount() > 0) {
+        fprintf(stderr, "%s: %d checks failed\n", name, testFailureCount());
+        return 1;
+    }
+    printf("%s: all checks passed\n", name);
+    return 0;
+}
+
+inline std::string toHex(const uint8_t* data, size_t size) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(size * 2);
+    for (size_t i = 0; i < size; i++) {
+        hex.push_back(kDigits[data[i] >> 4]);
+        hex.push_back(kDigits[data[i] & 0x0f]);
+    }
+    return hex;
+}
+
+// Deterministic test data; xorshift so runs are reproducible everywhere.
+inline void fillPattern(uint8_t* data, size_t size, uint32_t seed) {
+    uint32_t x = seed ? seed : 1;
+    for (size_t i = 0; i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = static_cast<uint8_t>(x);
+    }
+}
+
+// Temporary file removed when the object goes out of scope.
+class TempFile {
+public:
+    explicit TempFile(const char* tag) {
+        const char* dir = getenv("TMPDIR");
+        path_ = std::string(dir && *dir ? dir : "/tmp") + "/app_protection_" + tag + "_XXXXXX";
+        int fd = mkstemp(&path_[0]);
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+    ~TempFile() { unlink(path_.c_str()); }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    bool write(const void* data, size_t size) const {
+        FILE* file = fopen(path_.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        bool ok = fwrite(data, 1, size, file) == size;
+        return fclose(file) == 0 && ok;
+    }
+
+    bool write(const std::string& text) const { return write(text.data(), text.size()); }
+
+    std::vector<uint8_t> read() const {
+        std::vector<uint8_t> bytes;
+        FILE* file = fopen(path_.c_str(), "rb");
+        if (!file) {
+            return bytes;
+        }
+        uint8_t buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            bytes.insert(bytes.end(), buffer, buffer + n);
+        }
+        fclose(file);
+        return bytes;
+    }
+
+private:
+    std::string path_;
+};
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Writes a golden manifest (see golden_manifest.h) for libraries and files
+// shipped with the app. This is a host tool; the resulting file is embedded
+// into libapp_protection.so by configuring the library with
+// -DAPP_PROTECTION_MANIFEST=<manifest>.
+//
+//   app_protection_manifest_tool --output=<manifest> [--chunk-size=<bytes>]
+//                                [--page-size=<bytes>] <input>...
+//
+// An input is a path, entered under its file name, or <name>=<path>. Names
+// starting with "elf:" are shared libraries: their first readable executable
+// PT_LOAD segment is hashed page by page, exactly as the loaded library's
+// "elf:" region is, so --page-size must match the device (4096 by default).
+// Other inputs are hashed whole, or in --chunk-size chunks when given.
+
+#include <elf.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <openssl/sha.h>
+#include "code_segment.h"
+#include "golden_manifest.h"
+#include "merkle_tree.h"
+
+namespace {
+
+struct Options {
+    std::string output;
+    size_t chunk_size = 0;
+    size_t page_size = 4096;
+    std::vector<std::string> inputs;
+};
+
+struct Input {
+    std::string name;
+    std::vector<uint8_t> contents;
+    size_t chunk_size;
+};
+
+bool readFile(const std::string& path, std::vector<uint8_t>& contents) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    contents.clear();
+    uint8_t buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.insert(contents.end(), buffer, buffer + n);
+    }
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if (failed) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+    }
+    return !failed;
+}
+
+// Bytes of the library's first readable executable segment as the loader
+// maps them: whole pages from the file, zero past its end.
+template <typename Ehdr, typename Phdr>
+bool extractCodeSegment(const std::vector<uint8_t>& file, size_t pageSize, std::vector<uint8_t>& segment) {
+    if (file.size() < sizeof(Ehdr)) {
+        return false;
+    }
+    const Ehdr* header = reinterpret_cast<const Ehdr*>(file.data());
+    if (header->e_phoff + static_cast<uint64_t>(header->e_phnum) * sizeof(Phdr) > file.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < header->e_phnum; i++) {
+        Phdr phdr;
+        memcpy(&phdr, file.data() + header->e_phoff + i * sizeof(Phdr), sizeof(Phdr));
+        if (phdr.p_type != PT_LOAD || !(phdr.p_flags & PF_X) || !(phdr.p_flags & PF_R) || phdr.p_memsz == 0) {
+            continue;
+        }
+
+        uint64_t pageMask = ~(static_cast<uint64_t>(pageSize) - 1);
+        uint64_t start = phdr.p_vaddr & pageMask;
+        uint64_t end = (phdr.p_vaddr + phdr.p_memsz + pageSize - 1) & pageMask;
+        uint64_t offset = phdr.p_offset - (phdr.p_vaddr - start);
+        segment.assign(static_cast<size_t>(end - start), 0);
+        if (offset < file.size()) {
+            size_t available = static_cast<size_t>(std::min<uint64_t>(end - start, file.size() - offset));
+            memcpy(segment.data(), file.data() + offset, available);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool loadInput(const std::string& argument, const Options& options, Input& input) {
+    size_t equals = argument.find('=');
+    std::string path = equals == std::string::npos ? argument : argument.substr(equals + 1);
+    input.name = equals == std::string::npos ? manifestNameOf(path) : argument.substr(0, equals);
+
+    std::vector<uint8_t> file;
+    if (!readFile(path, file)) {
+        return false;
+    }
+    if (!isCodeRegion(input.name)) {
+        input.contents.swap(file);
+        input.chunk_size = options.chunk_size;
+        return true;
+    }
+
+    input.chunk_size = options.page_size;
+    bool extracted = false;
+    if (file.size() >= EI_NIDENT && memcmp(file.data(), ELFMAG, SELFMAG) == 0) {
+        extracted = file[EI_CLASS] == ELFCLASS64
+                ? extractCodeSegment<Elf64_Ehdr, Elf64_Phdr>(file, options.page_size, input.contents)
+                : extractCodeSegment<Elf32_Ehdr, Elf32_Phdr>(file, options.page_size, input.contents);
+    }
+    if (!extracted) {
+        fprintf(stderr, "%s has no readable executable segment\n", path.c_str());
+    }
+    return extracted;
+}
+
+bool writeManifest(const std::string& path, std::vector<Input>& inputs) {
+    std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.name < b.name; });
+    for (size_t i = 1; i < inputs.size(); i++) {
+        if (inputs[i].name == inputs[i - 1].name) {
+            fprintf(stderr, "Duplicate manifest entry %s\n", inputs[i].name.c_str());
+            return false;
+        }
+    }
+
+    std::vector<ManifestEntry> entries(inputs.size());
+    std::vector<uint8_t> digests;
+    std::string names;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const Input& input = inputs[i];
+        ManifestEntry& entry = entries[i];
+        memset(&entry, 0, sizeof(entry));
+        entry.name_offset = static_cast<uint32_t>(names.size());
+        entry.name_length = static_cast<uint32_t>(input.name.size());
+        entry.size = input.contents.size();
+        entry.chunk_size = static_cast<uint32_t>(input.chunk_size);
+        entry.first_digest = static_cast<uint32_t>(digests.size() / SHA256_DIGEST_LENGTH);
+        names += input.name;
+
+        if (input.chunk_size == 0) {
+            SHA256_CTX sha256;
+            SHA256_Init(&sha256);
+            SHA256_Update(&sha256, input.contents.data(), input.contents.size());
+            SHA256_Final(entry.root, &sha256);
+            continue;
+        }
+        size_t count = merkleChunkCount(input.contents.size(), input.chunk_size);
+        size_t first = digests.size();
+        digests.resize(first + count * SHA256_DIGEST_LENGTH);
+        merkleHashChunks(input.contents.data(), input.contents.size(), input.chunk_size, 0, count,
+                         digests.data() + first);
+        merkleRoot(digests.data() + first, count, entry.root);
+        entry.digest_count = static_cast<uint32_t>(count);
+    }
+
+    ManifestHeader header;
+    header.magic = kManifestMagic;
+    header.version = kManifestVersion;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.digest_count = static_cast<uint32_t>(digests.size() / SHA256_DIGEST_LENGTH);
+    header.names_offset = static_cast<uint32_t>(sizeof(header) + entries.size() * sizeof(ManifestEntry) + digests.size());
+    header.names_size = static_cast<uint32_t>(names.size());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (entries.empty() || fwrite(entries.data(), sizeof(ManifestEntry), entries.size(), file) == entries.size()) &&
+                   (digests.empty() || fwrite(digests.data(), 1, digests.size(), file) == digests.size()) &&
+                   (names.empty() || fwrite(names.data(), 1, names.size(), file) == names.size());
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+    }
+    return written;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--output=") == 0) {
+            options.output = arg.substr(9);
+        } else if (arg.compare(0, 13, "--chunk-size=") == 0) {
+            options.chunk_size = strtoull(arg.c_str() + 13, nullptr, 10);
+        } else if (arg.compare(0, 12, "--page-size=") == 0) {
+            options.page_size = strtoull(arg.c_str() + 12, nullptr, 10);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    bool pageSizeValid = options.page_size >= 4096 && (options.page_size & (options.page_size - 1)) == 0;
+    return !options.output.empty() && pageSizeValid;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "Usage: %s --output=<manifest> [--chunk-size=<bytes>] [--page-size=<bytes>] "
+                        "[<name>=]<path>...\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Input> inputs(options.inputs.size());
+    for (size_t i = 0; i < options.inputs.size(); i++) {
+        if (!loadInput(options.inputs[i], options, inputs[i])) {
+            return 1;
+        }
+    }
+    if (!writeManifest(options.output, inputs)) {
+        return 1;
+    }
+    printf("Wrote %zu entries to %s\n", inputs.size(), options.output.c_str());
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_ring.h"
+#include <time.h>
+
+TraceRing& TraceRing::instance() {
+    static TraceRing ring;
+    return ring;
+}
+
+TraceRing::TraceRing() : head_(0), enabled_(false) {
+    for (auto& slot : slots_) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t TraceRing::nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void TraceRing::record(TraceOp op, int32_t region, uint64_t durationNs, uint16_t result) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    uint64_t ticket = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[ticket % kCapacity];
+
+    // Odd while the payload is being written, then 2 * (ticket + 1).
+    slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp_ns.store(nowNs(), std::memory_order_relaxed);
+    slot.duration_ns.store(durationNs, std::memory_order_relaxed);
+    slot.packed.store((static_cast<uint64_t>(static_cast<uint32_t>(region)) << 32) |
+                      (static_cast<uint64_t>(op) << 16) | result,
+                      std::memory_order_relaxed);
+    slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+void TraceRing::snapshot(std::vector<TraceEvent>& events) const {
+    events.clear();
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t first = head > kCapacity ? head - kCapacity : 0;
+
+    for (uint64_t ticket = first; ticket < head; ticket++) {
+        const Slot& slot = slots_[ticket % kCapacity];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * ticket + 2) {
+            continue;
+        }
+
+        TraceEvent event;
+        event.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+        event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+        uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        event.region = static_cast<int32_t>(packed >> 32);
+        event.op = static_cast<uint16_t>(packed >> 16);
+        event.result = static_cast<uint16_t>(packed);
+        events.push_back(event);
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APP_PROTECTION_TRACE_RING_H
+#define APP_PROTECTION_TRACE_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+enum TraceOp {
+    TRACE_SCAN_REGION = 1,
+    TRACE_SCAN_ALL = 2,
+    TRACE_TAMPER = 3,
+    TRACE_FILE_EVENT = 4,
+    TRACE_WRITE_TRAP = 5
+};
+
+struct TraceEvent {
+    uint64_t timestamp_ns;
+    uint64_t duration_ns;
+    int32_t region;
+    uint16_t op;
+    uint16_t result;
+};
+
+/**
+ * Process-wide, fixed-size ring of binary trace events. Recording is a few
+ * relaxed atomic stores with no formatting, locking or allocation, so it can
+ * stay on in hot paths where logging cannot. Old events are overwritten.
+ *
+ * Each slot carries a sequence number written before and after the payload;
+ * snapshot() drops slots that were being rewritten while it read them.
+ */
+class TraceRing {
+public:
+    static const size_t kCapacity = 1024;
+
+    static TraceRing& instance();
+
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(TraceOp op, int32_t region, uint64_t durationNs, uint16_t result);
+    // Copies the retained events, oldest first.
+    void snapshot(std::vector<TraceEvent>& events) const;
+
+    static uint64_t nowNs();
+
+private:
+    TraceRing();
+
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> timestamp_ns;
+        std::atomic<uint64_t> duration_ns;
+        // region << 32 | op << 16 | result
+        std::atomic<uint64_t> packed;
+    };
+
+    Slot slots_[kCapacity];
+    std::atomic<uint64_t> head_;
+    std::atomic<bool> enabled_;
+};
+
+#endif
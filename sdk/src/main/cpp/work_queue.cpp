@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "work_queue.h"
+#include <stdlib.h>
+#include "log.h"
+
+#define TAG "WorkQueue"
+
+WorkQueue::WorkQueue() : started_(false), stopping_(false) {
+}
+
+WorkQueue::~WorkQueue() {
+    stop();
+    if (worker_.joinable()) {
+        // Destroyed from inside a task, which run() returns to afterwards.
+        LOGE("Work queue destroyed from its own worker thread");
+        abort();
+    }
+}
+
+bool WorkQueue::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+        if (!started_) {
+            started_ = true;
+            worker_ = std::thread(&WorkQueue::run, this);
+        }
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void WorkQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    // Stopped from inside a task, the loop drains and exits on its own; the
+    // thread is joined by a later stop() from another thread.
+    if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) {
+        worker_.join();
+    }
+}
+
+bool WorkQueue::isWorkerThread() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return worker_.get_id() == std::this_thread::get_id();
+}
+
+size_t WorkQueue::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void WorkQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+            break;
+        }
+
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+    LOGD("Work queue drained");
+}
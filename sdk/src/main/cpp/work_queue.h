@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_WORK_QUEUE_H
+#define APP_PROTECTION_WORK_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Single native worker thread running posted tasks in FIFO order. The
+ * thread is started by the first post() and exits when the queue is
+ * stopped; stop() lets already queued tasks run first, so every task
+ * posted before it gets to report its outcome.
+ */
+class WorkQueue {
+public:
+    typedef std::function<void()> Task;
+
+    WorkQueue();
+    ~WorkQueue();
+
+    // Returns false once the queue has been stopped.
+    bool post(Task task);
+    // From inside a task it only signals; the queue must then not be
+    // destroyed on that thread.
+    void stop();
+    size_t pending() const;
+    bool isWorkerThread() const;
+
+private:
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    std::deque<Task> tasks_;
+    bool started_;
+    bool stopping_;
+};
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "write_trap.h"
+#include "log.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <thread>
+#include <ucontext.h>
+#include <unistd.h>
+
+#define TAG "WriteTrap"
+
+enum {
+    SUPPORT_UNKNOWN = -1,
+    SUPPORT_NO = 0,
+    SUPPORT_YES = 1
+};
+
+// Pages read from the trap pipe per wakeup.
+static const size_t kPagesPerRead = 64;
+
+#if defined(__aarch64__)
+// Signal frame record carrying the fault syndrome register.
+static const uint32_t kEsrMagic = 0x45535201;
+static const uint64_t kEsrWriteNotRead = 1ULL << 6;
+static const uint64_t kEsrInstructionAbortLower = 0x20;
+static const uint64_t kEsrInstructionAbort = 0x21;
+#endif
+
+// Whether the fault described by `context` was a write. Architectures
+// without a known encoding treat every access fault as one.
+static bool isWriteFault(void* context) {
+    const ucontext_t* uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__) || defined(__i386__)
+    return (uc->uc_mcontext.gregs[REG_ERR] & 0x2) != 0;
+#elif defined(__aarch64__)
+    const uint8_t* records = reinterpret_cast<const uint8_t*>(uc->uc_mcontext.__reserved);
+    size_t limit = sizeof(uc->uc_mcontext.__reserved);
+    for (size_t offset = 0; offset + 16 <= limit;) {
+        uint32_t header[2];
+        memcpy(header, records + offset, sizeof(header));
+        if (header[0] == 0 || header[1] == 0) {
+            break;
+        }
+        if (header[0] == kEsrMagic) {
+            uint64_t esr;
+            memcpy(&esr, records + offset + 8, sizeof(esr));
+            uint64_t exceptionClass = esr >> 26;
+            if (exceptionClass == kEsrInstructionAbortLower || exceptionClass == kEsrInstructionAbort) {
+                return false;
+            }
+            return (esr & kEsrWriteNotRead) != 0;
+        }
+        offset += header[1];
+    }
+    return true;
+#elif defined(__arm__)
+    return (uc->uc_mcontext.error_code & (1UL << 11)) != 0;
+#else
+    (void)uc;
+    return true;
+#endif
+}
+
+WriteTrap& WriteTrap::instance() {
+    // Never destroyed: the signal handler and the trap thread can run until
+    // the process exits.
+    static WriteTrap* trap = new WriteTrap();
+    return *trap;
+}
+
+WriteTrap::WriteTrap()
+    : intervals_(new std::vector<Interval>()), readers_(0), traps_(0), overflowed_(false),
+      read_fd_(-1), write_fd_(-1), support_(SUPPORT_UNKNOWN) {
+    memset(&previous_, 0, sizeof(previous_));
+    long pageSize = sysconf(_SC_PAGESIZE);
+    page_size_ = pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+}
+
+bool WriteTrap::isSupported() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (support_ == SUPPORT_UNKNOWN) {
+        support_ = install() ? SUPPORT_YES : SUPPORT_NO;
+        LOGI("Write trapping %s", support_ == SUPPORT_YES ? "available" : "unavailable");
+    }
+    return support_ == SUPPORT_YES;
+}
+
+bool WriteTrap::install() {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        LOGE("Failed to create trap pipe: %s", strerror(errno));
+        return false;
+    }
+    // The signal handler must never block on a full pipe.
+    if (fcntl(fds[1], F_SETFL, O_NONBLOCK) != 0) {
+        LOGE("Failed to configure trap pipe: %s", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = onSignal;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &previous_) != 0) {
+        LOGE("Failed to install SIGSEGV handler: %s", strerror(errno));
+        close(read_fd_);
+        close(write_fd_);
+        read_fd_ = write_fd_ = -1;
+        return false;
+    }
+
+    std::thread(&WriteTrap::run, this).detach();
+    return true;
+}
+
+bool WriteTrap::arm(void* address, size_t size, Handler handler) {
+    uintptr_t start = reinterpret_cast<uintptr_t>(address);
+    if (size == 0 || start % page_size_ != 0 || !isSupported()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Range& range = ranges_[start];
+    range.size = size;
+    range.handler = handler;
+    publishIntervals();
+    return true;
+}
+
+void WriteTrap::disarm(void* address) {
+    std::lock_guard<std::recursive_mutex> dispatchLock(dispatch_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ranges_.erase(reinterpret_cast<uintptr_t>(address)) > 0) {
+        publishIntervals();
+    }
+}
+
+void WriteTrap::publishIntervals() {
+    std::vector<Interval>* intervals = new std::vector<Interval>();
+    intervals->reserve(ranges_.size());
+    for (const auto& entry : ranges_) {
+        intervals->push_back(Interval{entry.first, entry.first + entry.second.size});
+    }
+
+    // A handler that saw the old array holds readers_ up until it is done
+    // with it; wait for those before freeing it.
+    const std::vector<Interval>* old = intervals_.exchange(intervals);
+    while (readers_.load() != 0) {
+        sched_yield();
+    }
+    delete old;
+}
+
+void WriteTrap::onSignal(int signal, siginfo_t* info, void* context) {
+    WriteTrap& trap = instance();
+    if (info->si_code == SEGV_ACCERR && trap.handleFault(info->si_addr, context)) {
+        return;
+    }
+
+    const struct sigaction& previous = trap.previous_;
+    if (previous.sa_flags & SA_SIGINFO) {
+        previous.sa_sigaction(signal, info, context);
+    } else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+        previous.sa_handler(signal);
+    } else {
+        // Returning re-executes the access, which now takes the default
+        // action just as it would have without this handler.
+        struct sigaction fallback;
+        memset(&fallback, 0, sizeof(fallback));
+        fallback.sa_handler = SIG_DFL;
+        sigemptyset(&fallback.sa_mask);
+        sigaction(signal, &fallback, nullptr);
+    }
+}
+
+bool WriteTrap::handleFault(void* address, void* context) {
+    uintptr_t fault = reinterpret_cast<uintptr_t>(address);
+    bool trapped = false;
+
+    readers_.fetch_add(1);
+    const std::vector<Interval>* intervals = intervals_.load();
+    auto it = std::upper_bound(intervals->begin(), intervals->end(), fault,
+                               [](uintptr_t value, const Interval& interval) { return value < interval.start; });
+    if (it != intervals->begin() && fault < (it - 1)->end && isWriteFault(context)) {
+        uintptr_t page = fault & ~(static_cast<uintptr_t>(page_size_) - 1);
+        trapped = mprotect(reinterpret_cast<void*>(page), page_size_, PROT_READ | PROT_WRITE) == 0;
+        if (trapped) {
+            int savedErrno = errno;
+            if (write(write_fd_, &page, sizeof(page)) != static_cast<ssize_t>(sizeof(page))) {
+                overflowed_.store(true);
+            }
+            errno = savedErrno;
+            traps_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    readers_.fetch_sub(1);
+    return trapped;
+}
+
+void WriteTrap::run() {
+    uintptr_t pages[kPagesPerRead];
+    for (;;) {
+        ssize_t n = read(read_fd_, pages, sizeof(pages));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            LOGE("Trap pipe closed: %s", n < 0 ? strerror(errno) : "end of file");
+            return;
+        }
+        dispatch(pages, static_cast<size_t>(n) / sizeof(pages[0]));
+    }
+}
+
+void WriteTrap::dispatch(const uintptr_t* pages, size_t count) {
+    std::lock_guard<std::recursive_mutex> dispatchLock(dispatch_mutex_);
+
+    // Rearm every hit range before any handler rescans it, so no write can
+    // slip in between a rescan and the range becoming read-only again.
+    std::vector<Handler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::map<uintptr_t, Range>::iterator> hit;
+        if (overflowed_.exchange(false)) {
+            for (auto it = ranges_.begin(); it != ranges_.end(); ++it) {
+                hit.push_back(it);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            auto it = ranges_.upper_bound(pages[i]);
+            if (it == ranges_.begin()) {
+                continue;
+            }
+            --it;
+            if (pages[i] < it->first + it->second.size && std::find(hit.begin(), hit.end(), it) == hit.end()) {
+                hit.push_back(it);
+            }
+        }
+        for (const auto& it : hit) {
+            if (mprotect(reinterpret_cast<void*>(it->first), it->second.size, PROT_READ) != 0) {
+                LOGE("Failed to rearm write trap at %p: %s",
+                                  reinterpret_cast<void*>(it->first), strerror(errno));
+            }
+            handlers.push_back(it->second.handler);
+        }
+    }
+
+    for (const Handler& handler : handlers) {
+        handler();
+    }
+}
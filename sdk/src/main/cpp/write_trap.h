@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_PROTECTION_WRITE_TRAP_H
+#define APP_PROTECTION_WRITE_TRAP_H
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * Reports writes to read-only protected ranges as they happen instead of
+ * waiting for the next rehash. A chained SIGSEGV handler looks the faulting
+ * address up in a sorted interval array (binary search, no locks or
+ * allocation in signal context); on a hit it reopens that page for writing,
+ * lets the write go through and hands the page to a native trap thread.
+ * The thread makes the whole range read-only again and only then runs the
+ * range's handler, so a write that lands after the handler's rescan faults
+ * again and is reported again.
+ *
+ * Faults outside armed ranges, and non-write faults inside them, go to the
+ * previously installed handler. On Android libsigchain keeps ART's own
+ * handler in front of this one.
+ *
+ * Writes that get around the trap, such as an mprotect() or a remap of the
+ * range, are not seen here; the regular rehash remains the backstop.
+ */
+class WriteTrap {
+public:
+    typedef std::function<void()> Handler;
+
+    static WriteTrap& instance();
+
+    // Installs the handler and starts the trap thread on first use.
+    bool isSupported();
+
+    // The range must be page-aligned and already read-only. `handler` runs
+    // on the trap thread after every trapped write.
+    bool arm(void* address, size_t size, Handler handler);
+    // Once this returns the handler is not running and will not run again.
+    void disarm(void* address);
+
+    uint64_t trapCount() const { return traps_.load(std::memory_order_relaxed); }
+
+private:
+    WriteTrap();
+
+    struct Range {
+        size_t size;
+        Handler handler;
+    };
+
+    struct Interval {
+        uintptr_t start;
+        uintptr_t end;
+    };
+
+    static void onSignal(int signal, siginfo_t* info, void* context);
+    bool install();
+    // Signal context: async-signal-safe calls only.
+    bool handleFault(void* address, void* context);
+    // Replaces the interval array read by the signal handler; mutex_ held.
+    void publishIntervals();
+    void run();
+    void dispatch(const uintptr_t* pages, size_t count);
+
+    // Held while handlers run, so disarm() can wait them out. Recursive in
+    // case a handler ends up disarming its own range.
+    std::recursive_mutex dispatch_mutex_;
+    std::mutex mutex_;
+    std::map<uintptr_t, Range> ranges_;
+    std::atomic<const std::vector<Interval>*> intervals_;
+    // Signal handlers currently reading intervals_.
+    std::atomic<int> readers_;
+    std::atomic<uint64_t> traps_;
+    // Set when the trap pipe was full; the thread then rearms every range.
+    std::atomic<bool> overflowed_;
+    struct sigaction previous_;
+    size_t page_size_;
+    int read_fd_;
+    int write_fd_;
+    int support_;
+};
+
+#endif
@@ -18,13 +18,18 @@ package com.appprotection.sdk
 
 import android.content.Context
 import android.util.Log
+import com.appprotection.sdk.internal.BaselineKey
 import com.appprotection.sdk.internal.MemoryMonitor
 import com.appprotection.sdk.internal.RootDetector
 import com.appprotection.sdk.internal.DebugDetector
+import com.appprotection.sdk.internal.DeviceStateMonitor
 import com.appprotection.sdk.internal.SecurityConfig
 import com.appprotection.sdk.internal.ProtectionStatus
 import com.appprotection.sdk.internal.ProtectionLevel
+import com.appprotection.sdk.internal.RegionProtectionCallback
+import com.appprotection.sdk.internal.TamperEvent
 import com.appprotection.sdk.internal.TamperingCallback
+import java.io.File
 
 /**
  * Main SDK class for application protection features
@@ -44,6 +49,10 @@ class AppProtectionSDK private constructor(
     private val memoryMonitor: MemoryMonitor = MemoryMonitor()
     private val rootDetector: RootDetector = RootDetector(context)
     private val debugDetector: DebugDetector = DebugDetector(context)
+    private val baselineKey = BaselineKey(context)
+    private val deviceStateMonitor = DeviceStateMonitor(context) { foreground, batterySaver, thermalStatus ->
+        memoryMonitor.setDeviceState(foreground, batterySaver, thermalStatus)
+    }
     
     /**
      * Interface for receiving tampering detection events.
@@ -64,6 +73,7 @@ class AppProtectionSDK private constructor(
 
     companion object {
         private const val TAG = "AppProtectionSDK"
+        private const val BASELINE_FILE = "app_protection_baseline.bin"
         private var instance: AppProtectionSDK? = null
 
         /**
@@ -88,19 +98,28 @@ class AppProtectionSDK private constructor(
     init {
         memoryMonitor.setTamperingCallback(object : TamperingCallback {
             override fun onTamperingDetected(region: String, details: String) {
-                Log.w(TAG, "Memory tampering detected in region: $region")
-                Log.w(TAG, "Details: $details")
+                onTamperingBatch(listOf(TamperEvent(region, details, 1)))
+            }
+
+            override fun onTamperingBatch(events: List<TamperEvent>) {
+                events.forEach { event ->
+                    Log.w(TAG, "Memory tampering detected in region: ${event.region} (x${event.count})")
+                    Log.w(TAG, "Details: ${event.details}")
+                }
                 
                 synchronized(tamperingListeners) {
-                    tamperingListeners.forEach { listener ->
-                        try {
-                            listener.onTamperingDetected(region, details)
-                        } catch (e: Exception) {
-                            Log.e(TAG, "Error notifying tampering listener", e)
+                    events.forEach { event ->
+                        tamperingListeners.forEach { listener ->
+                            try {
+                                listener.onTamperingDetected(event.region, event.details)
+                            } catch (e: Exception) {
+                                Log.e(TAG, "Error notifying tampering listener", e)
+                            }
                         }
                     }
                 }
                 
+                // One response per batch; a tamper storm should not repeat it per event.
                 when (config.protectionLevel) {
                     ProtectionLevel.HIGH -> {
                         Log.w(TAG, "HIGH protection level: App would be terminated in production")
@@ -135,6 +154,24 @@ class AppProtectionSDK private constructor(
         if (config.enableMemoryMonitoring && config.memoryScanInterval > 0) {
             memoryMonitor.startPeriodicScanning(config.memoryScanInterval)
             Log.d(TAG, "Started periodic memory scanning with interval: ${config.memoryScanInterval}ms")
+            
+            if (config.adaptiveScanning) {
+                memoryMonitor.setAdaptiveScanning(true, config.memoryScanInterval,
+                    timeSlices = timeSlicesFor(config.protectionLevel))
+                deviceStateMonitor.startMonitoring()
+            }
+        }
+    }
+
+    /**
+     * Ticks over which adaptive scanning covers every protected region once
+     * HIGH scans everything on every tick; lower levels spread the cost out
+     */
+    private fun timeSlicesFor(level: ProtectionLevel): Int {
+        return when (level) {
+            ProtectionLevel.HIGH -> 1
+            ProtectionLevel.MEDIUM -> 4
+            ProtectionLevel.LOW -> 8
         }
     }
 
@@ -145,7 +182,18 @@ class AppProtectionSDK private constructor(
      */
     private fun startProtection() {
         if (config.enableMemoryMonitoring) {
+            // HIGH keeps every scan on SHA-256; lower levels trade that for a
+            // fast hash with periodic SHA-256 checks.
+            memoryMonitor.setFastHashing(config.protectionLevel != ProtectionLevel.HIGH)
             memoryMonitor.startMonitoring()
+            
+            // Warm start: files unchanged since the last snapshot skip their
+            // baseline hash and are verified by the first background scan.
+            val key = baselineKey.get()
+            val restored = if (key != null) memoryMonitor.loadBaseline(baselineFile().path, key) else 0
+            if (restored > 0) {
+                Log.d(TAG, "Restored $restored file baselines from snapshot")
+            }
         }
 
         if (config.enableRootDetection) {
@@ -164,11 +212,31 @@ class AppProtectionSDK private constructor(
      * Call this method when protection is no longer needed or when the application is shutting down.
      */
     fun stopProtection() {
+        saveBaseline()
+        deviceStateMonitor.stopMonitoring()
         memoryMonitor.stopMonitoring()
         rootDetector.stopDetection()
         debugDetector.stopDetection()
     }
 
+    /**
+     * Saves the baselines of the currently protected files so the next start can
+     * restore them instead of hashing every file again
+     * 
+     * The snapshot lives in the no-backup directory and is sealed with a random key
+     * wrapped by the Android Keystore, so it cannot be forged from the app's files or
+     * carried to another device or install. No snapshot is written when the Keystore
+     * is unavailable. It is also saved automatically by [stopProtection].
+     * 
+     * @return true if the snapshot was written
+     */
+    fun saveBaseline(): Boolean {
+        val key = baselineKey.get() ?: return false
+        return memoryMonitor.saveBaseline(baselineFile().path, key)
+    }
+
+    private fun baselineFile(): File = File(context.noBackupFilesDir, BASELINE_FILE)
+
     /**
      * Checks if protection is currently active
      * 
@@ -269,6 +337,51 @@ class AppProtectionSDK private constructor(
         return memoryMonitor.protectMemoryRegion(regionName)
     }
     
+    /**
+     * Protect the code of a loaded native library
+     * 
+     * The library's executable text is hashed in memory, so inline hooks and other
+     * in-memory patches are detected and reported by page. The library must stay
+     * loaded while it is protected.
+     * 
+     * @param library File name of the library, for example "libapp_protection.so"
+     * @return true if the library's code was successfully protected, false otherwise
+     */
+    fun protectLoadedLibrary(library: String): Boolean {
+        return memoryMonitor.protectLoadedLibrary(library)
+    }
+    
+    /**
+     * Protect shipped files and loaded libraries against build-time digests
+     * 
+     * The digests come from the golden manifest embedded into the native library
+     * at build time, so startup does not hash anything and the baselines do not
+     * trust what is on disk at first use. Libraries are given as file names, for
+     * example "libgame.so"; files as paths, matched to entries by file name.
+     * 
+     * @param libraries File names of loaded libraries to protect
+     * @param files Paths of files to protect
+     * @return true if every region had a usable manifest entry, false otherwise
+     */
+    fun protectFromManifest(libraries: List<String> = emptyList(), files: List<String> = emptyList()): Boolean {
+        val regions = libraries.map { MemoryMonitor.CODE_REGION_PREFIX + it } + files
+        return memoryMonitor.protectFromManifest(regions).all { it >= 0 }
+    }
+    
+    /**
+     * Protect a sensitive memory region without blocking the caller
+     * 
+     * The baseline is captured on a native worker thread, which keeps large files
+     * off the startup path. The region is not scanned until the capture completes.
+     * 
+     * @param regionName The name or identifier of the memory region to protect
+     * @param callback Invoked on the worker thread once the region is protected or has failed
+     * @return true if the region was queued for protection, false otherwise
+     */
+    fun protectMemoryRegionAsync(regionName: String, callback: RegionProtectionCallback): Boolean {
+        return memoryMonitor.protectMemoryRegionAsync(regionName, callback)
+    }
+    
     /**
      * Scan all protected memory regions for tampering
      * 
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+import android.content.Context
+import android.security.keystore.KeyGenParameterSpec
+import android.security.keystore.KeyProperties
+import android.util.Log
+import java.io.File
+import java.security.KeyStore
+import java.security.SecureRandom
+import javax.crypto.Cipher
+import javax.crypto.KeyGenerator
+import javax.crypto.SecretKey
+import javax.crypto.spec.GCMParameterSpec
+
+/**
+ * HMAC key the file baseline snapshot is sealed with
+ * The key is 32 random bytes, stored next to the snapshot wrapped by a non-exportable
+ * Android Keystore AES key, so it cannot be read or recomputed from the app's files
+ * and the snapshot cannot be re-sealed after editing it. A missing or unreadable key
+ * is replaced by a new one, which only invalidates the existing snapshot
+ */
+class BaselineKey(private val context: Context) {
+    companion object {
+        private const val TAG = "BaselineKey"
+        private const val KEYSTORE = "AndroidKeyStore"
+        private const val WRAPPING_KEY_ALIAS = "AppProtectionSDK.baseline"
+        private const val KEY_FILE = "app_protection_baseline.key"
+        private const val TRANSFORMATION = "AES/GCM/NoPadding"
+        private const val KEY_SIZE = 32
+        private const val TAG_BITS = 128
+    }
+
+    private var key: ByteArray? = null
+
+    /**
+     * Returns the snapshot key, creating it on first use
+     * @return The key, or null if the Keystore is unavailable
+     */
+    @Synchronized
+    fun get(): ByteArray? {
+        key?.let { return it }
+        key = try {
+            val wrappingKey = loadWrappingKey()
+            unwrap(wrappingKey) ?: create(wrappingKey)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to access the baseline key", e)
+            null
+        }
+        return key
+    }
+
+    private fun keyFile(): File = File(context.noBackupFilesDir, KEY_FILE)
+
+    private fun loadWrappingKey(): SecretKey {
+        val keyStore = KeyStore.getInstance(KEYSTORE).apply { load(null) }
+        (keyStore.getKey(WRAPPING_KEY_ALIAS, null) as? SecretKey)?.let { return it }
+
+        val generator = KeyGenerator.getInstance(KeyProperties.KEY_ALGORITHM_AES, KEYSTORE)
+        generator.init(
+            KeyGenParameterSpec.Builder(
+                WRAPPING_KEY_ALIAS,
+                KeyProperties.PURPOSE_ENCRYPT or KeyProperties.PURPOSE_DECRYPT
+            )
+                .setBlockModes(KeyProperties.BLOCK_MODE_GCM)
+                .setEncryptionPaddings(KeyProperties.ENCRYPTION_PADDING_NONE)
+                .setKeySize(256)
+                .build()
+        )
+        return generator.generateKey()
+    }
+
+    // Key file layout: IV length, IV, then the GCM-sealed key
+    private fun unwrap(wrappingKey: SecretKey): ByteArray? {
+        val file = keyFile()
+        if (!file.exists()) {
+            return null
+        }
+        return try {
+            val wrapped = file.readBytes()
+            val ivLength = wrapped[0].toInt()
+            val cipher = Cipher.getInstance(TRANSFORMATION)
+            cipher.init(Cipher.DECRYPT_MODE, wrappingKey, GCMParameterSpec(TAG_BITS, wrapped, 1, ivLength))
+            cipher.doFinal(wrapped, 1 + ivLength, wrapped.size - 1 - ivLength)
+                .takeIf { it.size == KEY_SIZE }
+        } catch (e: Exception) {
+            Log.w(TAG, "Baseline key cannot be unwrapped, creating a new one", e)
+            null
+        }
+    }
+
+    private fun create(wrappingKey: SecretKey): ByteArray {
+        val newKey = ByteArray(KEY_SIZE).also { SecureRandom().nextBytes(it) }
+        val cipher = Cipher.getInstance(TRANSFORMATION)
+        cipher.init(Cipher.ENCRYPT_MODE, wrappingKey)
+        val iv = cipher.iv
+        val sealed = cipher.doFinal(newKey)
+
+        val file = keyFile()
+        val temp = File(file.parentFile, "$KEY_FILE.tmp")
+        temp.writeBytes(byteArrayOf(iv.size.toByte()) + iv + sealed)
+        if (!temp.renameTo(file)) {
+            temp.delete()
+            throw IllegalStateException("Cannot store the baseline key")
+        }
+        return newKey
+    }
+}
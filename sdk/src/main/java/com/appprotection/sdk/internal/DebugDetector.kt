@@ -20,9 +20,6 @@ import android.app.ActivityManager
 import android.content.Context
 import android.os.Debug
 import android.util.Log
-import java.io.BufferedReader
-import java.io.File
-import java.io.FileReader
 
 /**
  * Detects if the application is being debugged or if debugging tools are attached
@@ -107,19 +104,10 @@ class DebugDetector(private val context: Context) {
 
     /**
      * Checks for common debugger ports in use
-     * @return true if any debugger port is in use, false otherwise
+     * @return true if any debugger port is listening, false otherwise
      */
     private fun checkDebuggerPort(): Boolean {
-        return try {
-            val ports = arrayOf(23946, 23947, 23948)
-            ports.any { port ->
-                File("/proc/net/tcp").readLines().any { line ->
-                    line.contains(":$port")
-                }
-            }
-        } catch (e: Exception) {
-            false
-        }
+        return EnvironmentCheck.any(EnvironmentCheck.DEBUGGER_PORT)
     }
 
     /**
@@ -143,18 +131,6 @@ class DebugDetector(private val context: Context) {
      * @return true if a tracer process is detected, false otherwise
      */
     private fun checkDebuggerTracerPid(): Boolean {
-        return try {
-            val reader = BufferedReader(FileReader("/proc/self/status"))
-            val lines = reader.readLines()
-            reader.close()
-
-            val tracerPidLine = lines.find { it.startsWith("TracerPid:") }
-            tracerPidLine?.let {
-                val pid = it.substringAfter(":").trim().toIntOrNull()
-                pid != null && pid > 0
-            } ?: false
-        } catch (e: Exception) {
-            false
-        }
+        return EnvironmentCheck.any(EnvironmentCheck.TRACER_ATTACHED)
     }
 } 
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+import android.app.Activity
+import android.app.ActivityManager
+import android.app.Application
+import android.content.BroadcastReceiver
+import android.content.Context
+import android.content.Intent
+import android.content.IntentFilter
+import android.os.Build
+import android.os.Bundle
+import android.os.PowerManager
+import android.util.Log
+
+/**
+ * Tracks the device conditions adaptive scanning throttles on: whether the app is
+ * in the foreground, battery saver, and the thermal status on API 29 and up
+ * Every change is reported to the listener with the complete current state
+ */
+class DeviceStateMonitor(
+    private val context: Context,
+    private val listener: (foreground: Boolean, batterySaver: Boolean, thermalStatus: Int) -> Unit
+) {
+    companion object {
+        private const val TAG = "DeviceStateMonitor"
+        private const val THERMAL_STATUS_NONE = 0
+    }
+
+    private val powerManager = context.getSystemService(Context.POWER_SERVICE) as? PowerManager
+    private var isMonitoring = false
+    private var foreground = false
+    // Activities started since monitoring began; ones already started before
+    // that are only seen when they stop
+    private val startedActivities = HashSet<Activity>()
+    // PowerManager.OnThermalStatusChangedListener, which only exists on API 29 and up
+    private var thermalListener: Any? = null
+
+    private val lifecycleCallbacks = object : Application.ActivityLifecycleCallbacks {
+        override fun onActivityStarted(activity: Activity) {
+            startedActivities.add(activity)
+            setForeground(true)
+        }
+
+        override fun onActivityStopped(activity: Activity) {
+            startedActivities.remove(activity)
+            if (startedActivities.isEmpty()) {
+                setForeground(false)
+            }
+        }
+
+        override fun onActivityCreated(activity: Activity, savedInstanceState: Bundle?) {}
+        override fun onActivityResumed(activity: Activity) {}
+        override fun onActivityPaused(activity: Activity) {}
+        override fun onActivitySaveInstanceState(activity: Activity, outState: Bundle) {}
+        override fun onActivityDestroyed(activity: Activity) {}
+    }
+
+    private val powerSaveReceiver = object : BroadcastReceiver() {
+        override fun onReceive(context: Context, intent: Intent) {
+            report()
+        }
+    }
+
+    /**
+     * Starts tracking and reports the current state right away
+     * Does nothing if tracking is already active
+     */
+    fun startMonitoring() {
+        if (isMonitoring) {
+            return
+        }
+
+        try {
+            // Activities started before this call are not in the started
+            // set, so the starting state comes from the process importance.
+            // Stopping one of them only moves to the background if no
+            // activity started since is still visible.
+            val processInfo = ActivityManager.RunningAppProcessInfo()
+            ActivityManager.getMyMemoryState(processInfo)
+            foreground = processInfo.importance <= ActivityManager.RunningAppProcessInfo.IMPORTANCE_VISIBLE
+
+            (context.applicationContext as? Application)?.registerActivityLifecycleCallbacks(lifecycleCallbacks)
+            context.registerReceiver(powerSaveReceiver, IntentFilter(PowerManager.ACTION_POWER_SAVE_MODE_CHANGED))
+            if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q && powerManager != null) {
+                val thermal = PowerManager.OnThermalStatusChangedListener { report() }
+                powerManager.addThermalStatusListener(thermal)
+                thermalListener = thermal
+            }
+            isMonitoring = true
+            Log.d(TAG, "Device state monitoring started")
+            report()
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to start device state monitoring", e)
+        }
+    }
+
+    /**
+     * Stops tracking
+     * Does nothing if tracking is not active
+     */
+    fun stopMonitoring() {
+        if (!isMonitoring) {
+            return
+        }
+
+        try {
+            (context.applicationContext as? Application)?.unregisterActivityLifecycleCallbacks(lifecycleCallbacks)
+            context.unregisterReceiver(powerSaveReceiver)
+            if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q && powerManager != null) {
+                (thermalListener as? PowerManager.OnThermalStatusChangedListener)?.let {
+                    powerManager.removeThermalStatusListener(it)
+                }
+            }
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to stop device state monitoring", e)
+        }
+        thermalListener = null
+        startedActivities.clear()
+        isMonitoring = false
+        Log.d(TAG, "Device state monitoring stopped")
+    }
+
+    private fun setForeground(value: Boolean) {
+        if (foreground != value) {
+            foreground = value
+            report()
+        }
+    }
+
+    private fun report() {
+        val batterySaver = powerManager?.isPowerSaveMode ?: false
+        val thermalStatus = if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q && powerManager != null) {
+            powerManager.currentThermalStatus
+        } else {
+            THERMAL_STATUS_NONE
+        }
+        Log.d(TAG, "Device state: foreground=$foreground, batterySaver=$batterySaver, thermal=$thermalStatus")
+        listener(foreground, batterySaver, thermalStatus)
+    }
+}
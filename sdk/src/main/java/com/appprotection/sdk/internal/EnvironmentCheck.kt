@@ -0,0 +1,164 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+import android.os.SystemClock
+import android.util.Log
+import java.io.File
+
+/**
+ * Native sweep of the debugger and root indicators that would otherwise be read
+ * through java.io and a spawned process
+ * The result is shared for [MAX_AGE_MS] so detectors queried back to back in one
+ * health check trigger a single sweep. When the native library is unavailable or
+ * the call fails, the same checks run through java.io instead, so a missing
+ * library never reads as a clean environment
+ */
+object EnvironmentCheck {
+    private const val TAG = "EnvironmentCheck"
+    private const val MAX_AGE_MS = 1000L
+
+    const val TRACER_ATTACHED = 1 shl 0
+    const val DEBUGGER_PORT = 1 shl 1
+    const val ROOT_PATH = 1 shl 2
+    const val SU_ON_PATH = 1 shl 3
+
+    // Default ports of the IDA and gdb remote debug servers
+    private val DEBUGGER_PORTS = intArrayOf(23946, 23947, 23948)
+    private const val TCP_STATE_LISTEN = "0A"
+    private val ROOT_PATHS = arrayOf(
+        "/system/app/Superuser.apk",
+        "/system/xbin/su",
+        "/system/bin/su",
+        "/sbin/su",
+        "/system/sd/xbin/su",
+        "/system/bin/failsafe/su",
+        "/data/local/xbin/su",
+        "/data/local/bin/su",
+        "/data/local/su"
+    )
+
+    private var available = false
+    @Volatile private var lastFlags = 0
+    @Volatile private var lastSweepMs = 0L
+
+    init {
+        try {
+            System.loadLibrary("app_protection")
+            available = true
+        } catch (e: UnsatisfiedLinkError) {
+            Log.e(TAG, "Failed to load native library", e)
+        }
+    }
+
+    /**
+     * Returns the EnvironmentCheck flags, running a new sweep if the last one is stale
+     * @return A mask of the flag constants
+     */
+    fun flags(): Int {
+        val now = SystemClock.elapsedRealtime()
+        if (lastSweepMs != 0L && now - lastSweepMs < MAX_AGE_MS) {
+            return lastFlags
+        }
+
+        val flags = nativeFlags() ?: fallbackFlags()
+        lastFlags = flags
+        lastSweepMs = now
+        return flags
+    }
+
+    private fun nativeFlags(): Int? {
+        if (!available) {
+            return null
+        }
+        return try {
+            nativeCheckEnvironment()
+        } catch (e: Throwable) {
+            Log.e(TAG, "Native environment check failed, using java.io checks", e)
+            null
+        }
+    }
+
+    /**
+     * Runs the same checks as the native sweep through java.io
+     * @return A mask of the flag constants
+     */
+    private fun fallbackFlags(): Int {
+        var flags = 0
+        if (tracerAttached()) {
+            flags = flags or TRACER_ATTACHED
+        }
+        if (debuggerPortListening()) {
+            flags = flags or DEBUGGER_PORT
+        }
+        if (ROOT_PATHS.any { File(it).exists() }) {
+            flags = flags or ROOT_PATH
+        }
+        if (suOnPath()) {
+            flags = flags or SU_ON_PATH
+        }
+        return flags
+    }
+
+    private fun tracerAttached(): Boolean {
+        return try {
+            File("/proc/self/status").useLines { lines ->
+                lines.any { line ->
+                    line.startsWith("TracerPid:") &&
+                        (line.substringAfter(":").trim().toIntOrNull() ?: 0) > 0
+                }
+            }
+        } catch (e: Exception) {
+            false
+        }
+    }
+
+    // "   0: 0100007F:5DAA 00000000:0000 0A ..." - local port in hex, then the state
+    private fun debuggerPortListening(): Boolean {
+        return arrayOf("/proc/net/tcp", "/proc/net/tcp6").any { path ->
+            try {
+                File(path).useLines { lines ->
+                    lines.drop(1).any { line ->
+                        val columns = line.trim().split(Regex("\\s+"))
+                        val port = columns.getOrNull(1)?.substringAfterLast(':')?.toIntOrNull(16)
+                        columns.getOrNull(3) == TCP_STATE_LISTEN && port != null && port in DEBUGGER_PORTS
+                    }
+                }
+            } catch (e: Exception) {
+                false
+            }
+        }
+    }
+
+    private fun suOnPath(): Boolean {
+        val path = System.getenv("PATH") ?: return false
+        return path.split(':').any { dir -> dir.isNotEmpty() && File(dir, "su").canExecute() }
+    }
+
+    /**
+     * Checks whether any of the given flags is set in the current sweep
+     * @param mask The flags to test
+     * @return true if at least one of them is set
+     */
+    fun any(mask: Int): Boolean = flags() and mask != 0
+
+    /**
+     * Runs the environment checks in the native layer
+     * @return A mask of the flag constants
+     */
+    private external fun nativeCheckEnvironment(): Int
+}
@@ -17,6 +17,8 @@
 package com.appprotection.sdk.internal
 
 import android.util.Log
+import kotlin.coroutines.resume
+import kotlin.coroutines.suspendCoroutine
 
 /**
  * Interface for tampering detection callbacks
@@ -28,6 +30,40 @@ interface TamperingCallback {
      * @param details Additional details about the tampering
      */
     fun onTamperingDetected(region: String, details: String)
+
+    /**
+     * Called on the native dispatcher thread with the events of one coalescing window, in the order they were first seen
+     * The default implementation passes each event to [onTamperingDetected]
+     * @param events The tampering events, identical ones merged
+     */
+    fun onTamperingBatch(events: List<TamperEvent>) {
+        events.forEach { onTamperingDetected(it.region, it.details) }
+    }
+}
+
+/**
+ * Receives tampering batches from native code and hands them to a [TamperingCallback]
+ */
+private class TamperingBatchBridge(private val callback: TamperingCallback) {
+    /**
+     * Called from native code with one batch as parallel arrays
+     */
+    @Suppress("unused")
+    fun onNativeTamperingBatch(regions: Array<String>, details: Array<String>, counts: IntArray) {
+        callback.onTamperingBatch(List(regions.size) { TamperEvent(regions[it], details[it], counts[it]) })
+    }
+}
+
+/**
+ * Interface for asynchronous region protection callbacks
+ */
+interface RegionProtectionCallback {
+    /**
+     * Called on a native worker thread once the baseline of a region has been captured
+     * @param region The name of the region
+     * @param success Whether the region is now protected
+     */
+    fun onRegionProtected(region: String, success: Boolean)
 }
 
 /**
@@ -41,6 +77,21 @@ class MemoryMonitor {
     companion object {
         private const val TAG = "MemoryMonitor"
         
+        /**
+         * Prefix of region names that protect the in-memory text of a loaded library
+         */
+        const val CODE_REGION_PREFIX = "elf:"
+        
+        /**
+         * Result of [findFirstDifference] for regions that match
+         */
+        const val REGIONS_IDENTICAL = -1L
+        
+        /**
+         * Result of [findFirstDifference] when the regions could not be compared
+         */
+        const val REGIONS_NOT_COMPARABLE = -2L
+        
         init {
             try {
                 System.loadLibrary("app_protection")
@@ -121,7 +172,7 @@ class MemoryMonitor {
         return try {
             val regions = nativeGetCriticalRegions(nativeHandle)
             Log.d(TAG, "Got ${regions.size} critical regions")
-            regions
+            regions.asList()
         } catch (e: Exception) {
             Log.e(TAG, "Failed to get critical regions", e)
             emptyList()
@@ -137,7 +188,7 @@ class MemoryMonitor {
         return try {
             val regions = nativeGetProtectedRegions(nativeHandle)
             Log.d(TAG, "Got ${regions.size} protected regions")
-            regions
+            regions.asList()
         } catch (e: Exception) {
             Log.e(TAG, "Failed to get protected regions", e)
             emptyList()
@@ -162,23 +213,113 @@ class MemoryMonitor {
     }
 
     /**
-     * Compares two memory regions to check if they match
+     * Looks up the compact id the native layer assigned to a region name
+     * @param region The identifier of the memory region
+     * @return The region id, or -1 if the region is unknown
+     */
+    fun getRegionId(region: String): Int {
+        return try {
+            nativeGetRegionId(nativeHandle, region)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to get region id: $region", e)
+            -1
+        }
+    }
+
+    /**
+     * Scans a memory region by id, skipping the string marshalling of
+     * [scanMemoryRegion] for regions that are scanned often
+     * @param regionId An id returned by [getRegionId]
+     * @return true if the region is intact, false if tampering is detected
+     */
+    fun scanMemoryRegion(regionId: Int): Boolean {
+        return try {
+            nativeScanMemoryRegionById(nativeHandle, regionId)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to scan memory region with id: $regionId", e)
+            false
+        }
+    }
+
+    /**
+     * Compares two memory regions to check if they match. By default the
+     * stored baseline digests are compared; [deep] compares the current bytes.
      * @param region1 The identifier of the first memory region
      * @param region2 The identifier of the second memory region
+     * @param deep true to compare current contents instead of digests
      * @return true if the regions match, false otherwise
      */
-    fun compareMemoryRegions(region1: String, region2: String): Boolean {
+    fun compareMemoryRegions(region1: String, region2: String, deep: Boolean = false): Boolean {
+        return findFirstDifference(region1, region2, deep) == REGIONS_IDENTICAL
+    }
+    
+    /**
+     * Locates where two memory regions diverge
+     * @param region1 The identifier of the first memory region
+     * @param region2 The identifier of the second memory region
+     * @param deep true to compare current contents instead of digests
+     * @return Byte offset of the first difference (chunk-aligned for digest
+     * comparisons), [REGIONS_IDENTICAL] or [REGIONS_NOT_COMPARABLE]
+     */
+    fun findFirstDifference(region1: String, region2: String, deep: Boolean = false): Long {
         Log.d(TAG, "Comparing memory regions '$region1' and '$region2' with handle: $nativeHandle")
         return try {
-            val result = nativeCompareMemoryRegions(nativeHandle, region1, region2)
+            val result = nativeCompareMemoryRegions(nativeHandle, region1, region2, deep)
             Log.d(TAG, "Memory regions comparison result: $result")
             result
         } catch (e: Exception) {
             Log.e(TAG, "Failed to compare memory regions", e)
+            REGIONS_NOT_COMPARABLE
+        }
+    }
+    
+    /**
+     * Groups protected regions that hold identical contents, such as the same
+     * asset in several split APKs. Scanning the group rehashes one member in
+     * full and checks the others by digest and file metadata.
+     * @param group Name of the group
+     * @param members Protected regions with identical baselines
+     * @return true if the group was created
+     */
+    fun createRegionGroup(group: String, members: List<String>): Boolean {
+        return try {
+            val result = nativeCreateRegionGroup(nativeHandle, group, members.toTypedArray())
+            Log.d(TAG, "Region group '$group' created: $result")
+            result
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to create region group", e)
             false
         }
     }
-
+    
+    /**
+     * Removes a region group; its members stay protected
+     * @param group Name of the group
+     */
+    fun removeRegionGroup(group: String) {
+        try {
+            nativeRemoveRegionGroup(nativeHandle, group)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to remove region group", e)
+        }
+    }
+    
+    /**
+     * Scans every member of a region group
+     * @param group Name of the group
+     * @return true if all members are intact and still match the group
+     */
+    fun scanRegionGroup(group: String): Boolean {
+        return try {
+            val result = nativeScanRegionGroup(nativeHandle, group)
+            Log.d(TAG, "Region group '$group' scan result: $result")
+            result
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to scan region group", e)
+            false
+        }
+    }
+    
     /**
      * Adds a memory region to the critical regions list for monitoring
      * @param region The identifier of the memory region to add
@@ -224,6 +365,116 @@ class MemoryMonitor {
         }
     }
 
+    /**
+     * Protects the executable text of a native library already loaded into the process
+     * The text is hashed in memory, page by page, so in-memory patches such as inline
+     * hooks are caught and located without reading the library file
+     * @param library File name of the library, for example "libapp_protection.so"
+     * @return true if protection was successfully enabled, false otherwise
+     */
+    fun protectLoadedLibrary(library: String): Boolean {
+        return protectMemoryRegion(CODE_REGION_PREFIX + library)
+    }
+
+    /**
+     * Queues a region for protection; its baseline is captured on a native worker thread
+     * The region is skipped by scans until the capture completes
+     * @param region The identifier of the memory region to protect
+     * @param callback Invoked on the worker thread when the capture finishes
+     * @return true if the region was queued, in which case [callback] is always invoked
+     */
+    fun protectMemoryRegionAsync(region: String, callback: RegionProtectionCallback): Boolean {
+        Log.d(TAG, "Queueing protection of memory region '$region' with handle: $nativeHandle")
+        return try {
+            nativeProtectMemoryRegionAsync(nativeHandle, region, callback)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to queue protection of memory region: $region", e)
+            false
+        }
+    }
+
+    /**
+     * Suspending variant of [protectMemoryRegionAsync]
+     * @param region The identifier of the memory region to protect
+     * @return true if the region is protected once the capture finishes
+     */
+    suspend fun awaitProtectMemoryRegion(region: String): Boolean = suspendCoroutine { continuation ->
+        val queued = protectMemoryRegionAsync(region, object : RegionProtectionCallback {
+            override fun onRegionProtected(region: String, success: Boolean) {
+                continuation.resume(success)
+            }
+        })
+        if (!queued) {
+            continuation.resume(false)
+        }
+    }
+
+    /**
+     * Checks whether a region queued with [protectMemoryRegionAsync] is still awaiting its baseline
+     * @param region The identifier of the memory region
+     * @return true if the baseline capture has not completed yet
+     */
+    fun isRegionPending(region: String): Boolean {
+        return try {
+            nativeIsRegionPending(nativeHandle, region)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to query pending region: $region", e)
+            false
+        }
+    }
+
+    /**
+     * Protects several regions with a single JNI call
+     * @param regions The identifiers of the memory regions to protect
+     * @param critical If true, the regions are also registered as critical regions
+     * @return The region id for each entry of [regions], or -1 where protection failed
+     */
+    fun protectRegions(regions: List<String>, critical: Boolean = false): IntArray {
+        Log.d(TAG, "Protecting ${regions.size} memory regions with handle: $nativeHandle")
+        return try {
+            nativeProtectRegions(nativeHandle, regions.toTypedArray(), critical) ?: IntArray(regions.size) { -1 }
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to protect memory regions", e)
+            IntArray(regions.size) { -1 }
+        }
+    }
+
+    /**
+     * Protects files and loaded libraries with the digests recorded in the golden
+     * manifest built into the native library, so no baseline is hashed on the
+     * calling thread. Each region is verified against its manifest entry once on a
+     * native worker thread, and by regular scans afterwards
+     * @param regions File paths, matched to entries by file name, or
+     * [CODE_REGION_PREFIX] library regions
+     * @return The region id for each entry of [regions], or -1 where the manifest has no usable entry
+     */
+    fun protectFromManifest(regions: List<String>): IntArray {
+        Log.d(TAG, "Protecting ${regions.size} regions from the golden manifest with handle: $nativeHandle")
+        return try {
+            nativeProtectFromManifest(nativeHandle, regions.toTypedArray()) ?: IntArray(regions.size) { -1 }
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to protect regions from the golden manifest", e)
+            IntArray(regions.size) { -1 }
+        }
+    }
+
+    /**
+     * Scans several regions with a single JNI call
+     * @param regionIds Ids returned by [getRegionId] or [protectRegions]
+     * @return One result per id, in the same order
+     */
+    fun scanRegions(regionIds: IntArray): List<RegionScanResult> {
+        return try {
+            val packed = nativeScanRegions(nativeHandle, regionIds) ?: return emptyList()
+            regionIds.mapIndexed { i, id ->
+                RegionScanResult(id, packed[i * 3].toInt(), packed[i * 3 + 1], packed[i * 3 + 2].toInt())
+            }
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to scan memory regions", e)
+            emptyList()
+        }
+    }
+
     /**
      * Disables protection for a specific memory region
      * @param region The identifier of the memory region to unprotect
@@ -290,22 +541,17 @@ class MemoryMonitor {
     fun monitorSystemPaths(paths: List<String>): List<String> {
         Log.d(TAG, "Monitoring system paths: $paths")
         val protectedPaths = mutableListOf<String>()
+        val ids = protectRegions(paths, critical = true)
         
-        for (path in paths) {
-            try {
-                addCriticalRegion(path)
-                val success = protectMemoryRegion(path)
-                if (success) {
-                    protectedPaths.add(path)
-                    Log.d(TAG, "Successfully protected system path: $path")
-                } else {
-                    Log.w(TAG, "Failed to protect system path: $path")
-                }
-            } catch (e: Exception) {
-                Log.e(TAG, "Error protecting system path: $path", e)
+        paths.forEachIndexed { i, path ->
+            if (ids[i] >= 0) {
+                protectedPaths.add(path)
+            } else {
+                Log.w(TAG, "Failed to protect system path: $path")
             }
         }
         
+        Log.d(TAG, "Protected ${protectedPaths.size} of ${paths.size} system paths")
         return protectedPaths
     }
     
@@ -318,56 +564,331 @@ class MemoryMonitor {
         return path.startsWith("/proc/") || path.startsWith("/sys/") || path.startsWith("/dev/")
     }
     
-    private var periodicScanningJob: Thread? = null
-    private var periodicScanningActive = false
-    
     /**
      * Starts periodic scanning of protected regions
+     * Scheduling runs on a native worker thread that scans all protected regions
+     * without crossing JNI on every tick; Kotlin is only called back on tampering
      * @param intervalMs Interval in milliseconds between scans
+     * @param criticalOnly If true, only regions that are also critical regions are scanned
      */
-    fun startPeriodicScanning(intervalMs: Long) {
-        if (periodicScanningActive) {
-            stopPeriodicScanning()
+    fun startPeriodicScanning(intervalMs: Long, criticalOnly: Boolean = false) {
+        try {
+            val result = nativeStartScanScheduler(nativeHandle, intervalMs, criticalOnly)
+            Log.d(TAG, "Started periodic scanning with interval: $intervalMs ms, result: $result")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to start periodic scanning", e)
+        }
+    }
+    
+    /**
+     * Switches periodic scanning to adaptive mode
+     * Each tick scans a time slice of the protected regions, picked by how overdue they
+     * are, with critical and recently tampered regions scanned more often; the interval
+     * stretches up to [maxIntervalMs] with the state passed to [setDeviceState]
+     * @param enabled true to enable adaptive scanning
+     * @param baseIntervalMs Interval in the foreground with no throttling
+     * @param maxIntervalMs Longest interval throttling may stretch to
+     * @param timeSlices Ticks over which every protected region is scanned once
+     * @param maxTickBytes Upper bound on the bytes scanned per tick, 0 for no bound
+     */
+    fun setAdaptiveScanning(
+        enabled: Boolean,
+        baseIntervalMs: Long,
+        maxIntervalMs: Long = 30000L,
+        timeSlices: Int = 8,
+        maxTickBytes: Long = 0L
+    ) {
+        try {
+            nativeSetAdaptiveScanning(nativeHandle, enabled, baseIntervalMs, maxIntervalMs, timeSlices, maxTickBytes)
+            Log.d(TAG, "Adaptive scanning ${if (enabled) "enabled" else "disabled"}: " +
+                "base=$baseIntervalMs ms, slices=$timeSlices")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure adaptive scanning", e)
+        }
+    }
+    
+    /**
+     * Passes the device conditions adaptive scanning throttles on
+     * @param foreground true while the app is in the foreground
+     * @param batterySaver true while battery saver is on
+     * @param thermalStatus One of the PowerManager.THERMAL_STATUS_* values
+     */
+    fun setDeviceState(foreground: Boolean, batterySaver: Boolean, thermalStatus: Int) {
+        try {
+            nativeSetDeviceState(nativeHandle, foreground, batterySaver, thermalStatus)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to set device state", e)
         }
-        
-        periodicScanningActive = true
-        periodicScanningJob = Thread {
-            try {
-                while (periodicScanningActive) {
-                    val regions = getProtectedRegions()
-                    for (region in regions) {
-                        scanMemoryRegion(region)
-                    }
-                    Thread.sleep(intervalMs)
-                }
-            } catch (e: InterruptedException) {
-                Log.d(TAG, "Periodic scanning interrupted")
-            } catch (e: Exception) {
-                Log.e(TAG, "Error during periodic scanning", e)
-            }
-        }.apply { start() }
-        
-        Log.d(TAG, "Started periodic scanning with interval: $intervalMs ms")
     }
     
     /**
      * Stops periodic scanning of protected regions
      */
     fun stopPeriodicScanning() {
-        periodicScanningActive = false
-        periodicScanningJob?.interrupt()
-        periodicScanningJob = null
-        Log.d(TAG, "Stopped periodic scanning")
+        try {
+            nativeStopScanScheduler(nativeHandle)
+            Log.d(TAG, "Stopped periodic scanning")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to stop periodic scanning", e)
+        }
+    }
+    
+    /**
+     * Starts event-driven scanning of protected files
+     * Every protected file gets an inotify watch, and a native thread rescans a
+     * file as soon as it is modified, replaced or deleted. Proc files are not
+     * covered, so periodic scanning can stay on as a backstop at a much longer interval
+     * @return true if file watching was started
+     */
+    fun startFileWatching(): Boolean {
+        return try {
+            val result = nativeStartFileWatching(nativeHandle)
+            Log.d(TAG, "File watching start result: $result")
+            result
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to start file watching", e)
+            false
+        }
+    }
+    
+    /**
+     * Stops event-driven scanning of protected files
+     */
+    fun stopFileWatching() {
+        try {
+            nativeStopFileWatching(nativeHandle)
+            Log.d(TAG, "Stopped file watching")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to stop file watching", e)
+        }
+    }
+    
+    /**
+     * Configures chunked (Merkle tree) hashing for regions protected afterwards
+     * Large regions keep a digest per chunk, so tampering reports include the
+     * offsets of the changed chunks
+     * @param chunkSize Chunk size in bytes, or 0 to disable chunked hashing
+     * @param minRegionSize Regions smaller than this are still hashed as a whole
+     * @param stopAtFirstMismatch If true, a scan stops at the first changed chunk
+     */
+    fun setChunkedHashing(chunkSize: Int, minRegionSize: Long = 64 * 1024, stopAtFirstMismatch: Boolean = true) {
+        try {
+            nativeSetChunkedHashing(nativeHandle, chunkSize, minRegionSize, stopAtFirstMismatch)
+            Log.d(TAG, "Chunked hashing configured: chunkSize=$chunkSize, minRegionSize=$minRegionSize")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure chunked hashing", e)
+        }
+    }
+    
+    /**
+     * Configures block-wise reading of very large files, such as OBBs and
+     * model files. Files of at least [minFileSize] bytes are hashed one block
+     * at a time instead of being mapped whole, so a scan needs at most
+     * [blockSize] bytes of buffer memory
+     * @param minFileSize Smallest file that is streamed, or 0 to map every file
+     * @param blockSize Bytes read per block
+     */
+    fun setFileStreaming(minFileSize: Long, blockSize: Long = 1024 * 1024) {
+        try {
+            nativeSetFileStreaming(nativeHandle, minFileSize, blockSize)
+            Log.d(TAG, "File streaming configured: minFileSize=$minFileSize, blockSize=$blockSize")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure file streaming", e)
+        }
+    }
+    
+    /**
+     * Enables incremental scanning for anonymous memory regions protected afterwards
+     * Rescans only rehash pages the kernel reports as written since the baseline;
+     * has no effect on kernels without soft-dirty page tracking. Every [fullScanInterval]
+     * scans the whole region is rehashed anyway, since dirty bits can be cleared by anyone
+     * in the process
+     * @param enabled true to enable incremental scanning
+     * @param fullScanInterval Rehash every page every this many scans, 0 or 1 for every scan
+     */
+    fun setIncrementalScanning(enabled: Boolean, fullScanInterval: Int = 16) {
+        try {
+            nativeSetIncrementalScanning(nativeHandle, enabled, fullScanInterval)
+            Log.d(TAG, "Incremental scanning ${if (enabled) "enabled" else "disabled"}")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure incremental scanning", e)
+        }
+    }
+    
+    /**
+     * Enables parallel scanning for scanAllProtectedRegions
+     * Regions are spread across a small native thread pool sized to the big cores,
+     * and large chunked regions are split into sub-ranges
+     * @param enabled true to enable parallel scanning
+     */
+    fun setParallelScanning(enabled: Boolean) {
+        try {
+            nativeSetParallelScanning(nativeHandle, enabled)
+            Log.d(TAG, "Parallel scanning ${if (enabled) "enabled" else "disabled"}")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure parallel scanning", e)
+        }
+    }
+    
+    /**
+     * Lets scans skip rehashing files whose stat metadata (device, inode, size,
+     * mtime, ctime) is unchanged since they were last verified, so most scans
+     * cost one fstat per file
+     * @param enabled true to enable the fast path
+     * @param deepScanInterval Force a full rehash of each file every this many scans, 0 for never
+     * @param jitter Randomize the per-file rehash cadence so it cannot be predicted
+     */
+    fun setStatFastPath(enabled: Boolean, deepScanInterval: Int = 16, jitter: Boolean = true) {
+        try {
+            nativeSetStatFastPath(nativeHandle, enabled, deepScanInterval, jitter)
+            Log.d(TAG, "Stat fast path ${if (enabled) "enabled" else "disabled"}")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure stat fast path", e)
+        }
+    }
+    
+    /**
+     * Lets routine scans of in-process memory compare a fast 64-bit hash
+     * instead of SHA-256. A mismatch is always confirmed with SHA-256, and a
+     * full SHA-256 check still runs every [fullHashInterval] scans
+     * @param enabled true to enable the fast tier
+     * @param fullHashInterval Run the SHA-256 check every this many scans, 0 or 1 for every scan
+     */
+    fun setFastHashing(enabled: Boolean, fullHashInterval: Int = 8) {
+        try {
+            nativeSetFastHashing(nativeHandle, enabled, fullHashInterval)
+            Log.d(TAG, "Fast hashing ${if (enabled) "enabled" else "disabled"}")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure fast hashing", e)
+        }
+    }
+    
+    /**
+     * Enables write trapping for anonymous memory regions protected afterwards
+     * A write to such a region is caught as it happens and the region is rescanned
+     * at once, so routine scans only rehash it every [rehashInterval] scans to catch
+     * writes that got around the trap
+     * @param enabled true to enable write trapping
+     * @param rehashInterval Rehash trapped regions every this many scans, 0 or 1 for every scan
+     * @return true if write trapping is now enabled
+     */
+    fun setWriteTrapping(enabled: Boolean, rehashInterval: Int = 16): Boolean {
+        return try {
+            val result = nativeSetWriteTrapping(nativeHandle, enabled, rehashInterval)
+            Log.d(TAG, "Write trapping ${if (result) "enabled" else "disabled"}")
+            result
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure write trapping", e)
+            false
+        }
+    }
+    
+    /**
+     * Sets how long a verification by another MemoryMonitor in this process
+     * stands in for this monitor's own scan. Files and loaded library text
+     * protected by several monitors are then hashed once per interval instead
+     * of once per monitor
+     * @param maxAgeMs Longest age of a reusable result, or 0 to always hash
+     */
+    fun setSharedVerification(maxAgeMs: Int) {
+        try {
+            nativeSetSharedVerification(nativeHandle, maxAgeMs)
+            Log.d(TAG, "Shared verification max age: $maxAgeMs ms")
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure shared verification", e)
+        }
+    }
+    
+    /**
+     * Enables the native trace ring, which records scans and tamper events
+     * as binary entries without formatting or logging
+     * @param enabled true to start recording
+     */
+    fun setTracing(enabled: Boolean) {
+        try {
+            nativeSetTracing(enabled)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to configure tracing", e)
+        }
+    }
+    
+    /**
+     * Returns the events currently held by the native trace ring, oldest first
+     * The ring is shared by all monitors and keeps the most recent 1024 events
+     * @return The recorded trace events
+     */
+    fun getTraceEvents(): List<TraceEvent> {
+        return try {
+            val packed = nativeGetTrace() ?: return emptyList()
+            (0 until packed.size / 5).map { i ->
+                TraceEvent(packed[i * 5], packed[i * 5 + 1], packed[i * 5 + 2].toInt(),
+                    packed[i * 5 + 3].toInt(), packed[i * 5 + 4].toInt())
+            }
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to read trace events", e)
+            emptyList()
+        }
+    }
+    
+    /**
+     * Writes the baselines of all protected files to a snapshot sealed with [key]
+     * Memory and /proc regions are not included, they are recreated on each start
+     * @param path Destination file, replaced atomically
+     * @param key HMAC key; must not be derivable from the app's files, see [BaselineKey]
+     * @return true if the snapshot was written
+     */
+    fun saveBaseline(path: String, key: ByteArray): Boolean {
+        return try {
+            nativeSaveBaseline(nativeHandle, path, key)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to save baseline", e)
+            false
+        }
+    }
+    
+    /**
+     * Restores file baselines from a snapshot written by [saveBaseline]
+     * Files whose stat metadata changed since the snapshot are skipped and need
+     * [protectMemoryRegion] as usual. Restored files are fully rehashed by their next scan
+     * @param path Snapshot file
+     * @param key The key the snapshot was sealed with
+     * @return Number of regions restored, or -1 if the snapshot is missing, corrupt or was sealed with another key
+     */
+    fun loadBaseline(path: String, key: ByteArray): Int {
+        return try {
+            val restored = nativeLoadBaseline(nativeHandle, path, key)
+            Log.d(TAG, "Restored $restored region baselines from $path")
+            restored
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to load baseline", e)
+            -1
+        }
+    }
+    
+    /**
+     * Returns latency histograms and hashing counters collected by the native scanner
+     * Counters accumulate from the creation of this monitor
+     * @return The current metrics, or null if they could not be read
+     */
+    fun getMetrics(): ScanMetrics? {
+        return try {
+            val packed = nativeGetScanMetrics(nativeHandle) ?: return null
+            ScanMetrics.unpack(packed)
+        } catch (e: Exception) {
+            Log.e(TAG, "Failed to read scan metrics", e)
+            null
+        }
     }
     
     /**
      * Sets a callback to be notified when tampering is detected
+     * Events are delivered in batches on a native dispatcher thread, never on the scanning thread
      * @param callback The callback to be invoked when tampering is detected, or null to remove the current callback
      */
     fun setTamperingCallback(callback: TamperingCallback?) {
         this.tamperingCallback = callback
         try {
-            nativeSetTamperingCallback(nativeHandle, callback)
+            nativeSetTamperingCallback(nativeHandle, callback?.let { TamperingBatchBridge(it) })
             Log.d(TAG, "Tampering callback ${if (callback == null) "removed" else "set"} in native code")
         } catch (e: Exception) {
             Log.e(TAG, "Failed to set tampering callback in native code", e)
@@ -431,14 +952,55 @@ class MemoryMonitor {
      */
     private external fun nativeScanMemoryRegion(handle: Long, region: String): Boolean
     
+    /**
+     * Gets the native id of a region
+     * @param handle The native handle
+     * @param region The region name
+     * @return The region id, or -1 if unknown
+     */
+    private external fun nativeGetRegionId(handle: Long, region: String): Int
+    
+    /**
+     * Scans a memory region by id in the native layer
+     * @param handle The native handle
+     * @param regionId The region id
+     * @return true if the region is intact
+     */
+    private external fun nativeScanMemoryRegionById(handle: Long, regionId: Int): Boolean
+    
     /**
      * Compares two memory regions in the native layer
      * @param handle The native handle
      * @param region1 The first region to compare
      * @param region2 The second region to compare
-     * @return true if the regions match
+     * @param deep true to compare current contents
+     * @return Offset of the first difference, or REGIONS_IDENTICAL / REGIONS_NOT_COMPARABLE
+     */
+    private external fun nativeCompareMemoryRegions(handle: Long, region1: String, region2: String, deep: Boolean): Long
+    
+    /**
+     * Creates a region group in the native layer
+     * @param handle The native handle
+     * @param group The group name
+     * @param members The member regions
+     * @return true if the group was created
      */
-    private external fun nativeCompareMemoryRegions(handle: Long, region1: String, region2: String): Boolean
+    private external fun nativeCreateRegionGroup(handle: Long, group: String, members: Array<String>): Boolean
+    
+    /**
+     * Removes a region group in the native layer
+     * @param handle The native handle
+     * @param group The group name
+     */
+    private external fun nativeRemoveRegionGroup(handle: Long, group: String)
+    
+    /**
+     * Scans a region group in the native layer
+     * @param handle The native handle
+     * @param group The group name
+     * @return true if every member is intact
+     */
+    private external fun nativeScanRegionGroup(handle: Long, group: String): Boolean
     
     /**
      * Adds a critical region in the native layer
@@ -462,6 +1024,23 @@ class MemoryMonitor {
      */
     private external fun nativeProtectMemoryRegion(handle: Long, region: String): Boolean
     
+    /**
+     * Queues a region for protection in the native layer
+     * @param handle The native handle
+     * @param region The region to protect
+     * @param callback The callback to invoke once the baseline is captured
+     * @return true if the region was queued
+     */
+    private external fun nativeProtectMemoryRegionAsync(handle: Long, region: String, callback: RegionProtectionCallback): Boolean
+    
+    /**
+     * Checks whether a region is awaiting its baseline in the native layer
+     * @param handle The native handle
+     * @param region The region to check
+     * @return true if the baseline capture is still pending
+     */
+    private external fun nativeIsRegionPending(handle: Long, region: String): Boolean
+    
     /**
      * Unprotects a memory region in the native layer
      * @param handle The native handle
@@ -470,19 +1049,44 @@ class MemoryMonitor {
      */
     private external fun nativeUnprotectMemoryRegion(handle: Long, region: String): Boolean
     
+    /**
+     * Protects several regions in the native layer
+     * @param handle The native handle
+     * @param regions The regions to protect
+     * @param critical Whether to also register the regions as critical
+     * @return The region id per entry, -1 where protection failed
+     */
+    private external fun nativeProtectRegions(handle: Long, regions: Array<String>, critical: Boolean): IntArray?
+    
+    /**
+     * Protects regions from the golden manifest in the native layer
+     * @param handle The native handle
+     * @param regions The regions to protect
+     * @return The region id per entry, -1 where protection failed
+     */
+    private external fun nativeProtectFromManifest(handle: Long, regions: Array<String>): IntArray?
+    
+    /**
+     * Scans several regions in the native layer
+     * @param handle The native handle
+     * @param regionIds The ids of the regions to scan
+     * @return Three values per region: status, elapsed nanoseconds, changed chunks
+     */
+    private external fun nativeScanRegions(handle: Long, regionIds: IntArray): LongArray?
+    
     /**
      * Gets the list of critical regions from the native layer
      * @param handle The native handle
-     * @return List of critical region identifiers
+     * @return Array of critical region identifiers
      */
-    private external fun nativeGetCriticalRegions(handle: Long): List<String>
+    private external fun nativeGetCriticalRegions(handle: Long): Array<String>
     
     /**
      * Gets the list of protected regions from the native layer
      * @param handle The native handle
-     * @return List of protected region identifiers
+     * @return Array of protected region identifiers
      */
-    private external fun nativeGetProtectedRegions(handle: Long): List<String>
+    private external fun nativeGetProtectedRegions(handle: Long): Array<String>
     
     /**
      * Simulates memory tampering in the native layer
@@ -499,10 +1103,167 @@ class MemoryMonitor {
      */
     private external fun nativeScanAllProtectedRegions(handle: Long): Boolean
     
+    /**
+     * Starts the native scan scheduler
+     * @param handle The native handle
+     * @param intervalMs Interval in milliseconds between scans
+     * @param criticalOnly If true, only critical protected regions are scanned
+     * @return true if the scheduler was started
+     */
+    private external fun nativeStartScanScheduler(handle: Long, intervalMs: Long, criticalOnly: Boolean): Boolean
+    
+    /**
+     * Stops the native scan scheduler
+     * @param handle The native handle
+     */
+    private external fun nativeStopScanScheduler(handle: Long)
+    
+    /**
+     * Configures adaptive scanning in the native layer
+     * @param handle The native handle
+     * @param enabled true to enable adaptive scanning
+     * @param baseIntervalMs Unthrottled interval in milliseconds
+     * @param maxIntervalMs Throttled interval limit in milliseconds
+     * @param timeSlices Ticks per full coverage of the protected regions
+     * @param maxTickBytes Per-tick byte bound, 0 for none
+     */
+    private external fun nativeSetAdaptiveScanning(
+        handle: Long,
+        enabled: Boolean,
+        baseIntervalMs: Long,
+        maxIntervalMs: Long,
+        timeSlices: Int,
+        maxTickBytes: Long
+    )
+    
+    /**
+     * Pushes the device state to the native scan rate controller
+     * @param handle The native handle
+     * @param foreground Whether the app is in the foreground
+     * @param batterySaver Whether battery saver is on
+     * @param thermalStatus PowerManager thermal status
+     */
+    private external fun nativeSetDeviceState(handle: Long, foreground: Boolean, batterySaver: Boolean, thermalStatus: Int)
+    
+    /**
+     * Starts the native file watcher
+     * @param handle The native handle
+     * @return true if the watcher was started
+     */
+    private external fun nativeStartFileWatching(handle: Long): Boolean
+    
+    /**
+     * Stops the native file watcher
+     * @param handle The native handle
+     */
+    private external fun nativeStopFileWatching(handle: Long)
+    
+    /**
+     * Configures chunked hashing in the native layer
+     * @param handle The native handle
+     * @param chunkSize Chunk size in bytes, or 0 to disable
+     * @param minRegionSize Minimum region size for chunked hashing
+     * @param stopAtFirstMismatch Whether scans stop at the first changed chunk
+     */
+    private external fun nativeSetChunkedHashing(handle: Long, chunkSize: Int, minRegionSize: Long, stopAtFirstMismatch: Boolean)
+    
+    /**
+     * Configures streamed file hashing in the native layer
+     * @param handle The native handle
+     * @param minFileSize Smallest streamed file, or 0 to disable
+     * @param blockSize Bytes read per block
+     */
+    private external fun nativeSetFileStreaming(handle: Long, minFileSize: Long, blockSize: Long)
+    
+    /**
+     * Configures incremental scanning in the native layer
+     * @param handle The native handle
+     * @param enabled Whether incremental scanning is enabled
+     * @param fullScanInterval Full rehash cadence of incremental regions in scans
+     */
+    private external fun nativeSetIncrementalScanning(handle: Long, enabled: Boolean, fullScanInterval: Int)
+    
+    /**
+     * Configures parallel scanning in the native layer
+     * @param handle The native handle
+     * @param enabled Whether parallel scanning is enabled
+     */
+    private external fun nativeSetParallelScanning(handle: Long, enabled: Boolean)
+    
+    /**
+     * Configures the fast hash tier for memory regions
+     * @param handle The native handle
+     * @param enabled true to enable the fast tier
+     * @param fullHashInterval SHA-256 check cadence in scans
+     */
+    private external fun nativeSetFastHashing(handle: Long, enabled: Boolean, fullHashInterval: Int)
+    
+    /**
+     * Configures write trapping for anonymous memory regions
+     * @param handle The native handle
+     * @param enabled true to enable write trapping
+     * @param rehashInterval Rehash cadence of trapped regions in scans
+     * @return true if write trapping is now enabled
+     */
+    private external fun nativeSetWriteTrapping(handle: Long, enabled: Boolean, rehashInterval: Int): Boolean
+    
+    /**
+     * Configures reuse of other monitors' verifications in the native layer
+     * @param handle The native handle
+     * @param maxAgeMs Longest age of a reusable result, 0 to disable
+     */
+    private external fun nativeSetSharedVerification(handle: Long, maxAgeMs: Int)
+    
+    /**
+     * Enables or disables the process-wide native trace ring
+     * @param enabled Whether events are recorded
+     */
+    private external fun nativeSetTracing(enabled: Boolean)
+    
+    /**
+     * Reads the native trace ring
+     * @return Five values per event: timestamp, duration, region id, op, result
+     */
+    private external fun nativeGetTrace(): LongArray?
+    
+    /**
+     * Saves the baselines of protected files
+     * @param handle The native handle
+     * @param path Destination file
+     * @param key HMAC key
+     * @return true if the snapshot was written
+     */
+    private external fun nativeSaveBaseline(handle: Long, path: String, key: ByteArray): Boolean
+    
+    /**
+     * Restores file baselines from a snapshot
+     * @param handle The native handle
+     * @param path Snapshot file
+     * @param key HMAC key
+     * @return Number of regions restored, or -1 on failure
+     */
+    private external fun nativeLoadBaseline(handle: Long, path: String, key: ByteArray): Int
+    
+    /**
+     * Reads the scan metrics of a monitor
+     * @param handle The native handle
+     * @return The packed metrics, see [ScanMetrics.unpack]
+     */
+    private external fun nativeGetScanMetrics(handle: Long): LongArray?
+    
+    /**
+     * Configures the stat-based fast path in the native layer
+     * @param handle The native handle
+     * @param enabled Whether unchanged files skip rehashing
+     * @param deepScanInterval Scans between forced rehashes, 0 for never
+     * @param jitter Whether the rehash cadence is randomized
+     */
+    private external fun nativeSetStatFastPath(handle: Long, enabled: Boolean, deepScanInterval: Int, jitter: Boolean)
+    
     /**
      * Sets the tampering callback in the native layer
      * @param handle The native handle
-     * @param callback The callback to set
+     * @param callback The bridge to deliver tampering batches to, or null to remove it
      */
-    private external fun nativeSetTamperingCallback(handle: Long, callback: TamperingCallback?)
+    private external fun nativeSetTamperingCallback(handle: Long, callback: Any?)
 } 
\ No newline at end of file
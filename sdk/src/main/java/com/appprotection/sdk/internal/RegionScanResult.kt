@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+/**
+ * Result of scanning one region through [MemoryMonitor.scanRegions]
+ * @property regionId The id of the scanned region
+ * @property status One of the STATUS_* constants
+ * @property elapsedNs Time spent verifying the region, in nanoseconds
+ * @property changedChunks Changed chunks located in a chunked region
+ */
+data class RegionScanResult(
+    val regionId: Int,
+    val status: Int,
+    val elapsedNs: Long,
+    val changedChunks: Int
+) {
+    val isIntact: Boolean
+        get() = status == STATUS_INTACT
+
+    companion object {
+        const val STATUS_INTACT = 0
+        const val STATUS_TAMPERED = 1
+        const val STATUS_NOT_FOUND = 2
+        const val STATUS_NOT_MONITORING = 3
+    }
+}
@@ -19,7 +19,6 @@ package com.appprotection.sdk.internal
 import android.content.Context
 import android.os.Build
 import android.util.Log
-import java.io.File
 
 /**
  * Detects if the device is rooted or has root access
@@ -28,17 +27,6 @@ import java.io.File
 class RootDetector(private val context: Context) {
     companion object {
         private const val TAG = "RootDetector"
-        private val ROOT_PATHS = arrayOf(
-            "/system/app/Superuser.apk",
-            "/system/xbin/su",
-            "/system/bin/su",
-            "/sbin/su",
-            "/system/sd/xbin/su",
-            "/system/bin/failsafe/su",
-            "/data/local/xbin/su",
-            "/data/local/bin/su",
-            "/data/local/su"
-        )
     }
 
     private var isDetecting = false
@@ -98,7 +86,7 @@ class RootDetector(private val context: Context) {
      * @return true if any root path exists, false otherwise
      */
     private fun checkRootPaths(): Boolean {
-        return ROOT_PATHS.any { File(it).exists() }
+        return EnvironmentCheck.any(EnvironmentCheck.ROOT_PATH)
     }
 
     /**
@@ -118,16 +106,11 @@ class RootDetector(private val context: Context) {
     }
 
     /**
-     * Checks if the su binary can be executed
-     * @return true if su command can be executed, false otherwise
+     * Checks if an executable su binary is on the PATH
+     * @return true if su could be executed, false otherwise
      */
     private fun checkSuExists(): Boolean {
-        return try {
-            Runtime.getRuntime().exec("su")
-            true
-        } catch (e: Exception) {
-            false
-        }
+        return EnvironmentCheck.any(EnvironmentCheck.SU_ON_PATH)
     }
 
     /**
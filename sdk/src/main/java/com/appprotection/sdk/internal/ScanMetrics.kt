@@ -0,0 +1,118 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+/**
+ * Latency distribution of one kind of native operation
+ * Bucket 0 counts samples under 1us, bucket i counts samples in [2^(i+9), 2^(i+10)) ns
+ * @property count Number of recorded samples
+ * @property totalNs Sum of all samples in nanoseconds
+ * @property maxNs Largest sample in nanoseconds
+ * @property buckets Sample counts per power-of-two bucket
+ */
+data class LatencyHistogram(
+    val count: Long,
+    val totalNs: Long,
+    val maxNs: Long,
+    val buckets: List<Long>
+) {
+    /** Mean latency in nanoseconds, or 0 when nothing was recorded */
+    val meanNs: Long
+        get() = if (count == 0L) 0L else totalNs / count
+}
+
+/**
+ * Scan counters of one protected region
+ * @property regionId Id of the region, see [MemoryMonitor.getRegionId]
+ * @property scanCount Number of completed scans
+ * @property mismatchCount Number of scans that found the region tampered
+ * @property lastScanNs Monotonic time at which the last scan started, comparable with System.nanoTime
+ * @property lastDurationNs Duration of the last scan
+ * @property bytesHashed Bytes hashed by scans of this region
+ * @property latency Scan latency buckets, laid out as in [LatencyHistogram.buckets]
+ */
+data class RegionMetrics(
+    val regionId: Int,
+    val scanCount: Long,
+    val mismatchCount: Long,
+    val lastScanNs: Long,
+    val lastDurationNs: Long,
+    val bytesHashed: Long,
+    val latency: List<Long>
+)
+
+/**
+ * Snapshot of the native scan metrics, see [MemoryMonitor.getMetrics]
+ * @property scanLatency Latency of single region scans
+ * @property protectLatency Latency of protecting a region, including its baseline hash
+ * @property scanAllLatency Latency of full scans over all protected regions
+ * @property bytesHashed Total bytes hashed by protect and scan calls
+ * @property syscalls Total system calls issued while scanning
+ * @property mismatches Total scans that found a region tampered
+ * @property regions Per-region counters for every protected region
+ */
+data class ScanMetrics(
+    val scanLatency: LatencyHistogram,
+    val protectLatency: LatencyHistogram,
+    val scanAllLatency: LatencyHistogram,
+    val bytesHashed: Long,
+    val syscalls: Long,
+    val mismatches: Long,
+    val regions: List<RegionMetrics>
+) {
+    companion object {
+        private const val VERSION = 1L
+
+        /**
+         * Decodes the array returned by the native layer
+         * @return The decoded metrics, or null if the layout is not understood
+         */
+        internal fun unpack(packed: LongArray): ScanMetrics? {
+            if (packed.size < 2 || packed[0] != VERSION) return null
+            val bucketCount = packed[1].toInt()
+            var pos = 2
+
+            fun histogram(): LatencyHistogram {
+                val histogram = LatencyHistogram(packed[pos], packed[pos + 1], packed[pos + 2],
+                    packed.copyOfRange(pos + 3, pos + 3 + bucketCount).toList())
+                pos += 3 + bucketCount
+                return histogram
+            }
+
+            if (packed.size < pos + 3 * (3 + bucketCount) + 4) return null
+            val scanLatency = histogram()
+            val protectLatency = histogram()
+            val scanAllLatency = histogram()
+            val bytesHashed = packed[pos]
+            val syscalls = packed[pos + 1]
+            val mismatches = packed[pos + 2]
+            val regionCount = packed[pos + 3].toInt()
+            pos += 4
+
+            val recordSize = 6 + bucketCount
+            if (packed.size < pos + regionCount * recordSize) return null
+            val regions = (0 until regionCount).map { i ->
+                val base = pos + i * recordSize
+                RegionMetrics(packed[base].toInt(), packed[base + 1], packed[base + 2], packed[base + 3],
+                    packed[base + 4], packed[base + 5],
+                    packed.copyOfRange(base + 6, base + recordSize).toList())
+            }
+            return ScanMetrics(scanLatency, protectLatency, scanAllLatency,
+                bytesHashed, syscalls, mismatches, regions)
+        }
+    }
+}
@@ -22,7 +22,10 @@ data class SecurityConfig(
     val enableRootDetection: Boolean = true,
     val enableDebugDetection: Boolean = true,
     val enableMemoryMonitoring: Boolean = true,
-    val protectionLevel: ProtectionLevel = ProtectionLevel.MEDIUM
+    val protectionLevel: ProtectionLevel = ProtectionLevel.MEDIUM,
+    // Spread scans over time slices and slow them down in the background,
+    // in battery saver and under thermal pressure
+    val adaptiveScanning: Boolean = true
 )
 
 enum class ProtectionLevel {
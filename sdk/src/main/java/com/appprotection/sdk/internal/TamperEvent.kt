@@ -0,0 +1,29 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+/**
+ * One entry of a tampering batch, see [TamperingCallback.onTamperingBatch]
+ * @property region The name of the tampered region
+ * @property details Additional details about the tampering
+ * @property count Number of identical events coalesced into this one
+ */
+data class TamperEvent(
+    val region: String,
+    val details: String,
+    val count: Int
+)
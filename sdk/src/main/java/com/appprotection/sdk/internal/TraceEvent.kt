@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 AppProtectionSDK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appprotection.sdk.internal
+
+/**
+ * One entry of the native trace ring, see [MemoryMonitor.getTraceEvents]
+ * @property timestampNs Monotonic clock time at which the event was recorded
+ * @property durationNs Duration of the traced operation, 0 for point events
+ * @property regionId Id of the region involved, or -1
+ * @property op One of the OP_* constants
+ * @property result 1 if a scan found the region intact, otherwise 0
+ */
+data class TraceEvent(
+    val timestampNs: Long,
+    val durationNs: Long,
+    val regionId: Int,
+    val op: Int,
+    val result: Int
+) {
+    companion object {
+        const val OP_SCAN_REGION = 1
+        const val OP_SCAN_ALL = 2
+        const val OP_TAMPER = 3
+        const val OP_FILE_EVENT = 4
+        const val OP_WRITE_TRAP = 5
+    }
+}